@@ -31,6 +31,52 @@
 *       #define RPNG_NO_STDIO_WARNING
 *           Skips issuing a compiler warning when RPNG_NO_STDIO is defined.
 *
+*       #define RPNG_NO_SIMD
+*           Do not use SIMD instructions (AVX2, SSE2, NEON) for scanlines filtering, scalar path used,
+*           CRC32 hardware instructions (PCLMULQDQ, ARMv8 CRC32) not used either (slice-by-8 tables)
+*           NOTE: Instructions set is selected at compile time, AVX2 requires compiler flags (-mavx2, /arch:AVX2),
+*           PCLMULQDQ is checked at runtime (no compiler flags required), ARMv8 CRC32 requires compiler flags (-march=armv8-a+crc)
+*
+*   MEMORY USAGE:
+*       Image data is decompressed into an output buffer sized from IHDR and unfiltered in place,
+*       compressed data (IDAT chunks concatenated) is placed in a scratch arena (rpng_arena),
+*       that can be provided by user to be reused across multiple images loading
+*
+*       Streaming decoder (rpng_decoder) can be used instead to avoid any full image temporary:
+*       PNG data is fed in pieces of any size and unfiltered scanlines are provided through a
+*       callback as soon as available, memory required is two scanlines plus inflate window (32 KB)
+*
+*   MULTITHREADED COMPRESSION:
+*       Image data can be compressed in parallel (pigz-style) with rpng_set_deflate_threads(),
+*       filtered scanlines are split in horizontal stripes compressed independently (previous stripe
+*       32 KB tail used as dictionary), byte aligned and joined into one zlib stream, Adler-32 combined
+*       NOTE: rpng does not create threads, a jobs runner must be provided by user (i.e. a thread pool),
+*       in case runner can not process jobs in parallel, image data is compressed as a single stream
+*
+*   COMPRESSION EFFORT:
+*       Compression effort can be selected at runtime with rpng_set_compression_effort():
+*           RPNG_COMPRESSION_STORE:   No filtering, data stored uncompressed (stored deflate blocks)
+*           RPNG_COMPRESSION_FAST:    Fixed Sub filter, deflate level RPNG_COMPRESSION_LEVEL_FAST
+*           RPNG_COMPRESSION_DEFAULT: Adaptive filter per scanline, deflate level RPNG_COMPRESSION_LEVEL
+*           RPNG_COMPRESSION_MAX:     All filter strategies tried (adaptive, fixed 0-4), highest deflate level
+*           RPNG_COMPRESSION_SQUEEZE: All filter strategies (including brute force per scanline by compressed size)
+*                                     and several deflate levels tried (in parallel if jobs runner provided)
+*           NOTE: Squeeze compresses image data up to 22 times (7 filter strategies x 3 levels, plus default effort),
+*           if jobs runner can not process candidates in parallel, they are compressed serially by caller thread
+*           (i.e. when image is compressed from a runner job), compression time grows accordingly
+*       Compression results can be retrieved with rpng_save_image_to_memory_stats()
+*
+*   ANCILLARY CHUNKS ON SAVE:
+*       rpng_save_image_chunks_to_memory(), rpng_save_image_indexed_chunks_to_memory() and
+*       rpng_save_image_reduced_chunks_to_memory() accept a list of ancillary chunks (tEXt, sRGB, custom...)
+*       written directly after IHDR on the same output buffer (one allocation, no chunk insertion copy)
+*       NOTE: Chunks are placed before PLTE, chunks required after PLTE (tRNS, bKGD, hIST) are not valid
+*
+*   COLOR TYPE REDUCTION:
+*       rpng_save_image_reduced_to_memory() analyzes 8 bit RGB/RGBA image data (opaque, grayscale, palette
+*       with 256 or less colors, binary alpha) and saves it with the smallest lossless color type:
+*       grayscale, gray+alpha, RGB, RGBA, indexed (PLTE/tRNS) or color key transparency (tRNS)
+*
 *   DEPENDENCIES: libc (C standard library)
 *       stdlib.h        Required for: malloc(), calloc(), free()
 *       string.h        Required for: memcmp(), memcpy()
@@ -185,11 +231,26 @@
     #define RPNG_MAX_OUTPUT_SIZE    (64*1024*1024)
 #endif
 
+// Padding bytes required after compressed data on decompression (64bit input reads)
+#define RPNG_INFLATE_PADDING        16
+
 #ifndef RPNG_COMPRESSION_LEVEL
     // Deflate compression level
     // NOTE: Default to same as stbiw: 8
     #define RPNG_COMPRESSION_LEVEL   8
 #endif
+#ifndef RPNG_COMPRESSION_LEVEL_FAST
+    // Deflate compression level for fast compression effort
+    #define RPNG_COMPRESSION_LEVEL_FAST     1
+#endif
+#ifndef RPNG_BRUTE_FORCE_WINDOW
+    // Previous filtered data used as dictionary to measure scanline compressed size (brute force filter)
+    #define RPNG_BRUTE_FORCE_WINDOW         (16*1024)
+#endif
+#ifndef RPNG_DEFLATE_STRIPE_MIN_SIZE
+    // Minimum filtered data size per stripe on multithreaded compression
+    #define RPNG_DEFLATE_STRIPE_MIN_SIZE    (128*1024)
+#endif
 
 // Define some possible error values
 // NOTE: Only some are actually used on file saving
@@ -228,6 +289,51 @@ typedef struct {
     rpng_color *colors;     // Palette colors
 } rpng_palette;
 
+// Scratch memory arena type
+// NOTE: Used for image loading temporary data, grown as required, must be freed with rpng_arena_free()
+typedef struct {
+    char *data;             // Arena memory
+    int size;               // Arena memory size
+} rpng_arena;
+
+// Streaming decoder scanline callback
+// NOTE: Called in order for every unfiltered scanline (width*color_channels*bit_depth/8 bytes)
+typedef void (*rpng_scanline_callback)(const char *scanline, int row, void *user_data);
+
+// Streaming decoder type (opaque)
+typedef struct rpng_decoder rpng_decoder;
+
+// Streaming decoder state, returned by rpng_decoder_feed()
+typedef enum {
+    RPNG_DECODER_ERROR = -1,    // Data not valid or not supported, decoding stopped
+    RPNG_DECODER_CONTINUE = 0,  // More data required
+    RPNG_DECODER_DONE = 1,      // All scanlines provided and IEND chunk reached
+} rpng_decoder_state;
+
+// Compression effort, selected with rpng_set_compression_effort()
+typedef enum {
+    RPNG_COMPRESSION_STORE = 0, // No filtering, no compression (stored blocks)
+    RPNG_COMPRESSION_FAST,      // Fixed filter (Sub), low deflate level
+    RPNG_COMPRESSION_DEFAULT,   // Adaptive filter per scanline, default deflate level
+    RPNG_COMPRESSION_MAX,       // All filter strategies tried, highest deflate level
+    RPNG_COMPRESSION_SQUEEZE,   // All filter strategies (brute force included) and several deflate levels tried
+} rpng_compression_effort;
+
+// Compression results, provided by rpng_save_image_to_memory_stats()
+typedef struct {
+    int size;                   // Compressed image data size (IDAT data)
+    int default_size;           // Compressed image data size with default effort, 0 if not computed (only squeeze)
+    int filter;                 // Filter strategy used: -2 brute force, -1 adaptive, 0-4 fixed filter type
+    int level;                  // Deflate level used (-1 for stored data)
+} rpng_compression_stats;
+
+// Jobs runner for multithreaded compression
+// NOTE: Runner must process all jobs in parallel (any thread, any order) and return true once all jobs are completed,
+// in case jobs can not be processed in parallel (i.e. threads busy) no job is processed and false is returned,
+// job data elements are job_size bytes each, consecutive on jobs_data array
+typedef void (*rpng_job_func)(void *job_data);
+typedef bool (*rpng_jobs_runner)(rpng_job_func job_func, void *jobs_data, int job_size, int job_count);
+
 // A minimal PNG only requires: png_signature | rpng_chunk(IHDR) | rpng_chunk(IDAT) | rpng_chunk(IEND)
 
 #ifdef __cplusplus
@@ -270,13 +376,39 @@ RPNGAPI int rpng_save_image_indexed(const char *filename, const char *indexed_da
 // Load and save png data from memory buffer
 // WARNING: Provided buffer is expected to be PNG compliant, ending with IEND chunk
 RPNGAPI char *rpng_load_image_from_memory(const char *buffer, int *width, int *height, int *color_channels, int *bit_depth); // Load png data from memory buffer
+RPNGAPI char *rpng_load_image_from_memory_arena(const char *buffer, int *width, int *height, int *color_channels, int *bit_depth, rpng_arena *arena); // Load png data from memory buffer, using scratch arena
 RPNGAPI char *rpng_load_image_indexed_from_memory(const char *buffer, int *width, int *height, rpng_palette *palette); // Load indexed png data from memory buffer (8 bpp)
 RPNGAPI char *rpng_save_image_to_memory(const char *data, int width, int height, int color_channels, int bit_depth, int *output_size); // Save png data to memory buffer
+RPNGAPI char *rpng_save_image_to_memory_stats(const char *data, int width, int height, int color_channels, int bit_depth, int *output_size, rpng_compression_stats *stats); // Save png data to memory buffer, compression results provided
 RPNGAPI char *rpng_save_image_indexed_to_memory(const char *indexed_data, int width, int height, rpng_palette palette, int *output_size); // Save indexed data to memory buffer
+RPNGAPI char *rpng_save_image_reduced_to_memory(const char *data, int width, int height, int color_channels, int *output_size, rpng_compression_stats *stats); // Save png data to memory buffer, smallest lossless color type (8 bit)
+
+// Save png data to memory buffer, ancillary chunks written after IHDR (chunks can be NULL if chunk_count is 0)
+RPNGAPI char *rpng_save_image_chunks_to_memory(const char *data, int width, int height, int color_channels, int bit_depth, const rpng_chunk *chunks, int chunk_count, int *output_size, rpng_compression_stats *stats);
+RPNGAPI char *rpng_save_image_indexed_chunks_to_memory(const char *indexed_data, int width, int height, rpng_palette palette, const rpng_chunk *chunks, int chunk_count, int *output_size);
+RPNGAPI char *rpng_save_image_reduced_chunks_to_memory(const char *data, int width, int height, int color_channels, const rpng_chunk *chunks, int chunk_count, int *output_size, rpng_compression_stats *stats);
 
 // Convert indexed image data to RGBA data
 RPNGAPI char *rpng_unindex_image_data(char *indexed_data, int width, int height, rpng_palette palette);
 
+// Free scratch arena memory
+RPNGAPI void rpng_arena_free(rpng_arena *arena);
+
+// Set threads count for image data compression, jobs runner required for more than 1 thread
+// NOTE: Setting is global, it should be set before compressing images from multiple threads
+RPNGAPI void rpng_set_deflate_threads(int thread_count, rpng_jobs_runner runner);
+// Set compression effort for image data (rpng_compression_effort), default: RPNG_COMPRESSION_DEFAULT
+// NOTE: Setting is global, it should be set before compressing images from multiple threads
+RPNGAPI void rpng_set_compression_effort(int effort);
+
+// Streaming decoding, PNG data fed in pieces, scanlines provided through callback
+// WARNING: Only non-interlaced images supported, bit depths of 8/16 bits
+RPNGAPI rpng_decoder *rpng_decoder_create(rpng_scanline_callback callback, void *user_data); // Create streaming decoder
+RPNGAPI void rpng_decoder_reset(rpng_decoder *decoder, void *user_data);                      // Reset decoder for a new image (memory kept)
+RPNGAPI int rpng_decoder_feed(rpng_decoder *decoder, const char *data, int size);            // Feed PNG data, returns rpng_decoder_state
+RPNGAPI bool rpng_decoder_get_info(rpng_decoder *decoder, int *width, int *height, int *color_channels, int *bit_depth); // Get image info (available after IHDR)
+RPNGAPI void rpng_decoder_destroy(rpng_decoder *decoder);                                     // Destroy streaming decoder
+
 // Read and write chunks from file
 RPNGAPI int rpng_chunk_count(const char *filename);                                  // Count the chunks in a PNG image
 RPNGAPI rpng_chunk rpng_chunk_read(const char *filename, const char *chunk_type);    // Read one chunk type
@@ -307,6 +439,7 @@ RPNGAPI rpng_chunk *rpng_chunk_read_all_from_memory(const char *buffer, int *cou
 RPNGAPI char *rpng_chunk_remove_from_memory(const char *buffer, const char *chunk_type, int *output_size);  // Remove one chunk type from memory
 RPNGAPI char *rpng_chunk_remove_ancillary_from_memory(const char *buffer, int *output_size);                // Remove all chunks except: IHDR-IDAT-IEND
 RPNGAPI char *rpng_chunk_write_from_memory(const char *buffer, rpng_chunk chunk, int *output_size);         // Write one new chunk after IHDR (any kind)
+RPNGAPI char *rpng_chunk_replace_from_memory(const char *buffer, rpng_chunk chunk, int *output_size);       // Replace one chunk type (written after IHDR), only removed if chunk length is 0
 RPNGAPI char *rpng_chunk_combine_image_data_from_memory(char *buffer, int *output_size);                    // Combine multiple IDAT chunks into a single one
 RPNGAPI char *rpng_chunk_split_image_data_from_memory(char *buffer, int split_size, int *output_size);      // Split one IDAT chunk into multiple ones
 
@@ -337,6 +470,87 @@ RPNGAPI char *rpng_chunk_split_image_data_from_memory(char *buffer, int split_si
     #include <unistd.h>     // Required for: access() (POSIX, not C standard) [file_exists()]
 #endif
 
+// SIMD instructions set used for scanlines filtering, selected at compile time
+#if !defined(RPNG_NO_SIMD)
+    #if defined(__AVX2__)
+        #include <immintrin.h>      // Required for: AVX2 intrinsics [rpng_filter_scanline()]
+        #define RPNG_SIMD_AVX2
+    #elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+        #include <emmintrin.h>      // Required for: SSE2 intrinsics [rpng_filter_scanline()]
+        #define RPNG_SIMD_SSE2
+    #elif defined(__ARM_NEON) || defined(_M_ARM64)
+        #include <arm_neon.h>       // Required for: NEON intrinsics [rpng_filter_scanline()]
+        #define RPNG_SIMD_NEON
+    #endif
+#endif
+
+// CRC32 hardware instructions, PCLMULQDQ function compiled for it and selected at runtime (CPU support checked)
+#if !defined(RPNG_NO_SIMD)
+    #if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+        #include <wmmintrin.h>      // Required for: PCLMULQDQ intrinsics [update_crc32()]
+        #define RPNG_CRC32_PCLMUL
+        #define RPNG_TARGET_PCLMUL  __attribute__((target("sse2,pclmul")))
+    #elif defined(_M_X64) && defined(_MSC_VER)
+        #include <intrin.h>         // Required for: __cpuid(), PCLMULQDQ intrinsics [update_crc32()]
+        #define RPNG_CRC32_PCLMUL
+        #define RPNG_TARGET_PCLMUL
+    #elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+        #include <arm_acle.h>       // Required for: __crc32d(), __crc32b() [update_crc32()]
+        #define RPNG_CRC32_ARM
+    #endif
+#endif
+
+// x86 vector operations, same kernel used for AVX2 (32 bytes) and SSE2 (16 bytes)
+#if defined(RPNG_SIMD_AVX2)
+    #define RPNG_SIMD_SIZE                  32
+    #define rpng_simd                       __m256i
+    #define rpng_simd_load(p)               _mm256_loadu_si256((const __m256i *)(const void *)(p))
+    #define rpng_simd_store(p, v)           _mm256_storeu_si256((__m256i *)(void *)(p), v)
+    #define rpng_simd_zero()                _mm256_setzero_si256()
+    #define rpng_simd_set1_u8(v)            _mm256_set1_epi8(v)
+    #define rpng_simd_and(a, b)             _mm256_and_si256(a, b)
+    #define rpng_simd_or(a, b)              _mm256_or_si256(a, b)
+    #define rpng_simd_xor(a, b)             _mm256_xor_si256(a, b)
+    #define rpng_simd_andnot(a, b)          _mm256_andnot_si256(a, b)
+    #define rpng_simd_sub_u8(a, b)          _mm256_sub_epi8(a, b)
+    #define rpng_simd_subs_u8(a, b)         _mm256_subs_epu8(a, b)
+    #define rpng_simd_avg_u8(a, b)          _mm256_avg_epu8(a, b)
+    #define rpng_simd_min_u8(a, b)          _mm256_min_epu8(a, b)
+    #define rpng_simd_cmpeq_u8(a, b)        _mm256_cmpeq_epi8(a, b)
+    #define rpng_simd_unpacklo_u8(a, b)     _mm256_unpacklo_epi8(a, b)
+    #define rpng_simd_unpackhi_u8(a, b)     _mm256_unpackhi_epi8(a, b)
+    #define rpng_simd_add_i16(a, b)         _mm256_add_epi16(a, b)
+    #define rpng_simd_sub_i16(a, b)         _mm256_sub_epi16(a, b)
+    #define rpng_simd_max_i16(a, b)         _mm256_max_epi16(a, b)
+    #define rpng_simd_packus_i16(a, b)      _mm256_packus_epi16(a, b)
+    #define rpng_simd_sad_u8(a, b)          _mm256_sad_epu8(a, b)
+    #define rpng_simd_add_u64(a, b)         _mm256_add_epi64(a, b)
+#elif defined(RPNG_SIMD_SSE2)
+    #define RPNG_SIMD_SIZE                  16
+    #define rpng_simd                       __m128i
+    #define rpng_simd_load(p)               _mm_loadu_si128((const __m128i *)(const void *)(p))
+    #define rpng_simd_store(p, v)           _mm_storeu_si128((__m128i *)(void *)(p), v)
+    #define rpng_simd_zero()                _mm_setzero_si128()
+    #define rpng_simd_set1_u8(v)            _mm_set1_epi8(v)
+    #define rpng_simd_and(a, b)             _mm_and_si128(a, b)
+    #define rpng_simd_or(a, b)              _mm_or_si128(a, b)
+    #define rpng_simd_xor(a, b)             _mm_xor_si128(a, b)
+    #define rpng_simd_andnot(a, b)          _mm_andnot_si128(a, b)
+    #define rpng_simd_sub_u8(a, b)          _mm_sub_epi8(a, b)
+    #define rpng_simd_subs_u8(a, b)         _mm_subs_epu8(a, b)
+    #define rpng_simd_avg_u8(a, b)          _mm_avg_epu8(a, b)
+    #define rpng_simd_min_u8(a, b)          _mm_min_epu8(a, b)
+    #define rpng_simd_cmpeq_u8(a, b)        _mm_cmpeq_epi8(a, b)
+    #define rpng_simd_unpacklo_u8(a, b)     _mm_unpacklo_epi8(a, b)
+    #define rpng_simd_unpackhi_u8(a, b)     _mm_unpackhi_epi8(a, b)
+    #define rpng_simd_add_i16(a, b)         _mm_add_epi16(a, b)
+    #define rpng_simd_sub_i16(a, b)         _mm_sub_epi16(a, b)
+    #define rpng_simd_max_i16(a, b)         _mm_max_epi16(a, b)
+    #define rpng_simd_packus_i16(a, b)      _mm_packus_epi16(a, b)
+    #define rpng_simd_sad_u8(a, b)          _mm_sad_epu8(a, b)
+    #define rpng_simd_add_u64(a, b)         _mm_add_epi64(a, b)
+#endif
+
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
@@ -469,22 +683,188 @@ typedef struct {
 //fcTL: Frame Control
 //fdAT: Frame Data
 
+// Image data compression stripe job (multithreaded compression)
+typedef struct {
+    const unsigned char *data;      // Filtered image data (all stripes)
+    int begin;                      // Stripe begin offset, previous 32 KB used as dictionary
+    int end;                        // Stripe end offset
+    bool last;                      // Last stripe, final deflate block
+    int level;                      // Deflate compression level
+    unsigned char *output;          // Compressed stripe (raw deflate, byte aligned)
+    int output_size;                // Compressed stripe size, 0 on failure
+    unsigned int adler;             // Stripe Adler-32
+} rpng_deflate_stripe;
+
+// Image data compression candidate job (squeeze compression effort)
+typedef struct {
+    const unsigned char *data;      // Filtered image data (candidate filter strategy)
+    int size;                       // Filtered image data size
+    int filter;                     // Filter strategy: -2 brute force, -1 adaptive, 0-4 fixed
+    int level;                      // Deflate compression level
+    char *output;                   // Compressed data (zlib stream)
+    int output_size;                // Compressed data size, 0 on failure
+} rpng_deflate_candidate;
+
+// Image data analysis for color type reduction (8 bit RGB/RGBA data)
+#define RPNG_ANALYSIS_HASH_SIZE     1024    // Colors hash table size (power of two, bigger than 256)
+
+typedef struct {
+    bool opaque;                    // All alpha values are 255
+    bool gray;                      // All pixels have r == g == b
+    bool binary_alpha;              // All alpha values are 0 or 255
+    bool color_key;                 // Transparent pixels share one color, not used by opaque pixels
+    rpng_color key;                 // Transparent pixels color (color key)
+    int color_count;                // Unique colors count, 257 if more than 256 colors
+    rpng_color palette[256];        // Unique colors (if color_count <= 256)
+    unsigned int hash_colors[RPNG_ANALYSIS_HASH_SIZE];  // Hash table: packed RGBA colors
+    short hash_index[RPNG_ANALYSIS_HASH_SIZE];          // Hash table: palette index, -1 for empty slot
+} rpng_image_analysis;
+
+// Streaming inflate Huffman table
+// NOTE: Canonical codes (count per length, symbols sorted), short codes resolved with direct lookup
+#define RPNG_HUFFMAN_FAST_BITS      10
+
+typedef struct {
+    short count[16];                // Codes count per length
+    short symbol[288];              // Symbols ordered by code
+    unsigned short fast[1 << RPNG_HUFFMAN_FAST_BITS]; // Lookup by next bits: (symbol << 4) | length, 0 if longer code
+} rpng_huffman;
+
+// Streaming decoder, PNG container and inflate states
+struct rpng_decoder {
+    rpng_scanline_callback callback;    // Scanline callback
+    void *user_data;                    // Scanline callback user data
+
+    int state;                      // PNG stream state (signature, chunk header, data, CRC)
+    unsigned char staging[16];      // Staging for fixed size fields (signature, chunk header, CRC, IHDR)
+    int staging_size;               // Staging bytes filled
+    char chunk_type[4];             // Current chunk type
+    unsigned int chunk_remaining;   // Current chunk data remaining
+    unsigned int crc;               // Current chunk CRC32 (running)
+    bool header_read;               // IHDR chunk has been read
+
+    int width;                      // Image width
+    int height;                     // Image height
+    int color_channels;             // Image color channels
+    int bit_depth;                  // Image bit depth
+    int pixel_size;                 // Bytes per pixel (rounded up)
+    int scanline_size;              // Scanline size (no filter byte)
+
+    unsigned char *scanlines;       // Current and previous scanlines, filter byte included
+    int scanlines_capacity;         // Scanlines memory allocated
+    int row;                        // Current scanline index
+    int row_fill;                   // Current scanline bytes filled (filter byte included)
+    unsigned int adler_a;           // Output Adler-32 (running)
+    unsigned int adler_b;
+
+    int inflate_state;              // Inflate state (zlib header, block header, codes, stored, adler)
+    bool last_block;                // Current block is final
+    unsigned int stored_remaining;  // Stored block bytes remaining
+    unsigned long long bitbuf;      // Bits buffer
+    int bitcnt;                     // Bits available in buffer
+    unsigned char *input;           // Compressed data pending (not consumed)
+    int input_size;
+    int input_capacity;
+    int input_pos;
+    unsigned int output_size;       // Decompressed bytes total
+    unsigned char window[32768];    // Inflate window (last 32 KB decompressed)
+    rpng_huffman lit;               // Literal/length codes
+    rpng_huffman dist;              // Distance codes
+};
+
+// PNG stream states
+#define RPNG_STREAM_SIGNATURE       0
+#define RPNG_STREAM_CHUNK_HEADER    1
+#define RPNG_STREAM_CHUNK_DATA      2
+#define RPNG_STREAM_CHUNK_CRC       3
+#define RPNG_STREAM_END             4
+
+// Inflate states
+#define RPNG_INFLATE_ZLIB_HEADER    0
+#define RPNG_INFLATE_BLOCK_HEADER   1
+#define RPNG_INFLATE_DYNAMIC_HEADER 2
+#define RPNG_INFLATE_CODES          3
+#define RPNG_INFLATE_STORED         4
+#define RPNG_INFLATE_ADLER          5
+#define RPNG_INFLATE_END            6
+
+// Inflate step results
+#define RPNG_INFLATE_STEP_OK        0
+#define RPNG_INFLATE_STEP_WAIT      1       // Bits not available, step restored
+#define RPNG_INFLATE_STEP_ERROR     2
+
 //----------------------------------------------------------------------------------
 // Global Variables Definition
 //----------------------------------------------------------------------------------
 const unsigned char png_signature[8] = { 0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a }; // PNG Signature
 
+static int rpng_deflate_thread_count = 1;           // Threads used for image data compression
+static rpng_jobs_runner rpng_deflate_runner = NULL; // Jobs runner for multithreaded compression
+static int rpng_compression_effort_level = RPNG_COMPRESSION_DEFAULT;   // Image data compression effort
+
 //----------------------------------------------------------------------------------
 // Module Internal Functions Declaration
 //----------------------------------------------------------------------------------
-// Prefilter and compress image data (image_data -> IDAT chunk.data)
-static char *rpng_inflate_image_data(char *image_data, int image_data_size, int width, int height, int pixel_size);
 // Decompress and unfilter image data (IDAT chunk.data -> image_data)
-static char *rpng_deflate_image_data(const char *image_data, int image_data_size, int width, int height, int pixel_size, int *output_size, int forced_filter_type);
+static char *rpng_inflate_image_data(char *image_data, int image_data_size, int width, int height, int pixel_size);
+// Analyze image data for color type reduction (8 bit RGB/RGBA)
+static void rpng_analyze_image_data(const unsigned char *data, int pixel_count, int color_channels, rpng_image_analysis *analysis);
+static int rpng_analysis_color_index(rpng_image_analysis *analysis, unsigned int color, bool insert); // Get palette index for color, -1 if not found
+// Save indexed png data to memory buffer, ancillary chunks and compression results provided
+static char *rpng_save_image_indexed_stats(const char *indexed_data, int width, int height, rpng_palette palette, const rpng_chunk *chunks, int chunk_count, int *output_size, rpng_compression_stats *stats);
+// Save 8 bit RGB/RGBA data as grayscale/RGB with or without alpha channel, color key (tRNS) if provided
+static char *rpng_save_image_channels(const unsigned char *data, int width, int height, int color_channels, bool gray, int channels, const rpng_color *key, const rpng_chunk *chunks, int chunk_count, int *output_size, rpng_compression_stats *stats);
+// Write chunks into output buffer (length, type, data and CRC32), returns bytes written
+static int rpng_write_chunk(char *output, const char *type, const void *data, int length);
+static int rpng_write_chunks(char *output, const rpng_chunk *chunks, int chunk_count);
+static int rpng_get_chunks_size(const rpng_chunk *chunks, int chunk_count);   // Get chunks size written (length, type, data and CRC32)
+
+// Prefilter and compress image data (image_data -> IDAT chunk.data)
+static char *rpng_deflate_image_data(const char *image_data, int image_data_size, int width, int height, int pixel_size, int *output_size, int forced_filter_type, rpng_compression_stats *stats);
+
+// Filter image data scanlines, filter type -1 for adaptive filter selection per scanline
+static void rpng_filter_image_data(const unsigned char *image_data, int width, int height, int pixel_size, int filter_type, unsigned char *data_filtered, unsigned char *scratch);
+// Filter image data scanlines, filter type for every scanline selected by compressed size (brute force)
+static void rpng_filter_image_data_brute(const unsigned char *image_data, int width, int height, int pixel_size, unsigned char *data_filtered, unsigned char *scratch);
+// Compress image data trying all filter strategies and several deflate levels, smallest kept (squeeze)
+static char *rpng_squeeze_image_data(const unsigned char *image_data, int width, int height, int pixel_size, int *output_size, rpng_compression_stats *stats);
+static void rpng_deflate_candidate_job(void *job_data);  // Compress one candidate (job function)
+// Compress filtered image data into a zlib stream, stripes compressed in parallel if possible
+static char *rpng_compress_image_data(const unsigned char *data_filtered, int data_filtered_size, int scanline_size, int height, int level, int *output_size);
+// Store image data into a zlib stream (stored deflate blocks, no compression)
+static char *rpng_store_image_data(const unsigned char *data_filtered, int data_filtered_size, int *output_size);
+// Compress filtered image data in stripes using jobs runner (multithreaded), returns zlib stream
+static char *rpng_deflate_stripes(const unsigned char *data_filtered, int data_filtered_size, int scanline_size, int height, int stripe_count, int level, int *output_size);
+static void rpng_deflate_stripe_job(void *job_data);     // Compress one stripe (job function)
+static unsigned int combine_adler32(unsigned int adler1, unsigned int adler2, int size2); // Combine Adler-32 of two consecutive data blocks
+
+// Concatenate all IDAT chunks data (output can be NULL to get size), CRC32 checked if requested
+static int rpng_concat_image_data(const char *buffer, char *output, bool *crc_valid);
+// Get scratch arena memory of required size, previous content is not kept
+static char *rpng_arena_reserve(rpng_arena *arena, int size);
+// Unfilter one scanline, output can be filtered data position or before it (in place)
+static bool rpng_unfilter_scanline(unsigned char *scanline, const unsigned char *filtered, const unsigned char *prev_scanline, int scanline_size, int pixel_size, int filter);
+
+// Streaming decoder internal functions
+static int rpng_decoder_process_field(rpng_decoder *decoder);                                         // Process staged field (signature, chunk header, IHDR, CRC)
+static int rpng_decoder_inflate(rpng_decoder *decoder, const unsigned char *data, int size);         // Inflate compressed data piece
+static int rpng_decoder_inflate_step(rpng_decoder *decoder);                                          // Inflate one step, restored if bits not available
+static int rpng_decoder_output(rpng_decoder *decoder, const unsigned char *data, int size);          // Output decompressed bytes to scanlines
+static int rpng_decoder_output_match(rpng_decoder *decoder, int length, int distance);               // Output match from inflate window
+static bool rpng_huffman_build(rpng_huffman *huffman, const unsigned char *lengths, int count);      // Build Huffman table from code lengths
+static int rpng_huffman_decode(rpng_decoder *decoder, const rpng_huffman *huffman);                 // Decode one symbol (-1: bits not available, -2: code not valid)
+static bool rpng_decoder_bits(rpng_decoder *decoder, int count, unsigned int *value);                // Get bits from input (false if not available)
 
 // Swap integer from big<->little endian
 static unsigned int swap_endian(unsigned int value);
 static unsigned int compute_crc32(unsigned char *buffer, int size);
+static unsigned int update_crc32(unsigned int crc, const unsigned char *buffer, int size);
+static unsigned int update_adler32(unsigned int adler, const unsigned char *buffer, int size);
+
+// Compute all five filters for a scanline, accumulating sum of absolute values per filter
+static void rpng_filter_scanline(const unsigned char *scanline, const unsigned char *prev_scanline, int scanline_size, int pixel_size, unsigned char **filtered, int *sum_value);
+static void rpng_filter_byte(int x, int a, int b, int c, int p, unsigned char **filtered, int *sum_value);
+static void rpng_filter_scanline_single(const unsigned char *scanline, const unsigned char *prev_scanline, int scanline_size, int pixel_size, int filter, unsigned char *filtered);
 
 // Load/save png file data from/to memory buffer
 static char *load_file_to_buffer(const char *filename, int *bytes_read);
@@ -565,6 +945,10 @@ extern int zsdeflate(struct sdefl *s, void *o, const void *i, int n, int lvl);
 
 #endif /* SDEFL_H_INCLUDED */
 
+// rpng: raw deflate of an input range with preset dictionary, always available (static),
+// used for multithreaded compression independently of sdefl public functions provider
+static int sdefl_compr_range(struct sdefl *s, unsigned char *out, const unsigned char *in, int dict, int begin, int in_len, int lvl, int is_last);
+
 //=========================================================================
 //                           SINFL
 // DEFLATE DECOMPRESSION algorithm: https://github.com/vurtun/lib/sinfl.h
@@ -1224,6 +1608,14 @@ void rpng_chunk_split_image_data(const char *filename, int split_size)
 //----------------------------------------------------------------------------------------------------------
 // Load png data from memory buffer
 char *rpng_load_image_from_memory(const char *buffer, int *width, int *height, int *color_channels, int *bit_depth)
+{
+    return rpng_load_image_from_memory_arena(buffer, width, height, color_channels, bit_depth, NULL);
+}
+
+// Load png data from memory buffer, using scratch arena
+// NOTE: Arena keeps compressed image data (IDAT), it can be reused for multiple images loading,
+// a temporary arena is used if not provided (NULL)
+char *rpng_load_image_from_memory_arena(const char *buffer, int *width, int *height, int *color_channels, int *bit_depth, rpng_arena *arena)
 {
     char *data = NULL;
 
@@ -1250,7 +1642,11 @@ char *rpng_load_image_from_memory(const char *buffer, int *width, int *height, i
     }
 
     // TODO: Support bit depths of 1/2/4 bits? -> Convert to 8bit grayscale
-    if ((*color_channels == 1) && (*bit_depth != 8) && (*bit_depth != 16)) return data;  // Bit depth 1/2/4 not supported
+    if ((*color_channels == 1) && (*bit_depth != 8) && (*bit_depth != 16))
+    {
+        RPNG_FREE(chunk_info.data);
+        return data;  // Bit depth 1/2/4 not supported
+    }
 
     // Additional info provided by IHDR (in case it was required)
     //IHDRData->compression;        // Compression method: 0 (DEFLATE)
@@ -1259,30 +1655,36 @@ char *rpng_load_image_from_memory(const char *buffer, int *width, int *height, i
 
     if (*color_channels != 0)
     {
-        // NOTE: All splitted chunks are joined on reading
-        rpng_chunk chunk_image = rpng_chunk_read_from_memory(buffer, "IDAT");
+        // NOTE: All splitted chunks are joined on reading, into scratch arena
+        int image_data_size = rpng_concat_image_data(buffer, NULL, NULL);
 
-        if (chunk_image.data != NULL)
+        if (image_data_size > 0)
         {
-            // Verify data integrity CRC over all chunk data concatenated
-            unsigned int crc = 0;
-            char *chunk_type_data = (char *)RPNG_CALLOC(4 + chunk_image.length, 1);
-            memcpy(chunk_type_data, chunk_image.type, 4);
-            memcpy(chunk_type_data + 4, chunk_image.data, chunk_image.length);
-            crc = compute_crc32((unsigned char *)chunk_type_data, 4 + chunk_image.length);
-            RPNG_FREE(chunk_type_data);
+            rpng_arena temp_arena = { 0 };
+            rpng_arena *scratch = (arena != NULL)? arena : &temp_arena;
+
+            // NOTE: Inflate reads input data 64bit at a time, some padding is required after data
+            char *image_data = rpng_arena_reserve(scratch, image_data_size + RPNG_INFLATE_PADDING);
 
-            if (crc == chunk_image.crc) // Validate crc
+            if (image_data != NULL)
             {
-                int pixel_size = *color_channels*(*bit_depth/8);
-                data = rpng_inflate_image_data(chunk_image.data, chunk_image.length, *width, *height, pixel_size);
+                // Verify data integrity CRC of every IDAT chunk
+                bool crc_valid = false;
+                rpng_concat_image_data(buffer, image_data, &crc_valid);
+                memset(image_data + image_data_size, 0, RPNG_INFLATE_PADDING);
 
-                if (data == NULL) RPNG_LOG("WARNING: IDAT image data decompression failed\n");
+                if (crc_valid)
+                {
+                    int pixel_size = *color_channels*(*bit_depth/8);
+                    data = rpng_inflate_image_data(image_data, image_data_size, *width, *height, pixel_size);
+
+                    if (data == NULL) RPNG_LOG("WARNING: IDAT image data decompression failed\n");
+                }
+                else RPNG_LOG("WARNING: CRC not valid, IDAT chunk image data could be corrupted\n");
             }
-            else RPNG_LOG("WARNING: CRC not valid, IDAT chunk image data could be corrupted\n");
-        }
 
-        RPNG_FREE(chunk_image.data);
+            if (arena == NULL) rpng_arena_free(&temp_arena);
+        }
     }
     else RPNG_LOG("WARNING: Failed to load file, image pixel format not supported\n");
 
@@ -1291,6 +1693,159 @@ char *rpng_load_image_from_memory(const char *buffer, int *width, int *height, i
     return data;
 }
 
+// Free scratch arena memory
+void rpng_arena_free(rpng_arena *arena)
+{
+    RPNG_FREE(arena->data);
+
+    arena->data = NULL;
+    arena->size = 0;
+}
+
+// Set threads count for image data compression, jobs runner required for more than 1 thread
+void rpng_set_deflate_threads(int thread_count, rpng_jobs_runner runner)
+{
+    rpng_deflate_thread_count = (thread_count > 1)? thread_count : 1;
+    rpng_deflate_runner = runner;
+}
+
+// Set compression effort for image data (rpng_compression_effort)
+void rpng_set_compression_effort(int effort)
+{
+    if (effort < RPNG_COMPRESSION_STORE) effort = RPNG_COMPRESSION_STORE;
+    if (effort > RPNG_COMPRESSION_SQUEEZE) effort = RPNG_COMPRESSION_SQUEEZE;
+
+    rpng_compression_effort_level = effort;
+}
+
+// Create streaming decoder
+// NOTE: Scanline callback is required, decoder can be reused for multiple images with rpng_decoder_reset()
+rpng_decoder *rpng_decoder_create(rpng_scanline_callback callback, void *user_data)
+{
+    if (callback == NULL) return NULL;
+
+    rpng_decoder *decoder = (rpng_decoder *)RPNG_CALLOC(1, sizeof(rpng_decoder));
+
+    if (decoder != NULL)
+    {
+        decoder->callback = callback;
+        rpng_decoder_reset(decoder, user_data);
+    }
+
+    return decoder;
+}
+
+// Reset decoder for a new image (memory kept)
+void rpng_decoder_reset(rpng_decoder *decoder, void *user_data)
+{
+    decoder->user_data = user_data;
+
+    decoder->state = RPNG_STREAM_SIGNATURE;
+    decoder->staging_size = 0;
+    decoder->chunk_remaining = 0;
+    decoder->header_read = false;
+
+    decoder->width = 0;
+    decoder->height = 0;
+    decoder->color_channels = 0;
+    decoder->bit_depth = 0;
+    decoder->row = 0;
+    decoder->row_fill = 0;
+    decoder->adler_a = 1;
+    decoder->adler_b = 0;
+
+    decoder->inflate_state = RPNG_INFLATE_ZLIB_HEADER;
+    decoder->last_block = false;
+    decoder->stored_remaining = 0;
+    decoder->bitbuf = 0;
+    decoder->bitcnt = 0;
+    decoder->input_size = 0;
+    decoder->input_pos = 0;
+    decoder->output_size = 0;
+}
+
+// Feed PNG data, returns rpng_decoder_state
+// NOTE: Data can be provided in pieces of any size, scanlines are provided as soon as decompressed,
+// decoding stops on first error (following calls return RPNG_DECODER_ERROR)
+int rpng_decoder_feed(rpng_decoder *decoder, const char *data, int size)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+    int result = RPNG_DECODER_CONTINUE;
+
+    if (decoder->state == RPNG_STREAM_END) return (size > 0)? RPNG_DECODER_ERROR : RPNG_DECODER_DONE;
+    if (decoder->state < 0) return RPNG_DECODER_ERROR;
+
+    while ((size > 0) && (result == RPNG_DECODER_CONTINUE))
+    {
+        if ((decoder->state == RPNG_STREAM_CHUNK_DATA) && decoder->header_read)
+        {
+            // Chunk data: IDAT data inflated, other chunks skipped (only CRC checked)
+            int count = (decoder->chunk_remaining < (unsigned int)size)? (int)decoder->chunk_remaining : size;
+
+            decoder->crc = update_crc32(decoder->crc, bytes, count);
+            if (memcmp(decoder->chunk_type, "IDAT", 4) == 0) result = rpng_decoder_inflate(decoder, bytes, count);
+
+            decoder->chunk_remaining -= count;
+            if (decoder->chunk_remaining == 0) decoder->state = RPNG_STREAM_CHUNK_CRC;
+
+            bytes += count;
+            size -= count;
+        }
+        else
+        {
+            // Fixed size fields staged: signature (8), chunk header (8), IHDR data (13), CRC (4)
+            int field_size = 4;
+            if (decoder->state == RPNG_STREAM_SIGNATURE) field_size = 8;
+            else if (decoder->state == RPNG_STREAM_CHUNK_HEADER) field_size = 8;
+            else if (decoder->state == RPNG_STREAM_CHUNK_DATA) field_size = 13;
+
+            int count = field_size - decoder->staging_size;
+            if (count > size) count = size;
+
+            memcpy(decoder->staging + decoder->staging_size, bytes, count);
+            decoder->staging_size += count;
+            bytes += count;
+            size -= count;
+
+            if (decoder->staging_size == field_size)
+            {
+                if (decoder->state == RPNG_STREAM_CHUNK_DATA) decoder->crc = update_crc32(decoder->crc, decoder->staging, field_size);
+
+                decoder->staging_size = 0;
+                result = rpng_decoder_process_field(decoder);
+            }
+        }
+    }
+
+    if ((result == RPNG_DECODER_DONE) && (size > 0)) result = RPNG_DECODER_ERROR;     // Data after IEND chunk
+    if (result == RPNG_DECODER_ERROR) decoder->state = -1;
+
+    return result;
+}
+
+// Get image info (available after IHDR)
+bool rpng_decoder_get_info(rpng_decoder *decoder, int *width, int *height, int *color_channels, int *bit_depth)
+{
+    if (!decoder->header_read) return false;
+
+    *width = decoder->width;
+    *height = decoder->height;
+    *color_channels = decoder->color_channels;
+    *bit_depth = decoder->bit_depth;
+
+    return true;
+}
+
+// Destroy streaming decoder
+void rpng_decoder_destroy(rpng_decoder *decoder)
+{
+    if (decoder == NULL) return;
+
+    RPNG_FREE(decoder->scanlines);
+    RPNG_FREE(decoder->input);
+    RPNG_FREE(decoder);
+}
+
 // Load indexed png data (including palette) from memory buffer
 // NOTE: Returns indexed data as an index byte array (8bit) along the palette data (PLTE - RGB888 - 24bit)
 char *rpng_load_image_indexed_from_memory(const char *buffer, int *width, int *height, rpng_palette *palette)
@@ -1375,9 +1930,24 @@ char *rpng_load_image_indexed_from_memory(const char *buffer, int *width, int *h
 
 // Save png data to memory buffer
 char *rpng_save_image_to_memory(const char *data, int width, int height, int color_channels, int bit_depth, int *output_size)
+{
+    return rpng_save_image_to_memory_stats(data, width, height, color_channels, bit_depth, output_size, NULL);
+}
+
+// Save png data to memory buffer, compression results provided
+// NOTE: Stats can be NULL if not required
+char *rpng_save_image_to_memory_stats(const char *data, int width, int height, int color_channels, int bit_depth, int *output_size, rpng_compression_stats *stats)
+{
+    return rpng_save_image_chunks_to_memory(data, width, height, color_channels, bit_depth, NULL, 0, output_size, stats);
+}
+
+// Save png data to memory buffer, ancillary chunks written after IHDR, compression results provided
+// NOTE: Output buffer allocated once at required size, chunks and stats can be NULL if not required
+char *rpng_save_image_chunks_to_memory(const char *data, int width, int height, int color_channels, int bit_depth, const rpng_chunk *chunks, int chunk_count, int *output_size, rpng_compression_stats *stats)
 {
     char *output_buffer = NULL;
     int output_buffer_size = 0;
+    *output_size = 0;
 
     if ((bit_depth != 8) && (bit_depth != 16))
     {
@@ -1402,12 +1972,12 @@ char *rpng_save_image_to_memory(const char *data, int width, int height, int col
     // Image data pre-processing to append filter type byte to every scanline
     int pixel_size = color_channels*(bit_depth/8);
     int comp_data_size = 0;
-    char *comp_data = rpng_deflate_image_data(data, width*height*pixel_size, width, height, pixel_size, &comp_data_size, -1);
+    char *comp_data = rpng_deflate_image_data(data, width*height*pixel_size, width, height, pixel_size, &comp_data_size, -1, stats);
 
     // Security check to verify compression worked
     if ((comp_data != NULL) && (comp_data_size > 0))
     {
-        output_buffer = (char *)RPNG_CALLOC(8 + 13 + 12 + (comp_data_size + 12) + 12, 1); // Signature + IHDR + IDAT + IEND
+        output_buffer = (char *)RPNG_CALLOC(8 + 13 + 12 + rpng_get_chunks_size(chunks, chunk_count) + (comp_data_size + 12) + 12, 1); // Signature + IHDR + chunks + IDAT + IEND
 
         // Write PNG signature
         memcpy(output_buffer, png_signature, 8);
@@ -1423,6 +1993,9 @@ char *rpng_save_image_to_memory(const char *data, int width, int height, int col
         memcpy(output_buffer + 8 + 8 + 13, &crc, 4);
         output_buffer_size += (8 + 12 + 13);
 
+        // Write ancillary chunks (if provided)
+        output_buffer_size += rpng_write_chunks(output_buffer + output_buffer_size, chunks, chunk_count);
+
         // Write PNG chunk IDAT
         unsigned int length_IDAT = comp_data_size;
         length_IDAT = swap_endian(length_IDAT);
@@ -1448,6 +2021,166 @@ char *rpng_save_image_to_memory(const char *data, int width, int height, int col
 
 // Save indexed png data to memory buffer
 char *rpng_save_image_indexed_to_memory(const char *indexed_data, int width, int height, rpng_palette palette, int *output_size)
+{
+    return rpng_save_image_indexed_stats(indexed_data, width, height, palette, NULL, 0, output_size, NULL);
+}
+
+// Save indexed png data to memory buffer, ancillary chunks written after IHDR
+char *rpng_save_image_indexed_chunks_to_memory(const char *indexed_data, int width, int height, rpng_palette palette, const rpng_chunk *chunks, int chunk_count, int *output_size)
+{
+    return rpng_save_image_indexed_stats(indexed_data, width, height, palette, chunks, chunk_count, output_size, NULL);
+}
+
+// Save png data to memory buffer, reduced to smallest lossless color type
+// NOTE: Only 8 bit RGB/RGBA data is reduced, grayscale and direct color types are chosen from analysis,
+// palette (256 or less colors) is also compressed and the smallest output is kept
+char *rpng_save_image_reduced_to_memory(const char *data, int width, int height, int color_channels, int *output_size, rpng_compression_stats *stats)
+{
+    return rpng_save_image_reduced_chunks_to_memory(data, width, height, color_channels, NULL, 0, output_size, stats);
+}
+
+// Save png data to memory buffer, reduced to smallest lossless color type, ancillary chunks written after IHDR
+// NOTE: Chunks are written on every color type tried, output sizes compared include them
+char *rpng_save_image_reduced_chunks_to_memory(const char *data, int width, int height, int color_channels, const rpng_chunk *chunks, int chunk_count, int *output_size, rpng_compression_stats *stats)
+{
+    if ((color_channels != 3) && (color_channels != 4)) return rpng_save_image_chunks_to_memory(data, width, height, color_channels, 8, chunks, chunk_count, output_size, stats);
+
+    int pixel_count = width*height;
+    const unsigned char *pixels = (const unsigned char *)data;
+    rpng_image_analysis *analysis = (rpng_image_analysis *)RPNG_MALLOC(sizeof(rpng_image_analysis));
+    if (analysis == NULL) return rpng_save_image_chunks_to_memory(data, width, height, color_channels, 8, chunks, chunk_count, output_size, stats);
+
+    rpng_analyze_image_data(pixels, pixel_count, color_channels, analysis);
+
+    // Direct color type: grayscale (1 or 2 channels) or RGB/RGBA (3 or 4 channels)
+    // NOTE: Binary alpha with color key is saved without alpha channel plus tRNS chunk,
+    // alpha channel is also tried in that case, color key is not always smaller
+    bool use_key = !analysis->opaque && analysis->color_key;
+    int channels = (analysis->gray? 1 : 3) + ((analysis->opaque || use_key)? 0 : 1);
+
+    rpng_compression_stats direct_stats = { 0 };
+    int direct_size = 0;
+    char *direct = rpng_save_image_channels(pixels, width, height, color_channels, analysis->gray, channels, use_key? &analysis->key : NULL, chunks, chunk_count, &direct_size, &direct_stats);
+
+    if (use_key)
+    {
+        rpng_compression_stats alpha_stats = { 0 };
+        int alpha_size = 0;
+        char *alpha = rpng_save_image_channels(pixels, width, height, color_channels, analysis->gray, channels + 1, NULL, chunks, chunk_count, &alpha_size, &alpha_stats);
+
+        if ((alpha != NULL) && ((direct == NULL) || (alpha_size < direct_size)))
+        {
+            RPNG_FREE(direct);
+            direct = alpha;
+            direct_size = alpha_size;
+            direct_stats = alpha_stats;
+            channels++;
+            use_key = false;
+        }
+        else RPNG_FREE(alpha);
+    }
+
+    // Palette color type: not tried for opaque grayscale (same data size, no palette required)
+    if ((analysis->color_count <= 256) && !(analysis->gray && (channels == 1)))
+    {
+        char *indexed_data = (char *)RPNG_MALLOC(pixel_count);
+
+        if (indexed_data != NULL)
+        {
+            for (int i = 0; i < pixel_count; i++)
+            {
+                const unsigned char *pixel = pixels + i*color_channels;
+                unsigned int color = pixel[0] | (pixel[1] << 8) | (pixel[2] << 16) | ((unsigned int)((color_channels == 4)? pixel[3] : 255) << 24);
+                indexed_data[i] = (char)rpng_analysis_color_index(analysis, color, false);
+            }
+
+            rpng_palette palette = { analysis->color_count, analysis->palette };
+            rpng_compression_stats indexed_stats = { 0 };
+            int indexed_size = 0;
+            char *indexed = rpng_save_image_indexed_stats(indexed_data, width, height, palette, chunks, chunk_count, &indexed_size, &indexed_stats);
+            RPNG_FREE(indexed_data);
+
+            if ((indexed != NULL) && ((direct == NULL) || (indexed_size < direct_size)))
+            {
+                RPNG_FREE(direct);
+                direct = indexed;
+                direct_size = indexed_size;
+                direct_stats = indexed_stats;
+            }
+            else RPNG_FREE(indexed);
+        }
+    }
+
+    RPNG_LOG("INFO: Image data reduced: %i colors%s, %i channels -> %i channels%s (%i bytes)\n", analysis->color_count, analysis->gray? " (gray)" : "",
+        color_channels, channels, use_key? " + color key" : "", direct_size);
+    RPNG_FREE(analysis);
+
+    if (stats != NULL) *stats = direct_stats;
+    *output_size = (direct != NULL)? direct_size : 0;
+
+    return direct;
+}
+
+// Save 8 bit RGB/RGBA data as grayscale/RGB with or without alpha channel, color key (tRNS) if provided
+// NOTE: Data is converted to required channels if different, gray output uses red channel values,
+// color key chunk is written after provided ancillary chunks (no PLTE chunk on direct color types)
+static char *rpng_save_image_channels(const unsigned char *data, int width, int height, int color_channels, bool gray, int channels, const rpng_color *key, const rpng_chunk *chunks, int chunk_count, int *output_size, rpng_compression_stats *stats)
+{
+    int pixel_count = width*height;
+    char *output = NULL;
+    char *converted = (char *)data;
+    *output_size = 0;
+
+    if (channels != color_channels)
+    {
+        converted = (char *)RPNG_MALLOC(pixel_count*channels);
+
+        for (int i = 0; (converted != NULL) && (i < pixel_count); i++)
+        {
+            const unsigned char *pixel = data + i*color_channels;
+            unsigned char *out = (unsigned char *)converted + i*channels;
+
+            if (gray) out[0] = pixel[0];
+            else { out[0] = pixel[0]; out[1] = pixel[1]; out[2] = pixel[2]; }
+
+            if ((channels == 2) || (channels == 4)) out[channels - 1] = (color_channels == 4)? pixel[3] : 255;
+        }
+    }
+
+    // Chunks list: provided ancillary chunks plus tRNS chunk with color key as 16 bit values (gray or RGB)
+    unsigned char key_data[6] = { 0 };
+    rpng_chunk *key_chunks = NULL;
+
+    if ((converted != NULL) && (key != NULL))
+    {
+        key_chunks = (rpng_chunk *)RPNG_CALLOC(chunk_count + 1, sizeof(rpng_chunk));
+
+        if (key_chunks != NULL)
+        {
+            key_data[1] = key->r; key_data[3] = key->g; key_data[5] = key->b;
+            if (chunk_count > 0) memcpy(key_chunks, chunks, chunk_count*sizeof(rpng_chunk));
+            memcpy(key_chunks[chunk_count].type, "tRNS", 4);
+            key_chunks[chunk_count].length = gray? 2 : 6;
+            key_chunks[chunk_count].data = (char *)key_data;
+        }
+    }
+
+    if ((converted != NULL) && ((key == NULL) || (key_chunks != NULL)))
+    {
+        if (key_chunks != NULL) output = rpng_save_image_chunks_to_memory(converted, width, height, channels, 8, key_chunks, chunk_count + 1, output_size, stats);
+        else output = rpng_save_image_chunks_to_memory(converted, width, height, channels, 8, chunks, chunk_count, output_size, stats);
+    }
+
+    if (converted != (char *)data) RPNG_FREE(converted);
+    RPNG_FREE(key_chunks);
+
+    return output;
+}
+
+// Save indexed png data to memory buffer, ancillary chunks and compression results provided
+// NOTE: Filter type 0 (None) used for indexed data, filter strategies only tried on max/squeeze compression effort,
+// ancillary chunks written after IHDR (before PLTE)
+static char *rpng_save_image_indexed_stats(const char *indexed_data, int width, int height, rpng_palette palette, const rpng_chunk *chunks, int chunk_count, int *output_size, rpng_compression_stats *stats)
 {
     char *output_buffer = NULL;
     int output_buffer_size = 0;
@@ -1461,7 +2194,7 @@ char *rpng_save_image_indexed_to_memory(const char *indexed_data, int width, int
     // Image data pre-processing to append filter type byte to every scanline
     int pixel_size = 1; // 1 byte per pixel (indexed data)
     int comp_data_size = 0;
-    char *comp_data = rpng_deflate_image_data(indexed_data, width*height*pixel_size, width, height, pixel_size, &comp_data_size, 0);
+    char *comp_data = rpng_deflate_image_data(indexed_data, width*height*pixel_size, width, height, pixel_size, &comp_data_size, (rpng_compression_effort_level >= RPNG_COMPRESSION_MAX)? -1 : 0, stats);
 
     // Security check to verify compression worked
     if ((comp_data != NULL) && (comp_data_size > 0))
@@ -1475,6 +2208,7 @@ char *rpng_save_image_indexed_to_memory(const char *indexed_data, int width, int
 
         // Allocate output buffer at required size
         output_buffer = (char *)RPNG_CALLOC(8 + ( 4 + 4 + 13 + 4) +  // Signature + IHDR
+            rpng_get_chunks_size(chunks, chunk_count) +  // Ancillary chunks
             (4 + 4 + palette.color_count*3 + 4) +   // PLTE
             (trns_required? (4 + 4 + palette.color_count + 4) : 0) + // tRNS
             (4 + 4 + comp_data_size + 4) + 12, 1);  // IDAT + IEND
@@ -1493,6 +2227,9 @@ char *rpng_save_image_indexed_to_memory(const char *indexed_data, int width, int
         memcpy(output_buffer + 8 + 8 + 13, &crc, 4);
         output_buffer_size += (8 + 12 + 13);
 
+        // Write ancillary chunks (if provided)
+        output_buffer_size += rpng_write_chunks(output_buffer + output_buffer_size, chunks, chunk_count);
+
         // Write PNG chunk PLTE (palette)
         unsigned int length_PLTE = palette.color_count*3;
         length_PLTE = swap_endian(length_PLTE);
@@ -1563,10 +2300,10 @@ char *rpng_unindex_image_data(char *indexed_data, int width, int height, rpng_pa
 
         for (int i = 0; i < width*height; i++)
         {
-            data[i*4 + 0] = palette.colors[(int)indexed_data[i]].r;
-            data[i*4 + 1] = palette.colors[(int)indexed_data[i]].g;
-            data[i*4 + 2] = palette.colors[(int)indexed_data[i]].b;
-            data[i*4 + 3] = palette.colors[(int)indexed_data[i]].a;
+            data[i*4 + 0] = palette.colors[(unsigned char)indexed_data[i]].r;
+            data[i*4 + 1] = palette.colors[(unsigned char)indexed_data[i]].g;
+            data[i*4 + 2] = palette.colors[(unsigned char)indexed_data[i]].b;
+            data[i*4 + 3] = palette.colors[(unsigned char)indexed_data[i]].a;
         }
 
     }
@@ -1621,29 +2358,12 @@ rpng_chunk rpng_chunk_read_from_memory(const char *buffer, const char *chunk_typ
         // In case chunk(s) requested is IDAT, all IDAT chunks are concatenated
         if (memcmp(chunk_type, "IDAT", 4) == 0)
         {
-            char *idat_data_concat = (char *)RPNG_CALLOC(RPNG_MAX_OUTPUT_SIZE, sizeof(char));
-            int idat_data_concat_size = 0;
-
-            while (memcmp(buffer_ptr + 4, "IEND", 4) != 0) // While IEND chunk not reached
-            {
-                if (memcmp(buffer_ptr + 4, chunk_type, 4) == 0) // Check next IDAT chunk
-                {
-                    memcpy(idat_data_concat + idat_data_concat_size, (char *)(buffer_ptr + 8), chunk_size);
-                    idat_data_concat_size += chunk_size;
-
-                    // TODO: Validate every IDAT chunk CRC32
-                }
-
-                buffer_ptr += (4 + 4 + chunk_size + 4); // Move pointer to next chunk of input data
-                chunk_size = swap_endian(((int *)buffer_ptr)[0]); // Compute next chunk file_size
-            }
-
             // Fill chunk data with all accumulated IDAT
-            chunk.length = idat_data_concat_size;
+            // NOTE: Required size is computed first, data is copied once
+            chunk.length = rpng_concat_image_data(buffer, NULL, NULL);
             memcpy(chunk.type, "IDAT", 4);
-            chunk.data = (char *)RPNG_CALLOC(idat_data_concat_size, sizeof(char));
-            memcpy(chunk.data, idat_data_concat, idat_data_concat_size);
-            RPNG_FREE(idat_data_concat);
+            chunk.data = (char *)RPNG_CALLOC(chunk.length + RPNG_INFLATE_PADDING, sizeof(char));
+            rpng_concat_image_data(buffer, chunk.data, NULL);
 
             // Compute CRC32 for security
             unsigned char *chunk_type_data = (unsigned char *)RPNG_CALLOC(4 + chunk.length, 1);
@@ -1880,6 +2600,69 @@ char *rpng_chunk_write_from_memory(const char *buffer, rpng_chunk chunk, int *ou
     return output_buffer;
 }
 
+// Replace one chunk type in memory buffer: chunks with same type removed, new chunk written after IHDR
+// NOTE: Output buffer allocated once at required size (one pass copy), chunk only removed if length is 0
+char *rpng_chunk_replace_from_memory(const char *buffer, rpng_chunk chunk, int *output_size)
+{
+    char *buffer_ptr = (char *)buffer;
+    char *output_buffer = NULL;
+    int output_buffer_size = 0;
+
+    if ((buffer_ptr != NULL) && (memcmp(buffer_ptr, png_signature, 8) == 0))  // Check valid PNG file
+    {
+        // Get required output size: signature, kept chunks, new chunk and IEND
+        int required_size = 8 + ((chunk.length > 0)? (4 + 4 + chunk.length + 4) : 0) + 12;
+        buffer_ptr += 8;
+
+        unsigned int chunk_size = swap_endian(((int *)buffer_ptr)[0]);
+
+        while (memcmp(buffer_ptr + 4, "IEND", 4) != 0)
+        {
+            if (memcmp(buffer_ptr + 4, chunk.type, 4) != 0) required_size += (4 + 4 + chunk_size + 4);
+
+            buffer_ptr += (4 + 4 + chunk_size + 4);
+            chunk_size = swap_endian(((int *)buffer_ptr)[0]);
+        }
+
+        output_buffer = (char *)RPNG_MALLOC(required_size);
+
+        if (output_buffer != NULL)
+        {
+            memcpy(output_buffer, png_signature, 8);        // Copy PNG signature
+            output_buffer_size += 8;
+            buffer_ptr = (char *)buffer + 8;
+
+            chunk_size = swap_endian(((int *)buffer_ptr)[0]);
+
+            while (memcmp(buffer_ptr + 4, "IEND", 4) != 0) // While IEND chunk not reached
+            {
+                // Chunks with requested type are not copied
+                if (memcmp(buffer_ptr + 4, chunk.type, 4) != 0)
+                {
+                    memcpy(output_buffer + output_buffer_size, buffer_ptr, 4 + 4 + chunk_size + 4);  // Length + FOURCC + chunk_size + CRC32
+                    output_buffer_size += (4 + 4 + chunk_size + 4);
+
+                    // New chunk written after IHDR
+                    if ((memcmp(buffer_ptr + 4, "IHDR", 4) == 0) && (chunk.length > 0))
+                    {
+                        output_buffer_size += rpng_write_chunk(output_buffer + output_buffer_size, chunk.type, chunk.data, chunk.length);
+                    }
+                }
+
+                buffer_ptr += (4 + 4 + chunk_size + 4);   // Move pointer to next chunk
+                chunk_size = swap_endian(((int *)buffer_ptr)[0]);
+            }
+
+            // Write IEND chunk
+            memcpy(output_buffer + output_buffer_size, buffer_ptr, 4 + 4 + 4);
+            output_buffer_size += 12;
+        }
+    }
+
+    *output_size = output_buffer_size;
+    return output_buffer;
+}
+
 // Combine multiple IDAT chunks into a single one
 // NOTE: Returns buffer with all concatenated IDAT chunks
 char *rpng_chunk_combine_image_data_from_memory(char *buffer, int *output_size)
@@ -2029,177 +2812,1475 @@ char *rpng_chunk_split_image_data_from_memory(char *buffer, int split_size, int
 // Module Internal Functions Definition
 //----------------------------------------------------------------------------------
 
-// Prefilter and compress image data
-static char *rpng_deflate_image_data(const char *image_data, int image_data_size, int width, int height, int pixel_size, int *output_size, int forced_filter_type)
+// Compute filter output for one byte using all five filters, accumulating sum of absolute values
+// NOTE: Considering the output bytes as signed differences, filtered output stored if required
+static void rpng_filter_byte(int x, int a, int b, int c, int p, unsigned char **filtered, int *sum_value)
 {
-    char *idat_data = NULL;
+    unsigned char out[5] = {
+        (unsigned char)x,
+        (unsigned char)(x - a),
+        (unsigned char)(x - b),
+        (unsigned char)(x - ((a + b)>>1)),
+        (unsigned char)(x - rpng_paeth_predictor(a, b, c))
+    };
 
-    // Image data pre-processing to append filter type byte to every scanline
-    //int pixel_size = color_channels*(bit_depth/8);
-    int scanline_size = width*pixel_size;
-    unsigned int data_filtered_size = (scanline_size + 1)*height;   // Adding 1 byte per scanline filter
-    unsigned char *data_filtered = (unsigned char *)RPNG_CALLOC(data_filtered_size, 1);
+    for (int filter = 0; filter < 5; filter++)
+    {
+        sum_value[filter] += abs((signed char)out[filter]);
+        if (filtered != NULL) filtered[filter][p] = out[filter];
+    }
+}
 
-    int out = 0, x = 0, a = 0, b = 0, c = 0;
-    int sum_value[5] = { 0 };
-    int best_filter = 0;
+// Compute all five filters for a scanline, accumulating sum of absolute values per filter
+// NOTE: Filtered scanlines are only stored if filtered[5] is provided,
+// prev_scanline must be a zeroed scanline for first row, results match scalar computation
+static void rpng_filter_scanline(const unsigned char *scanline, const unsigned char *prev_scanline, int scanline_size, int pixel_size, unsigned char **filtered, int *sum_value)
+{
+    int p = 0;
 
-    for (int y = 0; y < height; y++)
+    // First pixel bytes have no left pixel (a = c = 0)
+    for (; (p < pixel_size) && (p < scanline_size); p++) rpng_filter_byte(scanline[p], 0, prev_scanline[p], 0, p, filtered, sum_value);
+
+#if defined(RPNG_SIMD_AVX2) || defined(RPNG_SIMD_SSE2)
+    // x = current bytes, a = left pixel bytes, b = above pixel bytes, c = left pixel bytes (from b)
+    // NOTE: Filters operate on unfiltered data, so all bytes can be loaded directly with a pixel_size offset
+    const rpng_simd zero = rpng_simd_zero();
+    const rpng_simd one = rpng_simd_set1_u8(1);
+    rpng_simd sum[5] = { zero, zero, zero, zero, zero };
+
+    for (; (p + RPNG_SIMD_SIZE) <= scanline_size; p += RPNG_SIMD_SIZE)
     {
-        if (forced_filter_type == -1)
+        rpng_simd x = rpng_simd_load(scanline + p);
+        rpng_simd a = rpng_simd_load(scanline + p - pixel_size);
+        rpng_simd b = rpng_simd_load(prev_scanline + p);
+        rpng_simd c = rpng_simd_load(prev_scanline + p - pixel_size);
+
+        // Average: floor((a + b)/2), avg instruction rounds up
+        rpng_simd avg = rpng_simd_sub_u8(rpng_simd_avg_u8(a, b), rpng_simd_and(rpng_simd_xor(a, b), one));
+
+        // Paeth: pa = |b - c|, pb = |a - c|, pc = |a + b - 2c| (computed in 16 bit, saturated to 8 bit)
+        rpng_simd pa = rpng_simd_or(rpng_simd_subs_u8(b, c), rpng_simd_subs_u8(c, b));
+        rpng_simd pb = rpng_simd_or(rpng_simd_subs_u8(a, c), rpng_simd_subs_u8(c, a));
+        rpng_simd pc_lo = rpng_simd_add_i16(rpng_simd_sub_i16(rpng_simd_unpacklo_u8(a, zero), rpng_simd_unpacklo_u8(c, zero)),
+                                            rpng_simd_sub_i16(rpng_simd_unpacklo_u8(b, zero), rpng_simd_unpacklo_u8(c, zero)));
+        rpng_simd pc_hi = rpng_simd_add_i16(rpng_simd_sub_i16(rpng_simd_unpackhi_u8(a, zero), rpng_simd_unpackhi_u8(c, zero)),
+                                            rpng_simd_sub_i16(rpng_simd_unpackhi_u8(b, zero), rpng_simd_unpackhi_u8(c, zero)));
+        pc_lo = rpng_simd_max_i16(pc_lo, rpng_simd_sub_i16(zero, pc_lo));
+        pc_hi = rpng_simd_max_i16(pc_hi, rpng_simd_sub_i16(zero, pc_hi));
+        rpng_simd pc = rpng_simd_packus_i16(pc_lo, pc_hi);
+
+        // Predictor selection: a if (pa <= pb) && (pa <= pc), else b if (pb <= pc), else c
+        rpng_simd select_a = rpng_simd_and(rpng_simd_cmpeq_u8(rpng_simd_min_u8(pa, pb), pa), rpng_simd_cmpeq_u8(rpng_simd_min_u8(pa, pc), pa));
+        rpng_simd select_b = rpng_simd_cmpeq_u8(rpng_simd_min_u8(pb, pc), pb);
+        rpng_simd paeth = rpng_simd_or(rpng_simd_and(select_b, b), rpng_simd_andnot(select_b, c));
+        paeth = rpng_simd_or(rpng_simd_and(select_a, a), rpng_simd_andnot(select_a, paeth));
+
+        rpng_simd out[5] = {
+            x,
+            rpng_simd_sub_u8(x, a),
+            rpng_simd_sub_u8(x, b),
+            rpng_simd_sub_u8(x, avg),
+            rpng_simd_sub_u8(x, paeth)
+        };
+
+        for (int filter = 0; filter < 5; filter++)
         {
-            // Choose the best filter type for every scanline
-            // REF: https://www.w3.org/TR/PNG-Encoders.html#E.Filter-selection
-            for (int p = 0; p < scanline_size; p++)
-            {
-                // x = current byte
-                // a = left pixel byte (from current)
-                // b = above pixel byte (from current)
-                // c = left pixel byte (from b)
-                x = (int)((unsigned char *)image_data)[scanline_size*y + p];
-                a = (p >= pixel_size) ? (int)((unsigned char *)image_data)[scanline_size*y + p - pixel_size] : 0;
-                b = (y > 0) ? (int)((unsigned char *)image_data)[scanline_size*(y - 1) + p] : 0;
-                c = (y > 0) ? ((p >= pixel_size) ? (int)((unsigned char *)image_data)[scanline_size*(y - 1) + p - pixel_size] : 0) : 0;
-
-                // Heuristic: Compute the output scanline using all five filters
-                // REF: https://www.w3.org/TR/PNG/#9Filters
-                for (int filter = 0; filter < 5; filter++)
-                {
-                    switch (filter)
-                    {
-                        case 0: out = x; break;
-                        case 1: out = x - a; break;
-                        case 2: out = x - b; break;
-                        case 3: out = x - ((a + b)>>1); break;
-                        case 4: out = x - rpng_paeth_predictor(a, b, c); break;
-                        default: break;
-                    }
+            // Absolute value of signed bytes: min(out, -out) as unsigned
+            rpng_simd abs_out = rpng_simd_min_u8(out[filter], rpng_simd_sub_u8(zero, out[filter]));
+            sum[filter] = rpng_simd_add_u64(sum[filter], rpng_simd_sad_u8(abs_out, zero));
 
-                    sum_value[filter] += abs((signed char)out);
-                }
-            }
+            if (filtered != NULL) rpng_simd_store(filtered[filter] + p, out[filter]);
+        }
+    }
 
-            // Select the filter that gives the smallest sum of absolute values of outputs.
+    for (int filter = 0; filter < 5; filter++)
+    {
+        unsigned long long lanes[RPNG_SIMD_SIZE/8] = { 0 };
+        rpng_simd_store(lanes, sum[filter]);
+
+        for (int i = 0; i < RPNG_SIMD_SIZE/8; i++) sum_value[filter] += (int)lanes[i];
+    }
+#elif defined(RPNG_SIMD_NEON)
+    uint32x4_t sum[5] = { vdupq_n_u32(0), vdupq_n_u32(0), vdupq_n_u32(0), vdupq_n_u32(0), vdupq_n_u32(0) };
+
+    for (; (p + 16) <= scanline_size; p += 16)
+    {
+        uint8x16_t x = vld1q_u8(scanline + p);
+        uint8x16_t a = vld1q_u8(scanline + p - pixel_size);
+        uint8x16_t b = vld1q_u8(prev_scanline + p);
+        uint8x16_t c = vld1q_u8(prev_scanline + p - pixel_size);
+
+        // Paeth: pa = |b - c|, pb = |a - c|, pc = |a + b - 2c| (computed in 16 bit, saturated to 8 bit)
+        uint8x16_t pa = vabdq_u8(b, c);
+        uint8x16_t pb = vabdq_u8(a, c);
+        int16x8_t pc_lo = vabsq_s16(vaddq_s16(vreinterpretq_s16_u16(vsubl_u8(vget_low_u8(a), vget_low_u8(c))),
+                                              vreinterpretq_s16_u16(vsubl_u8(vget_low_u8(b), vget_low_u8(c)))));
+        int16x8_t pc_hi = vabsq_s16(vaddq_s16(vreinterpretq_s16_u16(vsubl_u8(vget_high_u8(a), vget_high_u8(c))),
+                                              vreinterpretq_s16_u16(vsubl_u8(vget_high_u8(b), vget_high_u8(c)))));
+        uint8x16_t pc = vcombine_u8(vqmovun_s16(pc_lo), vqmovun_s16(pc_hi));
+
+        // Predictor selection: a if (pa <= pb) && (pa <= pc), else b if (pb <= pc), else c
+        uint8x16_t select_a = vandq_u8(vcleq_u8(pa, pb), vcleq_u8(pa, pc));
+        uint8x16_t select_b = vcleq_u8(pb, pc);
+        uint8x16_t paeth = vbslq_u8(select_a, a, vbslq_u8(select_b, b, c));
+
+        uint8x16_t out[5] = {
+            x,
+            vsubq_u8(x, a),
+            vsubq_u8(x, b),
+            vsubq_u8(x, vhaddq_u8(a, b)),
+            vsubq_u8(x, paeth)
+        };
+
+        for (int filter = 0; filter < 5; filter++)
+        {
+            // Absolute value of signed bytes (-128 wraps to 128 as unsigned)
+            uint8x16_t abs_out = vreinterpretq_u8_s8(vabsq_s8(vreinterpretq_s8_u8(out[filter])));
+            sum[filter] = vpadalq_u16(sum[filter], vpaddlq_u8(abs_out));
+
+            if (filtered != NULL) vst1q_u8(filtered[filter] + p, out[filter]);
+        }
+    }
+
+    for (int filter = 0; filter < 5; filter++)
+    {
+        sum_value[filter] += (int)(vgetq_lane_u32(sum[filter], 0) + vgetq_lane_u32(sum[filter], 1) +
+                                   vgetq_lane_u32(sum[filter], 2) + vgetq_lane_u32(sum[filter], 3));
+    }
+#endif
+
+    // Remaining bytes (full scanline if SIMD not available)
+    for (; p < scanline_size; p++) rpng_filter_byte(scanline[p], scanline[p - pixel_size], prev_scanline[p], prev_scanline[p - pixel_size], p, filtered, sum_value);
+}
+
+// Compute one filter (1-4) for a scanline, output same as rpng_filter_scanline() for that filter
+// NOTE: Used for fixed filter strategies, simple loops left to compiler auto-vectorization
+static void rpng_filter_scanline_single(const unsigned char *scanline, const unsigned char *prev_scanline, int scanline_size, int pixel_size, int filter, unsigned char *filtered)
+{
+    int p = 0;
+
+    switch (filter)
+    {
+        case 1:     // Sub
+        {
+            for (; p < pixel_size; p++) filtered[p] = scanline[p];
+            for (; p < scanline_size; p++) filtered[p] = scanline[p] - scanline[p - pixel_size];
+        } break;
+        case 2:     // Up
+        {
+            for (; p < scanline_size; p++) filtered[p] = scanline[p] - prev_scanline[p];
+        } break;
+        case 3:     // Average
+        {
+            for (; p < pixel_size; p++) filtered[p] = scanline[p] - (prev_scanline[p] >> 1);
+            for (; p < scanline_size; p++) filtered[p] = scanline[p] - ((scanline[p - pixel_size] + prev_scanline[p]) >> 1);
+        } break;
+        case 4:     // Paeth
+        {
+            for (; p < pixel_size; p++) filtered[p] = scanline[p] - rpng_paeth_predictor(0, prev_scanline[p], 0);
+            for (; p < scanline_size; p++) filtered[p] = scanline[p] - rpng_paeth_predictor(scanline[p - pixel_size], prev_scanline[p], prev_scanline[p - pixel_size]);
+        } break;
+        default: memcpy(filtered, scanline, scanline_size); break;
+    }
+}
+
+// Analyze image data for color type reduction (8 bit RGB/RGBA)
+// NOTE: Unique colors are registered in a hash table while 256 or less colors found,
+// color key requires a second pass to verify opaque pixels do not use the key color
+static void rpng_analyze_image_data(const unsigned char *data, int pixel_count, int color_channels, rpng_image_analysis *analysis)
+{
+    analysis->opaque = true;
+    analysis->gray = true;
+    analysis->binary_alpha = true;
+    analysis->color_key = true;
+    analysis->key = (rpng_color){ 0 };
+    analysis->color_count = 0;
+    for (int i = 0; i < RPNG_ANALYSIS_HASH_SIZE; i++) analysis->hash_index[i] = -1;
+
+    bool key_found = false;
+    unsigned int prev_color = 0;
+
+    for (int i = 0; i < pixel_count; i++)
+    {
+        const unsigned char *pixel = data + i*color_channels;
+        unsigned char alpha = (color_channels == 4)? pixel[3] : 255;
+        unsigned int color = pixel[0] | (pixel[1] << 8) | (pixel[2] << 16) | ((unsigned int)alpha << 24);
+
+        if ((pixel[0] != pixel[1]) || (pixel[0] != pixel[2])) analysis->gray = false;
+
+        if (alpha != 255)
+        {
+            analysis->opaque = false;
+
+            if (alpha != 0) analysis->binary_alpha = false;
+            else if (!key_found)
+            {
+                analysis->key = (rpng_color){ pixel[0], pixel[1], pixel[2], 0 };
+                key_found = true;
+            }
+            else if ((analysis->key.r != pixel[0]) || (analysis->key.g != pixel[1]) || (analysis->key.b != pixel[2])) analysis->color_key = false;
+        }
+
+        // NOTE: Consecutive pixels with same color are common, hash lookup skipped
+        if ((analysis->color_count <= 256) && ((i == 0) || (color != prev_color))) rpng_analysis_color_index(analysis, color, true);
+        prev_color = color;
+    }
+
+    analysis->color_key = analysis->color_key && analysis->binary_alpha && key_found;
+
+    // Verify color key is not used by opaque pixels
+    for (int i = 0; analysis->color_key && (i < pixel_count); i++)
+    {
+        const unsigned char *pixel = data + i*color_channels;
+
+        if ((pixel[3] == 255) && (pixel[0] == analysis->key.r) && (pixel[1] == analysis->key.g) && (pixel[2] == analysis->key.b)) analysis->color_key = false;
+    }
+}
+
+// Get palette index for color, -1 if not found
+// NOTE: Color is registered if requested and palette not full, color_count set to 257 on palette overflow
+static int rpng_analysis_color_index(rpng_image_analysis *analysis, unsigned int color, bool insert)
+{
+    unsigned int slot = ((color*2654435761u) >> 22) & (RPNG_ANALYSIS_HASH_SIZE - 1);
+
+    while (analysis->hash_index[slot] != -1)
+    {
+        if (analysis->hash_colors[slot] == color) return analysis->hash_index[slot];
+        slot = (slot + 1) & (RPNG_ANALYSIS_HASH_SIZE - 1);
+    }
+
+    if (!insert) return -1;
+
+    if (analysis->color_count >= 256)
+    {
+        analysis->color_count = 257;
+        return -1;
+    }
+
+    int index = analysis->color_count;
+    analysis->hash_colors[slot] = color;
+    analysis->hash_index[slot] = (short)index;
+    analysis->palette[index] = (rpng_color){ color & 0xff, (color >> 8) & 0xff, (color >> 16) & 0xff, color >> 24 };
+    analysis->color_count++;
+
+    return index;
+}
+
+// Prefilter and compress image data
+// NOTE: Filter strategy and deflate level depend on compression effort, forced filter type (>= 0) is always used
+static char *rpng_deflate_image_data(const char *image_data, int image_data_size, int width, int height, int pixel_size, int *output_size, int forced_filter_type, rpng_compression_stats *stats)
+{
+    char *idat_data = NULL;
+    int effort = rpng_compression_effort_level;
+    rpng_compression_stats result = { 0 };
+
+    if ((effort == RPNG_COMPRESSION_SQUEEZE) && (forced_filter_type < 0))
+    {
+        idat_data = rpng_squeeze_image_data((const unsigned char *)image_data, width, height, pixel_size, output_size, &result);
+        if (stats != NULL) *stats = result;
+
+        return idat_data;
+    }
+    else if (effort == RPNG_COMPRESSION_SQUEEZE) effort = RPNG_COMPRESSION_MAX;
+
+    // Image data pre-processing to append filter type byte to every scanline
+    //int pixel_size = color_channels*(bit_depth/8);
+    int scanline_size = width*pixel_size;
+    unsigned int data_filtered_size = (scanline_size + 1)*height;   // Adding 1 byte per scanline filter
+    unsigned char *data_filtered = (unsigned char *)RPNG_CALLOC(data_filtered_size, 1);
+
+    // Scratch buffer: five filtered candidate scanlines + zeroed scanline (previous scanline for first row)
+    // NOTE: Selected filter scanline is directly copied to output, no need to filter it again
+    unsigned char *scratch = (unsigned char *)RPNG_CALLOC(scanline_size*6, 1);
+
+    int filter_type = forced_filter_type;
+    if (filter_type < 0)
+    {
+        if (effort == RPNG_COMPRESSION_STORE) filter_type = 0;
+        else if (effort == RPNG_COMPRESSION_FAST) filter_type = 1;
+    }
+
+    char *comp_data = NULL;
+    int comp_data_size = 0;
+
+    if (effort == RPNG_COMPRESSION_STORE)
+    {
+        rpng_filter_image_data((const unsigned char *)image_data, width, height, pixel_size, filter_type, data_filtered, scratch);
+        comp_data = rpng_store_image_data(data_filtered, data_filtered_size, &comp_data_size);
+        result.filter = filter_type;
+        result.level = -1;
+    }
+    else if ((effort == RPNG_COMPRESSION_MAX) && (forced_filter_type < 0))
+    {
+        // Try all filter strategies (adaptive, fixed 0-4), keep the smallest compressed data
+        for (int strategy = -1; strategy < 5; strategy++)
+        {
+            int candidate_size = 0;
+            rpng_filter_image_data((const unsigned char *)image_data, width, height, pixel_size, strategy, data_filtered, scratch);
+            char *candidate = rpng_compress_image_data(data_filtered, data_filtered_size, scanline_size, height, SDEFL_LVL_MAX, &candidate_size);
+
+            if ((candidate != NULL) && (candidate_size > 0) && ((comp_data == NULL) || (candidate_size < comp_data_size)))
+            {
+                RPNG_FREE(comp_data);
+                comp_data = candidate;
+                comp_data_size = candidate_size;
+                result.filter = strategy;
+            }
+            else RPNG_FREE(candidate);
+        }
+
+        result.level = SDEFL_LVL_MAX;
+    }
+    else
+    {
+        int level = (effort == RPNG_COMPRESSION_FAST)? RPNG_COMPRESSION_LEVEL_FAST : (effort == RPNG_COMPRESSION_MAX)? SDEFL_LVL_MAX : RPNG_COMPRESSION_LEVEL;
+
+        rpng_filter_image_data((const unsigned char *)image_data, width, height, pixel_size, filter_type, data_filtered, scratch);
+        comp_data = rpng_compress_image_data(data_filtered, data_filtered_size, scanline_size, height, level, &comp_data_size);
+        result.filter = filter_type;
+        result.level = level;
+    }
+
+    RPNG_FREE(scratch);
+    RPNG_FREE(data_filtered);
+
+    if ((comp_data != NULL) && (comp_data_size > 0))
+    {
+        idat_data = comp_data;
+        *output_size = comp_data_size;
+        result.size = comp_data_size;
+        RPNG_LOG("INFO: Image data deflated successfully: %i bytes -> %i bytes\n", data_filtered_size, comp_data_size);
+    }
+    else
+    {
+        RPNG_FREE(comp_data);
+        RPNG_LOG("INFO: Image data deflating failed\n");
+    }
+
+    if (stats != NULL) *stats = result;
+
+    return idat_data;
+}
+
+// Filter image data scanlines, filter type -1 for adaptive filter selection per scanline
+// NOTE: Scratch buffer must be scanline_size*6 bytes: five filtered candidate scanlines + zeroed scanline
+static void rpng_filter_image_data(const unsigned char *image_data, int width, int height, int pixel_size, int filter_type, unsigned char *data_filtered, unsigned char *scratch)
+{
+    int scanline_size = width*pixel_size;
+    unsigned char *filtered[5] = { scratch, scratch + scanline_size, scratch + scanline_size*2, scratch + scanline_size*3, scratch + scanline_size*4 };
+    const unsigned char *zero_scanline = scratch + scanline_size*5;
+
+    for (int y = 0; y < height; y++)
+    {
+        const unsigned char *scanline = image_data + scanline_size*y;
+        const unsigned char *prev_scanline = (y > 0)? scanline - scanline_size : zero_scanline;
+        unsigned char *output = data_filtered + (scanline_size + 1)*y;
+
+        if ((filter_type >= 0) && (filter_type <= 4))
+        {
+            // Fixed filter type, only required filter is computed
+            // NOTE: Filter type 0 (None) output is the scanline itself
+            output[0] = filter_type;
+            if (filter_type == 0) memcpy(output + 1, scanline, scanline_size);
+            else rpng_filter_scanline_single(scanline, prev_scanline, scanline_size, pixel_size, filter_type, output + 1);
+        }
+        else
+        {
+            // Choose the best filter type for every scanline
+            // REF: https://www.w3.org/TR/PNG-Encoders.html#E.Filter-selection
+            // Heuristic: Compute the output scanline using all five filters (SIMD if available)
+            // REF: https://www.w3.org/TR/PNG/#9Filters
+            int sum_value[5] = { 0 };
+            rpng_filter_scanline(scanline, prev_scanline, scanline_size, pixel_size, filtered, sum_value);
+
+            // Select the filter that gives the smallest sum of absolute values of outputs.
             // NOTE: Considering the output bytes as signed differences for the test.
-            best_filter = 0;
+            int best_filter = 0;
             int best_value = sum_value[0];
 
-            for (int filter = 1; filter < 5; filter++)
+            for (int filter = 1; filter < 5; filter++)
+            {
+                if (sum_value[filter] < best_value)
+                {
+                    best_value = sum_value[filter];
+                    best_filter = filter;
+                }
+            }
+
+            // Register scanline filter byte and filtered scanline
+            // NOTE: Filter type 0 (None) output is the scanline itself
+            output[0] = best_filter;
+            memcpy(output + 1, (best_filter == 0)? scanline : filtered[best_filter], scanline_size);
+        }
+    }
+}
+
+// Filter image data scanlines, filter type for every scanline selected by compressed size (brute force)
+// NOTE: Every filtered candidate scanline is compressed after previous filtered data (RPNG_BRUTE_FORCE_WINDOW
+// used as dictionary) and the one with smallest compressed size is kept, much slower than adaptive filter
+static void rpng_filter_image_data_brute(const unsigned char *image_data, int width, int height, int pixel_size, unsigned char *data_filtered, unsigned char *scratch)
+{
+    int scanline_size = width*pixel_size;
+    unsigned char *filtered[5] = { scratch, scratch + scanline_size, scratch + scanline_size*2, scratch + scanline_size*3, scratch + scanline_size*4 };
+    const unsigned char *zero_scanline = scratch + scanline_size*5;
+
+    struct sdefl *sde = (struct sdefl *)RPNG_CALLOC(sizeof(struct sdefl), 1);
+    unsigned char *trial = (unsigned char *)RPNG_MALLOC(sdefl_bound(scanline_size + 1) + 5*(scanline_size/SDEFL_BLK_MAX + 1));
+
+    if ((sde == NULL) || (trial == NULL))
+    {
+        // Fallback to adaptive filter selection
+        rpng_filter_image_data(image_data, width, height, pixel_size, -1, data_filtered, scratch);
+        height = 0;
+    }
+
+    for (int y = 0; y < height; y++)
+    {
+        const unsigned char *scanline = image_data + scanline_size*y;
+        const unsigned char *prev_scanline = (y > 0)? scanline - scanline_size : zero_scanline;
+        unsigned char *output = data_filtered + (scanline_size + 1)*y;
+        int begin = (scanline_size + 1)*y;
+        int dictionary = (begin > RPNG_BRUTE_FORCE_WINDOW)? (begin - RPNG_BRUTE_FORCE_WINDOW) : 0;
+
+        int sum_value[5] = { 0 };
+        rpng_filter_scanline(scanline, prev_scanline, scanline_size, pixel_size, filtered, sum_value);
+
+        int best_filter = 0;
+        int best_size = 0;
+
+        for (int filter = 0; filter < 5; filter++)
+        {
+            output[0] = filter;
+            memcpy(output + 1, (filter == 0)? scanline : filtered[filter], scanline_size);
+
+            // NOTE: Fast deflate level used for size measurement, last block flag avoids alignment data
+            sde->bits = sde->bitcnt = 0;
+            int size = sdefl_compr_range(sde, trial, data_filtered, dictionary, begin, begin + scanline_size + 1, 4, 1);
+
+            if ((filter == 0) || (size < best_size))
+            {
+                best_size = size;
+                best_filter = filter;
+            }
+        }
+
+        output[0] = best_filter;
+        memcpy(output + 1, (best_filter == 0)? scanline : filtered[best_filter], scanline_size);
+    }
+
+    RPNG_FREE(trial);
+    RPNG_FREE(sde);
+}
+
+// Compress image data trying all filter strategies and several deflate levels, smallest kept (squeeze)
+// NOTE: Candidates are compressed in parallel if jobs runner available, default effort candidate
+// (adaptive filter, RPNG_COMPRESSION_LEVEL) is always included to report savings
+// WARNING: In case runner can not process candidates in parallel (i.e. called from a runner job), all candidates
+// are compressed serially, up to 22 times default compression time, big images should be squeezed from top-level caller
+static char *rpng_squeeze_image_data(const unsigned char *image_data, int width, int height, int pixel_size, int *output_size, rpng_compression_stats *stats)
+{
+    static const int levels[3] = { 6, 7, 8 };
+    const int strategy_count = 7;       // Brute force, adaptive, fixed 0-4
+    const int level_count = 3;
+
+    int scanline_size = width*pixel_size;
+    int data_filtered_size = (scanline_size + 1)*height;
+    unsigned char *data_filtered = (unsigned char *)RPNG_CALLOC((size_t)data_filtered_size*strategy_count, 1);
+    unsigned char *scratch = (unsigned char *)RPNG_CALLOC(scanline_size*6, 1);
+    rpng_deflate_candidate *candidates = (rpng_deflate_candidate *)RPNG_CALLOC(strategy_count*level_count + 1, sizeof(rpng_deflate_candidate));
+    char *comp_data = NULL;
+    *output_size = 0;
+
+    if ((data_filtered != NULL) && (scratch != NULL) && (candidates != NULL))
+    {
+        int candidate_count = 0;
+
+        for (int strategy = 0; strategy < strategy_count; strategy++)
+        {
+            unsigned char *strategy_data = data_filtered + (size_t)data_filtered_size*strategy;
+
+            if (strategy == 0) rpng_filter_image_data_brute(image_data, width, height, pixel_size, strategy_data, scratch);
+            else rpng_filter_image_data(image_data, width, height, pixel_size, strategy - 2, strategy_data, scratch);
+
+            for (int l = 0; l < level_count; l++)
+            {
+                candidates[candidate_count].data = strategy_data;
+                candidates[candidate_count].size = data_filtered_size;
+                candidates[candidate_count].filter = strategy - 2;
+                candidates[candidate_count].level = levels[l];
+                candidate_count++;
+            }
+
+            // Default effort candidate, only if level not already included
+            if ((strategy == 1) && (RPNG_COMPRESSION_LEVEL != levels[0]) && (RPNG_COMPRESSION_LEVEL != levels[1]) && (RPNG_COMPRESSION_LEVEL != levels[2]))
+            {
+                candidates[candidate_count].data = strategy_data;
+                candidates[candidate_count].size = data_filtered_size;
+                candidates[candidate_count].filter = -1;
+                candidates[candidate_count].level = RPNG_COMPRESSION_LEVEL;
+                candidate_count++;
+            }
+        }
+
+        bool parallel = (rpng_deflate_runner != NULL) && rpng_deflate_runner(rpng_deflate_candidate_job, candidates, sizeof(rpng_deflate_candidate), candidate_count);
+        if (!parallel) for (int i = 0; i < candidate_count; i++) rpng_deflate_candidate_job(&candidates[i]);
+
+        int best = -1;
+        for (int i = 0; i < candidate_count; i++)
+        {
+            if (candidates[i].output_size <= 0) continue;
+
+            if ((best == -1) || (candidates[i].output_size < candidates[best].output_size)) best = i;
+            if ((candidates[i].filter == -1) && (candidates[i].level == RPNG_COMPRESSION_LEVEL)) stats->default_size = candidates[i].output_size;
+        }
+
+        if (best >= 0)
+        {
+            comp_data = candidates[best].output;
+            candidates[best].output = NULL;
+            *output_size = candidates[best].output_size;
+
+            stats->size = candidates[best].output_size;
+            stats->filter = candidates[best].filter;
+            stats->level = candidates[best].level;
+
+            RPNG_LOG("INFO: Image data squeezed: %i bytes (default: %i bytes), filter strategy: %i, level: %i\n", stats->size, stats->default_size, stats->filter, stats->level);
+        }
+
+        for (int i = 0; i < candidate_count; i++) RPNG_FREE(candidates[i].output);
+    }
+
+    RPNG_FREE(candidates);
+    RPNG_FREE(scratch);
+    RPNG_FREE(data_filtered);
+
+    return comp_data;
+}
+
+// Compress one candidate (job function)
+// NOTE: Candidates are compressed as a single stream, jobs already run in parallel
+static void rpng_deflate_candidate_job(void *job_data)
+{
+    rpng_deflate_candidate *candidate = (rpng_deflate_candidate *)job_data;
+
+    struct sdefl *sde = (struct sdefl *)RPNG_CALLOC(sizeof(struct sdefl), 1);
+    candidate->output = (char *)RPNG_MALLOC(sdefl_bound(candidate->size) + 5*(candidate->size/SDEFL_BLK_MAX + 1));
+
+    if ((sde != NULL) && (candidate->output != NULL))
+    {
+        candidate->output_size = zsdeflate(sde, candidate->output, candidate->data, candidate->size, candidate->level);
+    }
+
+    RPNG_FREE(sde);
+}
+
+// Compress filtered image data into a zlib stream
+// NOTE: Big images are compressed in stripes if multiple threads available, single stream otherwise
+static char *rpng_compress_image_data(const unsigned char *data_filtered, int data_filtered_size, int scanline_size, int height, int level, int *output_size)
+{
+    char *comp_data = NULL;
+    *output_size = 0;
+
+    int stripe_count = (int)(data_filtered_size/RPNG_DEFLATE_STRIPE_MIN_SIZE);
+    if (stripe_count > rpng_deflate_thread_count) stripe_count = rpng_deflate_thread_count;
+    if (stripe_count > height) stripe_count = height;
+
+    if ((stripe_count > 1) && (rpng_deflate_runner != NULL))
+    {
+        comp_data = rpng_deflate_stripes(data_filtered, data_filtered_size, scanline_size, height, stripe_count, level, output_size);
+    }
+
+    // Stripes not compressed in parallel (runner busy), single stream used instead
+    if (comp_data == NULL)
+    {
+        struct sdefl *sde = (struct sdefl*)RPNG_CALLOC(sizeof(struct sdefl), 1);
+        int bounds = sdefl_bound(data_filtered_size);
+        comp_data = (char *)RPNG_CALLOC(bounds, 1);
+        *output_size = zsdeflate(sde, comp_data, data_filtered, data_filtered_size, level);
+        RPNG_FREE(sde);
+    }
+
+    return comp_data;
+}
+
+// Store image data into a zlib stream (stored deflate blocks, no compression)
+static char *rpng_store_image_data(const unsigned char *data_filtered, int data_filtered_size, int *output_size)
+{
+    const int block_size = 65535;     // Maximum stored block size
+    int block_count = (data_filtered_size + block_size - 1)/block_size;
+    if (block_count == 0) block_count = 1;
+
+    int comp_data_size = 2 + block_count*5 + data_filtered_size + 4;
+    unsigned char *comp_data = (unsigned char *)RPNG_MALLOC(comp_data_size);
+    *output_size = 0;
+
+    if (comp_data != NULL)
+    {
+        unsigned char *ptr = comp_data;
+        unsigned int adler = update_adler32(1, data_filtered, data_filtered_size);
+
+        *ptr++ = 0x78;      // Deflate, 32 KB window
+        *ptr++ = 0x01;      // Fast compression
+
+        for (int i = 0, offset = 0; i < block_count; i++)
+        {
+            int size = ((data_filtered_size - offset) < block_size)? (data_filtered_size - offset) : block_size;
+
+            *ptr++ = (i == (block_count - 1))? 1 : 0;   // Final block flag, stored block type (0)
+            *ptr++ = (unsigned char)(size & 0xff);
+            *ptr++ = (unsigned char)(size >> 8);
+            *ptr++ = (unsigned char)(~size & 0xff);
+            *ptr++ = (unsigned char)((~size >> 8) & 0xff);
+            memcpy(ptr, data_filtered + offset, size);
+
+            ptr += size;
+            offset += size;
+        }
+
+        *ptr++ = (unsigned char)(adler >> 24);
+        *ptr++ = (unsigned char)(adler >> 16);
+        *ptr++ = (unsigned char)(adler >> 8);
+        *ptr++ = (unsigned char)adler;
+
+        *output_size = comp_data_size;
+    }
+
+    return (char *)comp_data;
+}
+
+// Decompress and unfilter image data (IDAT)
+// NOTE: Output buffer is sized from image dimensions (one filter type byte per scanline) and scanlines
+// are unfiltered in place, every scanline is moved to its final position (filter byte removed) while
+// unfiltered, final position is always before filtered data not processed yet
+static char *rpng_inflate_image_data(char *image_data, int image_data_size, int width, int height, int pixel_size)
+{
+    if ((width <= 0) || (height <= 0) || (pixel_size <= 0) || (((long long)width*pixel_size + 1)*height > 0x7fffffff)) return NULL;
+
+    int scanline_size = width*pixel_size;
+    int image_data_filtered_size = (1 + scanline_size)*height;
+
+    unsigned char *image_data_unfiltered = (unsigned char *)RPNG_MALLOC(image_data_filtered_size);
+
+    if (image_data_unfiltered == NULL) return NULL;
+
+    // Decompress IDAT chunk data
+    int image_data_decomp_size = zsinflate(image_data_unfiltered, image_data_filtered_size, image_data, image_data_size);
+
+    RPNG_LOG("INFO: IDAT data decompressed: %i -> %i\n", image_data_size, image_data_decomp_size);
+
+    bool valid = (image_data_decomp_size == image_data_filtered_size);
+
+    // Now we have the data decompressed but every scanline of the image was originally filtered for
+    // maximum compression and one extra byte with the filter type was added to every scanline
+    // We must undo that image prefiltering for every scanline
+    for (int y = 0; (y < height) && valid; y++)
+    {
+        const unsigned char *filtered = image_data_unfiltered + (1 + scanline_size)*y + 1;
+        unsigned char *scanline = image_data_unfiltered + scanline_size*y;
+        const unsigned char *prev_scanline = (y > 0)? (scanline - scanline_size) : NULL;
+        int current_filter = filtered[-1];
+
+        valid = rpng_unfilter_scanline(scanline, filtered, prev_scanline, scanline_size, pixel_size, current_filter);
+    }
+
+    if (!valid)
+    {
+        RPNG_FREE(image_data_unfiltered);
+        return NULL;
+    }
+
+    // Resize output buffer to unfiltered data size (filter type bytes removed)
+    unsigned char *image_data_sized = (unsigned char *)RPNG_REALLOC(image_data_unfiltered, scanline_size*height);
+    if (image_data_sized != NULL) image_data_unfiltered = image_data_sized;
+
+    return (char *)image_data_unfiltered;
+}
+
+// Compress filtered image data in stripes using jobs runner (multithreaded), returns zlib stream
+// NOTE: Stripes are split on scanlines boundaries, every stripe is a raw deflate stream ended
+// byte aligned (last byte as stored block) so all stripes can be directly concatenated,
+// NULL is returned if runner can not process stripes in parallel (serial stripes only add overhead)
+static char *rpng_deflate_stripes(const unsigned char *data_filtered, int data_filtered_size, int scanline_size, int height, int stripe_count, int level, int *output_size)
+{
+    char *comp_data = NULL;
+    *output_size = 0;
+
+    rpng_deflate_stripe *stripes = (rpng_deflate_stripe *)RPNG_CALLOC(stripe_count, sizeof(rpng_deflate_stripe));
+    if (stripes == NULL) return NULL;
+
+    for (int i = 0; i < stripe_count; i++)
+    {
+        stripes[i].data = data_filtered;
+        stripes[i].begin = (int)((long long)i*height/stripe_count)*(scanline_size + 1);
+        stripes[i].end = (i == (stripe_count - 1))? data_filtered_size : (int)((long long)(i + 1)*height/stripe_count)*(scanline_size + 1);
+        stripes[i].last = (i == (stripe_count - 1));
+        stripes[i].level = level;
+    }
+
+    // Join stripes: zlib header + stripes + Adler-32 (big-endian)
+    int comp_data_size = 2 + 4;
+    bool valid = rpng_deflate_runner(rpng_deflate_stripe_job, stripes, sizeof(rpng_deflate_stripe), stripe_count);
+
+    for (int i = 0; i < stripe_count; i++)
+    {
+        if (stripes[i].output_size <= 0) valid = false;
+        comp_data_size += stripes[i].output_size;
+    }
+
+    if (valid) comp_data = (char *)RPNG_MALLOC(comp_data_size);
+
+    if (comp_data != NULL)
+    {
+        unsigned char *ptr = (unsigned char *)comp_data;
+        unsigned int adler = stripes[0].adler;
+
+        *ptr++ = 0x78;      // Deflate, 32 KB window
+        *ptr++ = 0x01;      // Fast compression
+
+        for (int i = 0; i < stripe_count; i++)
+        {
+            memcpy(ptr, stripes[i].output, stripes[i].output_size);
+            ptr += stripes[i].output_size;
+
+            if (i > 0) adler = combine_adler32(adler, stripes[i].adler, stripes[i].end - stripes[i].begin);
+        }
+
+        *ptr++ = (unsigned char)(adler >> 24);
+        *ptr++ = (unsigned char)(adler >> 16);
+        *ptr++ = (unsigned char)(adler >> 8);
+        *ptr++ = (unsigned char)adler;
+
+        *output_size = comp_data_size;
+    }
+
+    for (int i = 0; i < stripe_count; i++) RPNG_FREE(stripes[i].output);
+    RPNG_FREE(stripes);
+
+    return comp_data;
+}
+
+// Compress one stripe (job function)
+static void rpng_deflate_stripe_job(void *job_data)
+{
+    rpng_deflate_stripe *stripe = (rpng_deflate_stripe *)job_data;
+    int size = stripe->end - stripe->begin;
+
+    struct sdefl *sde = (struct sdefl *)RPNG_CALLOC(sizeof(struct sdefl), 1);
+    // NOTE: Extra stored block headers per compression block considered (not included by all sdefl_bound() versions),
+    // alignment stored block (one byte) also included
+    stripe->output = (unsigned char *)RPNG_MALLOC(sdefl_bound(size) + 5*(size/SDEFL_BLK_MAX + 1) + 6);
+
+    if ((sde != NULL) && (stripe->output != NULL))
+    {
+        int dictionary = (stripe->begin > SDEFL_WIN_SIZ)? (stripe->begin - SDEFL_WIN_SIZ) : 0;
+
+        sde->bits = sde->bitcnt = 0;
+        stripe->output_size = sdefl_compr_range(sde, stripe->output, stripe->data, dictionary, stripe->begin, stripe->end, stripe->level, stripe->last);
+        stripe->adler = update_adler32(1, stripe->data + stripe->begin, size);
+    }
+
+    RPNG_FREE(sde);
+}
+
+// Combine Adler-32 of two consecutive data blocks
+// REF: zlib adler32_combine()
+static unsigned int combine_adler32(unsigned int adler1, unsigned int adler2, int size2)
+{
+    const unsigned int base = 65521;
+    unsigned int rem = (unsigned int)size2%base;
+    unsigned int sum1 = adler1 & 0xffff;
+    unsigned int sum2 = (rem*sum1)%base;
+
+    sum1 += (adler2 & 0xffff) + base - 1;
+    sum2 += (adler1 >> 16) + (adler2 >> 16) + base - rem;
+
+    if (sum1 >= base) sum1 -= base;
+    if (sum1 >= base) sum1 -= base;
+    if (sum2 >= (base << 1)) sum2 -= (base << 1);
+    if (sum2 >= base) sum2 -= base;
+
+    return (sum2 << 16) | sum1;
+}
+
+// Unfilter one scanline, output can be filtered data position or before it (in place)
+static bool rpng_unfilter_scanline(unsigned char *scanline, const unsigned char *filtered, const unsigned char *prev_scanline, int scanline_size, int pixel_size, int filter)
+{
+    // x = current byte
+    // a = left pixel byte (from current)
+    // b = above pixel byte (from current)
+    // c = left pixel byte (from b)
+    switch (filter)
+    {
+        case 0: memmove(scanline, filtered, scanline_size); break;    // Filter type 0: None (Usually used for indexed images)
+        case 1:     // Filter type 1: Sub
+        {
+            for (int p = 0; p < pixel_size; p++) scanline[p] = filtered[p];
+            for (int p = pixel_size; p < scanline_size; p++) scanline[p] = filtered[p] + scanline[p - pixel_size];
+        } break;
+        case 2:     // Filter type 2: Up
+        {
+            if (prev_scanline == NULL) memmove(scanline, filtered, scanline_size);
+            else for (int p = 0; p < scanline_size; p++) scanline[p] = filtered[p] + prev_scanline[p];
+        } break;
+        case 3:     // Filter type 3: Average
+        {
+            for (int p = 0; p < scanline_size; p++)
+            {
+                int a = (p >= pixel_size)? scanline[p - pixel_size] : 0;
+                int b = (prev_scanline != NULL)? prev_scanline[p] : 0;
+                scanline[p] = filtered[p] + ((a + b) >> 1);
+            }
+        } break;
+        case 4:     // Filter type 4: Paeth
+        {
+            for (int p = 0; p < scanline_size; p++)
+            {
+                int a = (p >= pixel_size)? scanline[p - pixel_size] : 0;
+                int b = (prev_scanline != NULL)? prev_scanline[p] : 0;
+                int c = ((prev_scanline != NULL) && (p >= pixel_size))? prev_scanline[p - pixel_size] : 0;
+                scanline[p] = filtered[p] + rpng_paeth_predictor(a, b, c);
+            }
+        } break;
+        default: return false;  // Filter type not valid
+    }
+
+    return true;
+}
+
+// Concatenate all IDAT chunks data (output can be NULL to get size), CRC32 checked if requested
+// NOTE: Buffer is expected to be PNG compliant, ending with IEND chunk
+static int rpng_concat_image_data(const char *buffer, char *output, bool *crc_valid)
+{
+    const char *buffer_ptr = buffer + 8;   // Move pointer after signature
+    int image_data_size = 0;
+
+    if (crc_valid != NULL) *crc_valid = true;
+
+    unsigned int chunk_size = swap_endian(((int *)buffer_ptr)[0]);
+
+    while (memcmp(buffer_ptr + 4, "IEND", 4) != 0) // While IEND chunk not reached
+    {
+        if (memcmp(buffer_ptr + 4, "IDAT", 4) == 0)
+        {
+            if (output != NULL) memcpy(output + image_data_size, buffer_ptr + 8, chunk_size);
+            image_data_size += chunk_size;
+
+            // Validate chunk CRC32 (computed over type and data)
+            if ((crc_valid != NULL) && (compute_crc32((unsigned char *)buffer_ptr + 4, 4 + chunk_size) != swap_endian(((unsigned int *)(buffer_ptr + 8 + chunk_size))[0]))) *crc_valid = false;
+        }
+
+        buffer_ptr += (4 + 4 + chunk_size + 4); // Move pointer to next chunk of input data
+        chunk_size = swap_endian(((int *)buffer_ptr)[0]); // Compute next chunk size
+    }
+
+    return image_data_size;
+}
+
+// Get scratch arena memory of required size, previous content is not kept
+static char *rpng_arena_reserve(rpng_arena *arena, int size)
+{
+    if (size > arena->size)
+    {
+        RPNG_FREE(arena->data);
+
+        arena->data = (char *)RPNG_MALLOC(size);
+        arena->size = (arena->data != NULL)? size : 0;
+    }
+
+    return arena->data;
+}
+
+//----------------------------------------------------------------------------------
+// Streaming decoder internal functions
+//----------------------------------------------------------------------------------
+// Process staged field (signature, chunk header, IHDR, CRC)
+static int rpng_decoder_process_field(rpng_decoder *decoder)
+{
+    const unsigned char *field = decoder->staging;
+
+    switch (decoder->state)
+    {
+        case RPNG_STREAM_SIGNATURE:
+        {
+            if (memcmp(field, png_signature, 8) != 0) return RPNG_DECODER_ERROR;
+            decoder->state = RPNG_STREAM_CHUNK_HEADER;
+        } break;
+        case RPNG_STREAM_CHUNK_HEADER:
+        {
+            decoder->chunk_remaining = ((unsigned int)field[0] << 24) | ((unsigned int)field[1] << 16) | ((unsigned int)field[2] << 8) | field[3];
+            memcpy(decoder->chunk_type, field + 4, 4);
+            decoder->crc = update_crc32(0, field + 4, 4);
+
+            if (decoder->chunk_remaining > 0x7fffffff) return RPNG_DECODER_ERROR;
+
+            // First chunk must be IHDR, image data required before end
+            if (!decoder->header_read && ((memcmp(decoder->chunk_type, "IHDR", 4) != 0) || (decoder->chunk_remaining != 13))) return RPNG_DECODER_ERROR;
+            if ((memcmp(decoder->chunk_type, "IEND", 4) == 0) && (decoder->inflate_state != RPNG_INFLATE_END)) return RPNG_DECODER_ERROR;
+
+            decoder->state = (decoder->chunk_remaining > 0)? RPNG_STREAM_CHUNK_DATA : RPNG_STREAM_CHUNK_CRC;
+        } break;
+        case RPNG_STREAM_CHUNK_DATA:    // IHDR data, only staged chunk data
+        {
+            int width = ((unsigned int)field[0] << 24) | ((unsigned int)field[1] << 16) | ((unsigned int)field[2] << 8) | field[3];
+            int height = ((unsigned int)field[4] << 24) | ((unsigned int)field[5] << 16) | ((unsigned int)field[6] << 8) | field[7];
+            int bit_depth = field[8];
+            int color_channels = 0;
+
+            switch (field[9])
+            {
+                case 0: color_channels = 1; break;     // Pixel format: 0-Grayscale
+                case 4: color_channels = 2; break;     // Pixel format: 4-GrayAlpha
+                case 2: color_channels = 3; break;     // Pixel format: 2-RGB
+                case 6: color_channels = 4; break;     // Pixel format: 6-RGBA
+                case 3: color_channels = 1; break;     // Pixel format: 3-Indexed (1 channel containing 8-bit indexed data)
+                default: break;
+            }
+
+            // Compression, filter and interlace methods (bytes 10, 11, 12)
+            if ((width <= 0) || (height <= 0) || (color_channels == 0) || ((bit_depth != 8) && (bit_depth != 16)) ||
+                (field[10] != 0) || (field[11] != 0) || (field[12] != 0)) return RPNG_DECODER_ERROR;
+
+            long long scanline_size = (long long)width*color_channels*(bit_depth/8);
+            if (((scanline_size + 1)*height) > 0x7fffffff) return RPNG_DECODER_ERROR;
+
+            decoder->width = width;
+            decoder->height = height;
+            decoder->color_channels = color_channels;
+            decoder->bit_depth = bit_depth;
+            decoder->pixel_size = color_channels*(bit_depth/8);
+            decoder->scanline_size = (int)scanline_size;
+            decoder->header_read = true;
+
+            // Current and previous scanlines, memory kept between images
+            int required = 2*(1 + decoder->scanline_size);
+
+            if (required > decoder->scanlines_capacity)
+            {
+                RPNG_FREE(decoder->scanlines);
+                decoder->scanlines = (unsigned char *)RPNG_MALLOC(required);
+                decoder->scanlines_capacity = (decoder->scanlines != NULL)? required : 0;
+
+                if (decoder->scanlines == NULL) return RPNG_DECODER_ERROR;
+            }
+
+            decoder->state = RPNG_STREAM_CHUNK_CRC;
+        } break;
+        case RPNG_STREAM_CHUNK_CRC:
+        {
+            unsigned int crc = ((unsigned int)field[0] << 24) | ((unsigned int)field[1] << 16) | ((unsigned int)field[2] << 8) | field[3];
+            if (crc != decoder->crc) return RPNG_DECODER_ERROR;
+
+            if (memcmp(decoder->chunk_type, "IEND", 4) == 0)
+            {
+                decoder->state = RPNG_STREAM_END;
+                return RPNG_DECODER_DONE;
+            }
+
+            decoder->state = RPNG_STREAM_CHUNK_HEADER;
+        } break;
+        default: break;
+    }
+
+    return RPNG_DECODER_CONTINUE;
+}
+
+// Inflate compressed data piece
+// NOTE: Data is appended to pending input in small pieces, steps are decoded while bits are available,
+// pending input only keeps data for one step not completed (i.e. dynamic block header)
+static int rpng_decoder_inflate(rpng_decoder *decoder, const unsigned char *data, int size)
+{
+    while (size > 0)
+    {
+        int piece = (size < 4096)? size : 4096;
+
+        // Discard input consumed, make room for new piece
+        if (decoder->input_pos > 0)
+        {
+            memmove(decoder->input, decoder->input + decoder->input_pos, decoder->input_size - decoder->input_pos);
+            decoder->input_size -= decoder->input_pos;
+            decoder->input_pos = 0;
+        }
+
+        if ((decoder->input_size + piece) > decoder->input_capacity)
+        {
+            int capacity = decoder->input_size + piece;
+            unsigned char *input = (unsigned char *)RPNG_REALLOC(decoder->input, capacity);
+            if (input == NULL) return RPNG_DECODER_ERROR;
+
+            decoder->input = input;
+            decoder->input_capacity = capacity;
+        }
+
+        memcpy(decoder->input + decoder->input_size, data, piece);
+        decoder->input_size += piece;
+        data += piece;
+        size -= piece;
+
+        // Decode steps until bits not available or stream completed
+        while (decoder->inflate_state != RPNG_INFLATE_END)
+        {
+            int result = rpng_decoder_inflate_step(decoder);
+
+            if (result == RPNG_INFLATE_STEP_ERROR) return RPNG_DECODER_ERROR;
+            if (result == RPNG_INFLATE_STEP_WAIT) break;
+        }
+
+        // WARNING: Data after zlib stream end is not valid
+        if ((decoder->inflate_state == RPNG_INFLATE_END) && ((decoder->input_pos < decoder->input_size) || (size > 0))) return RPNG_DECODER_ERROR;
+    }
+
+    return RPNG_DECODER_CONTINUE;
+}
+
+// Inflate one step, restored if bits not available
+// NOTE: A step is one zlib/block header or one literal/match, output is only
+// generated once all the bits required by the step have been read
+static int rpng_decoder_inflate_step(rpng_decoder *decoder)
+{
+    static const short length_base[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+    static const unsigned char length_extra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+    static const unsigned short distance_base[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+    static const unsigned char distance_extra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+    static const unsigned char lengths_order[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+    // Step start, restored if bits not available
+    int input_pos = decoder->input_pos;
+    unsigned long long bitbuf = decoder->bitbuf;
+    int bitcnt = decoder->bitcnt;
+
+    int result = RPNG_INFLATE_STEP_OK;
+    unsigned int value = 0;
+
+    switch (decoder->inflate_state)
+    {
+        case RPNG_INFLATE_ZLIB_HEADER:
+        {
+            if (!rpng_decoder_bits(decoder, 16, &value)) { result = RPNG_INFLATE_STEP_WAIT; break; }
+
+            unsigned int cmf = value & 0xff;
+            unsigned int flg = value >> 8;
+
+            // Compression method 8 (deflate), window up to 32 KB, no preset dictionary
+            if (((cmf & 0x0f) != 8) || ((cmf >> 4) > 7) || (flg & 0x20) || (((cmf << 8) | flg)%31 != 0)) { result = RPNG_INFLATE_STEP_ERROR; break; }
+
+            decoder->inflate_state = RPNG_INFLATE_BLOCK_HEADER;
+        } break;
+        case RPNG_INFLATE_BLOCK_HEADER:
+        {
+            if (!rpng_decoder_bits(decoder, 3, &value)) { result = RPNG_INFLATE_STEP_WAIT; break; }
+
+            decoder->last_block = (value & 1);
+
+            switch (value >> 1)
             {
-                if (sum_value[filter] < best_value)
+                case 0:     // Stored block: byte aligned LEN and NLEN
                 {
-                    best_value = sum_value[filter];
-                    best_filter = filter;
+                    unsigned int length = 0;
+                    unsigned int length_check = 0;
+
+                    rpng_decoder_bits(decoder, decoder->bitcnt & 7, &value);
+                    if (!rpng_decoder_bits(decoder, 16, &length) || !rpng_decoder_bits(decoder, 16, &length_check)) { result = RPNG_INFLATE_STEP_WAIT; break; }
+                    if (length != (~length_check & 0xffff)) { result = RPNG_INFLATE_STEP_ERROR; break; }
+
+                    decoder->stored_remaining = length;
+                    decoder->inflate_state = RPNG_INFLATE_STORED;
+                } break;
+                case 1:     // Fixed Huffman codes
+                {
+                    unsigned char lengths[288] = { 0 };
+
+                    for (int i = 0; i < 144; i++) lengths[i] = 8;
+                    for (int i = 144; i < 256; i++) lengths[i] = 9;
+                    for (int i = 256; i < 280; i++) lengths[i] = 7;
+                    for (int i = 280; i < 288; i++) lengths[i] = 8;
+                    rpng_huffman_build(&decoder->lit, lengths, 288);
+
+                    for (int i = 0; i < 30; i++) lengths[i] = 5;
+                    rpng_huffman_build(&decoder->dist, lengths, 30);
+
+                    decoder->inflate_state = RPNG_INFLATE_CODES;
+                } break;
+                case 2: decoder->inflate_state = RPNG_INFLATE_DYNAMIC_HEADER; break;
+                default: result = RPNG_INFLATE_STEP_ERROR; break;
+            }
+        } break;
+        case RPNG_INFLATE_DYNAMIC_HEADER:
+        {
+            unsigned int lit_count = 0, dist_count = 0, lengths_count = 0;
+            unsigned char lengths[320] = { 0 };
+
+            if (!rpng_decoder_bits(decoder, 5, &lit_count) || !rpng_decoder_bits(decoder, 5, &dist_count) ||
+                !rpng_decoder_bits(decoder, 4, &lengths_count)) { result = RPNG_INFLATE_STEP_WAIT; break; }
+
+            lit_count += 257;
+            dist_count += 1;
+            lengths_count += 4;
+
+            if ((lit_count > 286) || (dist_count > 30)) { result = RPNG_INFLATE_STEP_ERROR; break; }
+
+            // Code lengths code, used to decode literal/length and distance code lengths
+            for (unsigned int i = 0; i < lengths_count; i++)
+            {
+                if (!rpng_decoder_bits(decoder, 3, &value)) { result = RPNG_INFLATE_STEP_WAIT; break; }
+                lengths[lengths_order[i]] = (unsigned char)value;
+            }
+
+            if (result != RPNG_INFLATE_STEP_OK) break;
+            if (!rpng_huffman_build(&decoder->lit, lengths, 19)) { result = RPNG_INFLATE_STEP_ERROR; break; }
+
+            memset(lengths, 0, 19);
+
+            for (unsigned int i = 0; (i < (lit_count + dist_count)) && (result == RPNG_INFLATE_STEP_OK); )
+            {
+                int symbol = rpng_huffman_decode(decoder, &decoder->lit);
+
+                if (symbol < 0) { result = (symbol == -1)? RPNG_INFLATE_STEP_WAIT : RPNG_INFLATE_STEP_ERROR; break; }
+
+                if (symbol < 16) lengths[i++] = (unsigned char)symbol;
+                else
+                {
+                    unsigned int repeat = 0;
+                    unsigned char length = 0;
+
+                    if (symbol == 16)       // Repeat previous length 3-6 times
+                    {
+                        if (i == 0) { result = RPNG_INFLATE_STEP_ERROR; break; }
+                        length = lengths[i - 1];
+                        if (!rpng_decoder_bits(decoder, 2, &repeat)) { result = RPNG_INFLATE_STEP_WAIT; break; }
+                        repeat += 3;
+                    }
+                    else if (symbol == 17)  // Repeat zero length 3-10 times
+                    {
+                        if (!rpng_decoder_bits(decoder, 3, &repeat)) { result = RPNG_INFLATE_STEP_WAIT; break; }
+                        repeat += 3;
+                    }
+                    else                    // Repeat zero length 11-138 times
+                    {
+                        if (!rpng_decoder_bits(decoder, 7, &repeat)) { result = RPNG_INFLATE_STEP_WAIT; break; }
+                        repeat += 11;
+                    }
+
+                    if ((i + repeat) > (lit_count + dist_count)) { result = RPNG_INFLATE_STEP_ERROR; break; }
+                    while (repeat--) lengths[i++] = length;
                 }
             }
-        }
-        else if ((forced_filter_type >= 0) && (forced_filter_type <= 4)) best_filter = forced_filter_type;
 
-        // Register scanline filter byte
-        data_filtered[(scanline_size + 1)*y] = best_filter;
+            if (result != RPNG_INFLATE_STEP_OK) break;
 
-        // Apply the best_filter to scanline
-        for (int p = 0; p < scanline_size; p++)
+            // End of block code required
+            if ((lengths[256] == 0) ||
+                !rpng_huffman_build(&decoder->lit, lengths, lit_count) ||
+                !rpng_huffman_build(&decoder->dist, lengths + lit_count, dist_count)) { result = RPNG_INFLATE_STEP_ERROR; break; }
+
+            decoder->inflate_state = RPNG_INFLATE_CODES;
+        } break;
+        case RPNG_INFLATE_CODES:
         {
-            x = (int)((unsigned char *)image_data)[scanline_size*y + p];
-            a = (p >= pixel_size)? (int)((unsigned char *)image_data)[scanline_size*y + p - pixel_size] : 0;
-            b = (y > 0)? (int)((unsigned char *)image_data)[scanline_size*(y - 1) + p] : 0;
-            c = (y > 0)? ((p >= pixel_size) ? (int)((unsigned char *)image_data)[scanline_size*(y - 1) + p - pixel_size] : 0) : 0;
+            // NOTE: Symbols decoded until block end or bits not available, every symbol is one step,
+            // consecutive literals are grouped for output
+            unsigned char literals[256];
+            int literal_count = 0;
 
-            switch (best_filter)
+            while ((result == RPNG_INFLATE_STEP_OK) && (decoder->inflate_state == RPNG_INFLATE_CODES))
             {
-                case 0: out = x; break;
-                case 1: out = x - a; break;
-                case 2: out = x - b; break;
-                case 3: out = x - ((a + b)>>1); break;
-                case 4: out = x - rpng_paeth_predictor(a, b, c); break;
-                default: break;
+                input_pos = decoder->input_pos;
+                bitbuf = decoder->bitbuf;
+                bitcnt = decoder->bitcnt;
+
+                int symbol = rpng_huffman_decode(decoder, &decoder->lit);
+
+                if (symbol < 0) { result = (symbol == -1)? RPNG_INFLATE_STEP_WAIT : RPNG_INFLATE_STEP_ERROR; break; }
+
+                if (symbol < 256)
+                {
+                    literals[literal_count++] = (unsigned char)symbol;
+
+                    if (literal_count == 256)
+                    {
+                        if (rpng_decoder_output(decoder, literals, literal_count) != RPNG_DECODER_CONTINUE) result = RPNG_INFLATE_STEP_ERROR;
+                        literal_count = 0;
+                    }
+
+                    continue;
+                }
+
+                if (literal_count > 0)
+                {
+                    if (rpng_decoder_output(decoder, literals, literal_count) != RPNG_DECODER_CONTINUE) { result = RPNG_INFLATE_STEP_ERROR; break; }
+                    literal_count = 0;
+                }
+
+                if (symbol == 256)     // End of block
+                {
+                    decoder->inflate_state = decoder->last_block? RPNG_INFLATE_ADLER : RPNG_INFLATE_BLOCK_HEADER;
+                }
+                else
+                {
+                    symbol -= 257;
+                    if (symbol >= 29) { result = RPNG_INFLATE_STEP_ERROR; break; }
+
+                    unsigned int length_bits = 0;
+                    unsigned int distance_bits = 0;
+
+                    if (!rpng_decoder_bits(decoder, length_extra[symbol], &length_bits)) { result = RPNG_INFLATE_STEP_WAIT; break; }
+                    int length = length_base[symbol] + length_bits;
+
+                    int distance_symbol = rpng_huffman_decode(decoder, &decoder->dist);
+                    if (distance_symbol < 0) { result = (distance_symbol == -1)? RPNG_INFLATE_STEP_WAIT : RPNG_INFLATE_STEP_ERROR; break; }
+                    if (distance_symbol >= 30) { result = RPNG_INFLATE_STEP_ERROR; break; }
+
+                    if (!rpng_decoder_bits(decoder, distance_extra[distance_symbol], &distance_bits)) { result = RPNG_INFLATE_STEP_WAIT; break; }
+                    int distance = distance_base[distance_symbol] + distance_bits;
+
+                    if ((unsigned int)distance > decoder->output_size) { result = RPNG_INFLATE_STEP_ERROR; break; }
+                    if (rpng_decoder_output_match(decoder, length, distance) != RPNG_DECODER_CONTINUE) result = RPNG_INFLATE_STEP_ERROR;
+                }
+            }
+
+            // Literals decoded before bits not available are kept
+            if ((literal_count > 0) && (result != RPNG_INFLATE_STEP_ERROR) &&
+                (rpng_decoder_output(decoder, literals, literal_count) != RPNG_DECODER_CONTINUE)) result = RPNG_INFLATE_STEP_ERROR;
+        } break;
+        case RPNG_INFLATE_STORED:
+        {
+            // NOTE: Bits buffer is byte aligned, buffered bytes provided first
+            while ((decoder->stored_remaining > 0) && (decoder->bitcnt >= 8))
+            {
+                unsigned char byte = (unsigned char)(decoder->bitbuf & 0xff);
+                decoder->bitbuf >>= 8;
+                decoder->bitcnt -= 8;
+                decoder->stored_remaining--;
+
+                if (rpng_decoder_output(decoder, &byte, 1) != RPNG_DECODER_CONTINUE) return RPNG_INFLATE_STEP_ERROR;
+            }
+
+            int available = decoder->input_size - decoder->input_pos;
+            int count = (decoder->stored_remaining < (unsigned int)available)? (int)decoder->stored_remaining : available;
+
+            if (count > 0)
+            {
+                if (rpng_decoder_output(decoder, decoder->input + decoder->input_pos, count) != RPNG_DECODER_CONTINUE) return RPNG_INFLATE_STEP_ERROR;
+
+                decoder->input_pos += count;
+                decoder->stored_remaining -= count;
+            }
+
+            if (decoder->stored_remaining == 0) decoder->inflate_state = decoder->last_block? RPNG_INFLATE_ADLER : RPNG_INFLATE_BLOCK_HEADER;
+            else return RPNG_INFLATE_STEP_WAIT;     // NOTE: Output already provided, nothing to restore
+        } break;
+        case RPNG_INFLATE_ADLER:
+        {
+            unsigned int adler = 0;
+
+            rpng_decoder_bits(decoder, decoder->bitcnt & 7, &value);
+
+            for (int i = 0; i < 4; i++)
+            {
+                if (!rpng_decoder_bits(decoder, 8, &value)) { result = RPNG_INFLATE_STEP_WAIT; break; }
+                adler = (adler << 8) | value;
             }
 
-            // Register scanline filtered values, byte by byte
-            data_filtered[(scanline_size + 1)*y + 1 + p] = (unsigned char)out;
+            if (result != RPNG_INFLATE_STEP_OK) break;
+
+            // All scanlines are required, Adler-32 computed over decompressed data
+            if ((decoder->row != decoder->height) || (adler != ((decoder->adler_b << 16) | decoder->adler_a))) { result = RPNG_INFLATE_STEP_ERROR; break; }
+
+            decoder->inflate_state = RPNG_INFLATE_END;
+        } break;
+        default: break;
+    }
+
+    if (result == RPNG_INFLATE_STEP_WAIT)
+    {
+        decoder->input_pos = input_pos;
+        decoder->bitbuf = bitbuf;
+        decoder->bitcnt = bitcnt;
+    }
+
+    return result;
+}
+
+// Output decompressed bytes to scanlines
+// NOTE: Bytes are also kept in inflate window, scanlines are unfiltered and provided when completed
+static int rpng_decoder_output(rpng_decoder *decoder, const unsigned char *data, int size)
+{
+    int row_size = 1 + decoder->scanline_size;
+
+    // Inflate window, copied in two pieces if wrapped
+    // NOTE: Only last 32 KB required, size is never bigger than one match/literals group
+    int window_pos = decoder->output_size & 32767;
+    int window_count = ((window_pos + size) > 32768)? (32768 - window_pos) : size;
+
+    memcpy(decoder->window + window_pos, data, window_count);
+    memcpy(decoder->window, data + window_count, size - window_count);
+    decoder->output_size += size;
+
+    while (size > 0)
+    {
+        if (decoder->row >= decoder->height) return RPNG_DECODER_ERROR;    // More data than image size
+
+        unsigned char *current = decoder->scanlines + (decoder->row & 1)*row_size;
+        int count = row_size - decoder->row_fill;
+        if (count > size) count = size;
+
+        memcpy(current + decoder->row_fill, data, count);
+        decoder->row_fill += count;
+        data += count;
+        size -= count;
+
+        if (decoder->row_fill == row_size)
+        {
+            unsigned int adler = update_adler32((decoder->adler_b << 16) | decoder->adler_a, current, row_size);
+            decoder->adler_a = adler & 0xffff;
+            decoder->adler_b = adler >> 16;
+
+            const unsigned char *previous = (decoder->row > 0)? (decoder->scanlines + ((decoder->row + 1) & 1)*row_size + 1) : NULL;
+
+            if (!rpng_unfilter_scanline(current + 1, current + 1, previous, decoder->scanline_size, decoder->pixel_size, current[0])) return RPNG_DECODER_ERROR;
+
+            decoder->callback((const char *)(current + 1), decoder->row, decoder->user_data);
+            decoder->row++;
+            decoder->row_fill = 0;
         }
     }
 
-    // Compress filtered image data and generate a valid zlib stream
-    struct sdefl *sde = (struct sdefl*)RPNG_CALLOC(sizeof(struct sdefl), 1);
-    int bounds = sdefl_bound(data_filtered_size);
-    char *comp_data = (char *)RPNG_CALLOC(bounds, 1);
-    int comp_data_size = zsdeflate(sde, comp_data, data_filtered, data_filtered_size, RPNG_COMPRESSION_LEVEL);
-    RPNG_FREE(data_filtered);
-    RPNG_FREE(sde);
+    return RPNG_DECODER_CONTINUE;
+}
 
-    if ((comp_data != NULL) && (comp_data_size > 0))
+// Output match from inflate window
+// NOTE: Match is copied in pieces not overlapping the bytes being written
+static int rpng_decoder_output_match(rpng_decoder *decoder, int length, int distance)
+{
+    unsigned char piece[258];
+    int start = (decoder->output_size - distance) & 32767;
+
+    if (distance >= length)
     {
-        idat_data = comp_data;
-        *output_size = comp_data_size;
-        RPNG_LOG("INFO: Image data deflated successfully: %i bytes -> %i bytes\n", data_filtered_size, comp_data_size);
+        // NOTE: Window data can be output directly if not overwritten by same output
+        if (((start + length) <= 32768) && (distance <= (32768 - length))) return rpng_decoder_output(decoder, decoder->window + start, length);
+
+        int count = ((start + length) > 32768)? (32768 - start) : length;
+        memcpy(piece, decoder->window + start, count);
+        memcpy(piece + count, decoder->window, length - count);
+    }
+    else
+    {
+        // Overlapped match, repeating last distance bytes
+        for (int i = 0; i < distance; i++) piece[i] = decoder->window[(start + i) & 32767];
+        for (int i = distance; i < length; i++) piece[i] = piece[i - distance];
     }
-    else RPNG_LOG("INFO: Image data deflating failed\n");
 
-    return idat_data;
+    return rpng_decoder_output(decoder, piece, length);
 }
 
-// Decompress and unfilter image data (IDAT)
-static char *rpng_inflate_image_data(char *image_data, int image_data_size, int width, int height, int pixel_size)
+// Build Huffman table from code lengths
+// NOTE: Incomplete codes are allowed (i.e. single distance code), over-subscribed codes are not valid
+static bool rpng_huffman_build(rpng_huffman *huffman, const unsigned char *lengths, int count)
 {
-    char *image_data_unfiltered = NULL;
-    char *image_data_filtered = (char *)RPNG_CALLOC(RPNG_MAX_OUTPUT_SIZE, 1); // WARNING: Allocate enough memory to load full image decompressed
+    short offsets[16] = { 0 };
 
-    // Decompress IDAT chunk data
-    int image_data_decomp_size = zsinflate(image_data_filtered, RPNG_MAX_OUTPUT_SIZE, image_data, image_data_size);
+    memset(huffman->count, 0, sizeof(huffman->count));
+    memset(huffman->fast, 0, sizeof(huffman->fast));
 
-    RPNG_LOG("INFO: IDAT data decompressed: %i -> %i\n", image_data_size, image_data_decomp_size);
+    for (int i = 0; i < count; i++) huffman->count[lengths[i]]++;
+    huffman->count[0] = 0;
 
-    if ((image_data_filtered != NULL) && (image_data_decomp_size > 0))
+    int left = 1;
+    for (int len = 1; len < 16; len++)
     {
-        // Now we have the data decompressed but every scanline of the image was originally filtered for
-        // maximum compression and one extra byte with the filter type was added to every scanline
-        // We must undo that image prefiltering for every scanline
+        left <<= 1;
+        left -= huffman->count[len];
+        if (left < 0) return false;
+    }
 
-        // Image data reverse pre-processing for filter type
-        //int pixel_size = *color_channels*(*bit_depth/8);
-        int scanline_size = width*pixel_size;
-        image_data_unfiltered = (char *)RPNG_CALLOC(image_data_decomp_size, 1);  // Actually data unfiltered size should be smaller
+    for (int len = 1; len < 15; len++) offsets[len + 1] = offsets[len] + huffman->count[len];
+    for (int i = 0; i < count; i++) if (lengths[i] != 0) huffman->symbol[offsets[lengths[i]]++] = (short)i;
 
-        int current_filter = 0;
-        int out = 0, x = 0, a = 0, b = 0, c = 0;
+    // Fast lookup for short codes, codes are stored bit-reversed on stream
+    int code = 0;
+    int index = 0;
 
-        // Reverse scanlines filters
-        for (int y = 0; y < height; y++)   // Move scanline by scanline, we must discard first byte = current_filter
+    for (int len = 1; len <= RPNG_HUFFMAN_FAST_BITS; len++)
+    {
+        for (int k = 0; k < huffman->count[len]; k++, code++, index++)
         {
-            current_filter = (int)image_data_filtered[(1 + scanline_size)*y];
+            int reversed = 0;
+            for (int b = 0; b < len; b++) reversed |= ((code >> b) & 1) << (len - 1 - b);
 
-            for (int p = 0; p < scanline_size; p++)
-            {
-                // x = current byte
-                // a = left pixel byte (from current)
-                // b = above pixel byte (from current)
-                // c = left pixel byte (from b)
-                x = (int)(image_data_filtered[(1 + scanline_size)*y + 1 + p]);
-                a = (p >= pixel_size) ? (int)(image_data_unfiltered[scanline_size*y + p - pixel_size]) : 0;
-                b = (y > 0) ? (int)(image_data_unfiltered[scanline_size*(y - 1) + p]) : 0;
-                c = (y > 0) ? ((p >= pixel_size) ? (int)(image_data_unfiltered[scanline_size*(y - 1) + p - pixel_size]) : 0) : 0;
-
-                switch (current_filter)
-                {
-                    case 0: out = x; break;         // Filter type 0: None (Usually used for indexed images)
-                    case 1: out = x + a; break;     // Filter type 1: Sub
-                    case 2: out = x + b; break;     // Filter type 2: Up
-                    case 3: out = x + ((a + b)>>1); break;    // Filter type 3: Average
-                    case 4: out = x + rpng_paeth_predictor(a, b, c); break;  // Filter type 4: Paeth
-                    default: break;
-                }
+            for (int i = reversed; i < (1 << RPNG_HUFFMAN_FAST_BITS); i += (1 << len)) huffman->fast[i] = (unsigned short)((huffman->symbol[index] << 4) | len);
+        }
 
-                // Register scanline unfiltered values, byte by byte
-                image_data_unfiltered[y*scanline_size + p] = (char)out;
-            }
+        code <<= 1;
+    }
+
+    return true;
+}
+
+// Decode one symbol (-1: bits not available, -2: code not valid)
+static int rpng_huffman_decode(rpng_decoder *decoder, const rpng_huffman *huffman)
+{
+    // Fill bits buffer with available input
+    while ((decoder->bitcnt <= 56) && (decoder->input_pos < decoder->input_size))
+    {
+        decoder->bitbuf |= (unsigned long long)decoder->input[decoder->input_pos++] << decoder->bitcnt;
+        decoder->bitcnt += 8;
+    }
+
+    unsigned int entry = huffman->fast[decoder->bitbuf & ((1 << RPNG_HUFFMAN_FAST_BITS) - 1)];
+
+    if ((entry != 0) && ((int)(entry & 15) <= decoder->bitcnt))
+    {
+        decoder->bitbuf >>= (entry & 15);
+        decoder->bitcnt -= (entry & 15);
+
+        return (int)(entry >> 4);
+    }
+
+    // Canonical decoding, one bit at a time
+    int code = 0;       // Code bits read
+    int first = 0;      // First code of current length
+    int index = 0;      // Index of first code of current length in symbols
+
+    for (int len = 1; len < 16; len++)
+    {
+        if (len > decoder->bitcnt) return -1;
+
+        code |= (int)((decoder->bitbuf >> (len - 1)) & 1);
+        int count = huffman->count[len];
+
+        if ((code - count) < first)
+        {
+            decoder->bitbuf >>= len;
+            decoder->bitcnt -= len;
+
+            return huffman->symbol[index + (code - first)];
         }
 
-        RPNG_FREE(image_data_filtered);
+        index += count;
+        first += count;
+        first <<= 1;
+        code <<= 1;
+    }
+
+    return -2;
+}
+
+// Get bits from input (false if not available)
+static bool rpng_decoder_bits(rpng_decoder *decoder, int count, unsigned int *value)
+{
+    while (decoder->bitcnt < count)
+    {
+        if (decoder->input_pos >= decoder->input_size) return false;
+
+        decoder->bitbuf |= (unsigned long long)decoder->input[decoder->input_pos++] << decoder->bitcnt;
+        decoder->bitcnt += 8;
     }
 
-    return image_data_unfiltered;
+    *value = (unsigned int)(decoder->bitbuf & ((1ull << count) - 1));
+    decoder->bitbuf >>= count;
+    decoder->bitcnt -= count;
+
+    return true;
 }
 
 // Swap integer from big<->little endian
@@ -2219,12 +4300,51 @@ static unsigned int swap_endian(unsigned int value)
     return res;
 }
 
+// Write chunk into output buffer (length, type, data and CRC32), returns bytes written
+static int rpng_write_chunk(char *output, const char *type, const void *data, int length)
+{
+    unsigned int length_be = swap_endian((unsigned int)length);
+    memcpy(output, &length_be, 4);
+    memcpy(output + 4, type, 4);
+    if (length > 0) memcpy(output + 8, data, length);
+
+    unsigned int crc = compute_crc32((unsigned char *)output + 4, 4 + length);     // CRC32 computed over type + data
+    crc = swap_endian(crc);
+    memcpy(output + 8 + length, &crc, 4);
+
+    return 4 + 4 + length + 4;
+}
+
+// Write chunks list into output buffer, returns bytes written
+static int rpng_write_chunks(char *output, const rpng_chunk *chunks, int chunk_count)
+{
+    int size = 0;
+    for (int i = 0; i < chunk_count; i++) size += rpng_write_chunk(output + size, chunks[i].type, chunks[i].data, chunks[i].length);
+
+    return size;
+}
+
+// Get chunks list size written (length, type, data and CRC32 of every chunk)
+static int rpng_get_chunks_size(const rpng_chunk *chunks, int chunk_count)
+{
+    int size = 0;
+    for (int i = 0; i < chunk_count; i++) size += (4 + 4 + chunks[i].length + 4);
+
+    return size;
+}
+
 // Compute CRC32
 static unsigned int compute_crc32(unsigned char *buffer, int size)
 {
-    static unsigned int crc_table[256] = {
+    return update_crc32(0, buffer, size);
+}
+
+// CRC32 lookup tables for slice-by-8 computation (8 bytes per step)
+// NOTE: Table 0 is the byte-at-a-time table, table k is the CRC of table 0 entries shifted by k zero bytes
+static const unsigned int rpng_crc32_table[8][256] = {
+    {
         0x00000000, 0x77073096, 0xEE0E612C, 0x990951BA, 0x076DC419, 0x706AF48F, 0xE963A535, 0x9E6495A3,
-        0x0eDB8832, 0x79DCB8A4, 0xE0D5E91E, 0x97D2D988, 0x09B64C2B, 0x7EB17CBD, 0xE7B82D07, 0x90BF1D91,
+        0x0EDB8832, 0x79DCB8A4, 0xE0D5E91E, 0x97D2D988, 0x09B64C2B, 0x7EB17CBD, 0xE7B82D07, 0x90BF1D91,
         0x1DB71064, 0x6AB020F2, 0xF3B97148, 0x84BE41DE, 0x1ADAD47D, 0x6DDDE4EB, 0xF4D4B551, 0x83D385C7,
         0x136C9856, 0x646BA8C0, 0xFD62F97A, 0x8A65C9EC, 0x14015C4F, 0x63066CD9, 0xFA0F3D63, 0x8D080DF5,
         0x3B6E20C8, 0x4C69105E, 0xD56041E4, 0xA2677172, 0x3C03E4D1, 0x4B04D447, 0xD20D85FD, 0xA50AB56B,
@@ -2255,15 +4375,420 @@ static unsigned int compute_crc32(unsigned char *buffer, int size)
         0xAED16A4A, 0xD9D65ADC, 0x40DF0B66, 0x37D83BF0, 0xA9BCAE53, 0xDEBB9EC5, 0x47B2CF7F, 0x30B5FFE9,
         0xBDBDF21C, 0xCABAC28A, 0x53B39330, 0x24B4A3A6, 0xBAD03605, 0xCDD70693, 0x54DE5729, 0x23D967BF,
         0xB3667A2E, 0xC4614AB8, 0x5D681B02, 0x2A6F2B94, 0xB40BBE37, 0xC30C8EA1, 0x5A05DF1B, 0x2D02EF8D
-    };
+    },
+    {
+        0x00000000, 0x191B3141, 0x32366282, 0x2B2D53C3, 0x646CC504, 0x7D77F445, 0x565AA786, 0x4F4196C7,
+        0xC8D98A08, 0xD1C2BB49, 0xFAEFE88A, 0xE3F4D9CB, 0xACB54F0C, 0xB5AE7E4D, 0x9E832D8E, 0x87981CCF,
+        0x4AC21251, 0x53D92310, 0x78F470D3, 0x61EF4192, 0x2EAED755, 0x37B5E614, 0x1C98B5D7, 0x05838496,
+        0x821B9859, 0x9B00A918, 0xB02DFADB, 0xA936CB9A, 0xE6775D5D, 0xFF6C6C1C, 0xD4413FDF, 0xCD5A0E9E,
+        0x958424A2, 0x8C9F15E3, 0xA7B24620, 0xBEA97761, 0xF1E8E1A6, 0xE8F3D0E7, 0xC3DE8324, 0xDAC5B265,
+        0x5D5DAEAA, 0x44469FEB, 0x6F6BCC28, 0x7670FD69, 0x39316BAE, 0x202A5AEF, 0x0B07092C, 0x121C386D,
+        0xDF4636F3, 0xC65D07B2, 0xED705471, 0xF46B6530, 0xBB2AF3F7, 0xA231C2B6, 0x891C9175, 0x9007A034,
+        0x179FBCFB, 0x0E848DBA, 0x25A9DE79, 0x3CB2EF38, 0x73F379FF, 0x6AE848BE, 0x41C51B7D, 0x58DE2A3C,
+        0xF0794F05, 0xE9627E44, 0xC24F2D87, 0xDB541CC6, 0x94158A01, 0x8D0EBB40, 0xA623E883, 0xBF38D9C2,
+        0x38A0C50D, 0x21BBF44C, 0x0A96A78F, 0x138D96CE, 0x5CCC0009, 0x45D73148, 0x6EFA628B, 0x77E153CA,
+        0xBABB5D54, 0xA3A06C15, 0x888D3FD6, 0x91960E97, 0xDED79850, 0xC7CCA911, 0xECE1FAD2, 0xF5FACB93,
+        0x7262D75C, 0x6B79E61D, 0x4054B5DE, 0x594F849F, 0x160E1258, 0x0F152319, 0x243870DA, 0x3D23419B,
+        0x65FD6BA7, 0x7CE65AE6, 0x57CB0925, 0x4ED03864, 0x0191AEA3, 0x188A9FE2, 0x33A7CC21, 0x2ABCFD60,
+        0xAD24E1AF, 0xB43FD0EE, 0x9F12832D, 0x8609B26C, 0xC94824AB, 0xD05315EA, 0xFB7E4629, 0xE2657768,
+        0x2F3F79F6, 0x362448B7, 0x1D091B74, 0x04122A35, 0x4B53BCF2, 0x52488DB3, 0x7965DE70, 0x607EEF31,
+        0xE7E6F3FE, 0xFEFDC2BF, 0xD5D0917C, 0xCCCBA03D, 0x838A36FA, 0x9A9107BB, 0xB1BC5478, 0xA8A76539,
+        0x3B83984B, 0x2298A90A, 0x09B5FAC9, 0x10AECB88, 0x5FEF5D4F, 0x46F46C0E, 0x6DD93FCD, 0x74C20E8C,
+        0xF35A1243, 0xEA412302, 0xC16C70C1, 0xD8774180, 0x9736D747, 0x8E2DE606, 0xA500B5C5, 0xBC1B8484,
+        0x71418A1A, 0x685ABB5B, 0x4377E898, 0x5A6CD9D9, 0x152D4F1E, 0x0C367E5F, 0x271B2D9C, 0x3E001CDD,
+        0xB9980012, 0xA0833153, 0x8BAE6290, 0x92B553D1, 0xDDF4C516, 0xC4EFF457, 0xEFC2A794, 0xF6D996D5,
+        0xAE07BCE9, 0xB71C8DA8, 0x9C31DE6B, 0x852AEF2A, 0xCA6B79ED, 0xD37048AC, 0xF85D1B6F, 0xE1462A2E,
+        0x66DE36E1, 0x7FC507A0, 0x54E85463, 0x4DF36522, 0x02B2F3E5, 0x1BA9C2A4, 0x30849167, 0x299FA026,
+        0xE4C5AEB8, 0xFDDE9FF9, 0xD6F3CC3A, 0xCFE8FD7B, 0x80A96BBC, 0x99B25AFD, 0xB29F093E, 0xAB84387F,
+        0x2C1C24B0, 0x350715F1, 0x1E2A4632, 0x07317773, 0x4870E1B4, 0x516BD0F5, 0x7A468336, 0x635DB277,
+        0xCBFAD74E, 0xD2E1E60F, 0xF9CCB5CC, 0xE0D7848D, 0xAF96124A, 0xB68D230B, 0x9DA070C8, 0x84BB4189,
+        0x03235D46, 0x1A386C07, 0x31153FC4, 0x280E0E85, 0x674F9842, 0x7E54A903, 0x5579FAC0, 0x4C62CB81,
+        0x8138C51F, 0x9823F45E, 0xB30EA79D, 0xAA1596DC, 0xE554001B, 0xFC4F315A, 0xD7626299, 0xCE7953D8,
+        0x49E14F17, 0x50FA7E56, 0x7BD72D95, 0x62CC1CD4, 0x2D8D8A13, 0x3496BB52, 0x1FBBE891, 0x06A0D9D0,
+        0x5E7EF3EC, 0x4765C2AD, 0x6C48916E, 0x7553A02F, 0x3A1236E8, 0x230907A9, 0x0824546A, 0x113F652B,
+        0x96A779E4, 0x8FBC48A5, 0xA4911B66, 0xBD8A2A27, 0xF2CBBCE0, 0xEBD08DA1, 0xC0FDDE62, 0xD9E6EF23,
+        0x14BCE1BD, 0x0DA7D0FC, 0x268A833F, 0x3F91B27E, 0x70D024B9, 0x69CB15F8, 0x42E6463B, 0x5BFD777A,
+        0xDC656BB5, 0xC57E5AF4, 0xEE530937, 0xF7483876, 0xB809AEB1, 0xA1129FF0, 0x8A3FCC33, 0x9324FD72
+    },
+    {
+        0x00000000, 0x01C26A37, 0x0384D46E, 0x0246BE59, 0x0709A8DC, 0x06CBC2EB, 0x048D7CB2, 0x054F1685,
+        0x0E1351B8, 0x0FD13B8F, 0x0D9785D6, 0x0C55EFE1, 0x091AF964, 0x08D89353, 0x0A9E2D0A, 0x0B5C473D,
+        0x1C26A370, 0x1DE4C947, 0x1FA2771E, 0x1E601D29, 0x1B2F0BAC, 0x1AED619B, 0x18ABDFC2, 0x1969B5F5,
+        0x1235F2C8, 0x13F798FF, 0x11B126A6, 0x10734C91, 0x153C5A14, 0x14FE3023, 0x16B88E7A, 0x177AE44D,
+        0x384D46E0, 0x398F2CD7, 0x3BC9928E, 0x3A0BF8B9, 0x3F44EE3C, 0x3E86840B, 0x3CC03A52, 0x3D025065,
+        0x365E1758, 0x379C7D6F, 0x35DAC336, 0x3418A901, 0x3157BF84, 0x3095D5B3, 0x32D36BEA, 0x331101DD,
+        0x246BE590, 0x25A98FA7, 0x27EF31FE, 0x262D5BC9, 0x23624D4C, 0x22A0277B, 0x20E69922, 0x2124F315,
+        0x2A78B428, 0x2BBADE1F, 0x29FC6046, 0x283E0A71, 0x2D711CF4, 0x2CB376C3, 0x2EF5C89A, 0x2F37A2AD,
+        0x709A8DC0, 0x7158E7F7, 0x731E59AE, 0x72DC3399, 0x7793251C, 0x76514F2B, 0x7417F172, 0x75D59B45,
+        0x7E89DC78, 0x7F4BB64F, 0x7D0D0816, 0x7CCF6221, 0x798074A4, 0x78421E93, 0x7A04A0CA, 0x7BC6CAFD,
+        0x6CBC2EB0, 0x6D7E4487, 0x6F38FADE, 0x6EFA90E9, 0x6BB5866C, 0x6A77EC5B, 0x68315202, 0x69F33835,
+        0x62AF7F08, 0x636D153F, 0x612BAB66, 0x60E9C151, 0x65A6D7D4, 0x6464BDE3, 0x662203BA, 0x67E0698D,
+        0x48D7CB20, 0x4915A117, 0x4B531F4E, 0x4A917579, 0x4FDE63FC, 0x4E1C09CB, 0x4C5AB792, 0x4D98DDA5,
+        0x46C49A98, 0x4706F0AF, 0x45404EF6, 0x448224C1, 0x41CD3244, 0x400F5873, 0x4249E62A, 0x438B8C1D,
+        0x54F16850, 0x55330267, 0x5775BC3E, 0x56B7D609, 0x53F8C08C, 0x523AAABB, 0x507C14E2, 0x51BE7ED5,
+        0x5AE239E8, 0x5B2053DF, 0x5966ED86, 0x58A487B1, 0x5DEB9134, 0x5C29FB03, 0x5E6F455A, 0x5FAD2F6D,
+        0xE1351B80, 0xE0F771B7, 0xE2B1CFEE, 0xE373A5D9, 0xE63CB35C, 0xE7FED96B, 0xE5B86732, 0xE47A0D05,
+        0xEF264A38, 0xEEE4200F, 0xECA29E56, 0xED60F461, 0xE82FE2E4, 0xE9ED88D3, 0xEBAB368A, 0xEA695CBD,
+        0xFD13B8F0, 0xFCD1D2C7, 0xFE976C9E, 0xFF5506A9, 0xFA1A102C, 0xFBD87A1B, 0xF99EC442, 0xF85CAE75,
+        0xF300E948, 0xF2C2837F, 0xF0843D26, 0xF1465711, 0xF4094194, 0xF5CB2BA3, 0xF78D95FA, 0xF64FFFCD,
+        0xD9785D60, 0xD8BA3757, 0xDAFC890E, 0xDB3EE339, 0xDE71F5BC, 0xDFB39F8B, 0xDDF521D2, 0xDC374BE5,
+        0xD76B0CD8, 0xD6A966EF, 0xD4EFD8B6, 0xD52DB281, 0xD062A404, 0xD1A0CE33, 0xD3E6706A, 0xD2241A5D,
+        0xC55EFE10, 0xC49C9427, 0xC6DA2A7E, 0xC7184049, 0xC25756CC, 0xC3953CFB, 0xC1D382A2, 0xC011E895,
+        0xCB4DAFA8, 0xCA8FC59F, 0xC8C97BC6, 0xC90B11F1, 0xCC440774, 0xCD866D43, 0xCFC0D31A, 0xCE02B92D,
+        0x91AF9640, 0x906DFC77, 0x922B422E, 0x93E92819, 0x96A63E9C, 0x976454AB, 0x9522EAF2, 0x94E080C5,
+        0x9FBCC7F8, 0x9E7EADCF, 0x9C381396, 0x9DFA79A1, 0x98B56F24, 0x99770513, 0x9B31BB4A, 0x9AF3D17D,
+        0x8D893530, 0x8C4B5F07, 0x8E0DE15E, 0x8FCF8B69, 0x8A809DEC, 0x8B42F7DB, 0x89044982, 0x88C623B5,
+        0x839A6488, 0x82580EBF, 0x801EB0E6, 0x81DCDAD1, 0x8493CC54, 0x8551A663, 0x8717183A, 0x86D5720D,
+        0xA9E2D0A0, 0xA820BA97, 0xAA6604CE, 0xABA46EF9, 0xAEEB787C, 0xAF29124B, 0xAD6FAC12, 0xACADC625,
+        0xA7F18118, 0xA633EB2F, 0xA4755576, 0xA5B73F41, 0xA0F829C4, 0xA13A43F3, 0xA37CFDAA, 0xA2BE979D,
+        0xB5C473D0, 0xB40619E7, 0xB640A7BE, 0xB782CD89, 0xB2CDDB0C, 0xB30FB13B, 0xB1490F62, 0xB08B6555,
+        0xBBD72268, 0xBA15485F, 0xB853F606, 0xB9919C31, 0xBCDE8AB4, 0xBD1CE083, 0xBF5A5EDA, 0xBE9834ED
+    },
+    {
+        0x00000000, 0xB8BC6765, 0xAA09C88B, 0x12B5AFEE, 0x8F629757, 0x37DEF032, 0x256B5FDC, 0x9DD738B9,
+        0xC5B428EF, 0x7D084F8A, 0x6FBDE064, 0xD7018701, 0x4AD6BFB8, 0xF26AD8DD, 0xE0DF7733, 0x58631056,
+        0x5019579F, 0xE8A530FA, 0xFA109F14, 0x42ACF871, 0xDF7BC0C8, 0x67C7A7AD, 0x75720843, 0xCDCE6F26,
+        0x95AD7F70, 0x2D111815, 0x3FA4B7FB, 0x8718D09E, 0x1ACFE827, 0xA2738F42, 0xB0C620AC, 0x087A47C9,
+        0xA032AF3E, 0x188EC85B, 0x0A3B67B5, 0xB28700D0, 0x2F503869, 0x97EC5F0C, 0x8559F0E2, 0x3DE59787,
+        0x658687D1, 0xDD3AE0B4, 0xCF8F4F5A, 0x7733283F, 0xEAE41086, 0x525877E3, 0x40EDD80D, 0xF851BF68,
+        0xF02BF8A1, 0x48979FC4, 0x5A22302A, 0xE29E574F, 0x7F496FF6, 0xC7F50893, 0xD540A77D, 0x6DFCC018,
+        0x359FD04E, 0x8D23B72B, 0x9F9618C5, 0x272A7FA0, 0xBAFD4719, 0x0241207C, 0x10F48F92, 0xA848E8F7,
+        0x9B14583D, 0x23A83F58, 0x311D90B6, 0x89A1F7D3, 0x1476CF6A, 0xACCAA80F, 0xBE7F07E1, 0x06C36084,
+        0x5EA070D2, 0xE61C17B7, 0xF4A9B859, 0x4C15DF3C, 0xD1C2E785, 0x697E80E0, 0x7BCB2F0E, 0xC377486B,
+        0xCB0D0FA2, 0x73B168C7, 0x6104C729, 0xD9B8A04C, 0x446F98F5, 0xFCD3FF90, 0xEE66507E, 0x56DA371B,
+        0x0EB9274D, 0xB6054028, 0xA4B0EFC6, 0x1C0C88A3, 0x81DBB01A, 0x3967D77F, 0x2BD27891, 0x936E1FF4,
+        0x3B26F703, 0x839A9066, 0x912F3F88, 0x299358ED, 0xB4446054, 0x0CF80731, 0x1E4DA8DF, 0xA6F1CFBA,
+        0xFE92DFEC, 0x462EB889, 0x549B1767, 0xEC277002, 0x71F048BB, 0xC94C2FDE, 0xDBF98030, 0x6345E755,
+        0x6B3FA09C, 0xD383C7F9, 0xC1366817, 0x798A0F72, 0xE45D37CB, 0x5CE150AE, 0x4E54FF40, 0xF6E89825,
+        0xAE8B8873, 0x1637EF16, 0x048240F8, 0xBC3E279D, 0x21E91F24, 0x99557841, 0x8BE0D7AF, 0x335CB0CA,
+        0xED59B63B, 0x55E5D15E, 0x47507EB0, 0xFFEC19D5, 0x623B216C, 0xDA874609, 0xC832E9E7, 0x708E8E82,
+        0x28ED9ED4, 0x9051F9B1, 0x82E4565F, 0x3A58313A, 0xA78F0983, 0x1F336EE6, 0x0D86C108, 0xB53AA66D,
+        0xBD40E1A4, 0x05FC86C1, 0x1749292F, 0xAFF54E4A, 0x322276F3, 0x8A9E1196, 0x982BBE78, 0x2097D91D,
+        0x78F4C94B, 0xC048AE2E, 0xD2FD01C0, 0x6A4166A5, 0xF7965E1C, 0x4F2A3979, 0x5D9F9697, 0xE523F1F2,
+        0x4D6B1905, 0xF5D77E60, 0xE762D18E, 0x5FDEB6EB, 0xC2098E52, 0x7AB5E937, 0x680046D9, 0xD0BC21BC,
+        0x88DF31EA, 0x3063568F, 0x22D6F961, 0x9A6A9E04, 0x07BDA6BD, 0xBF01C1D8, 0xADB46E36, 0x15080953,
+        0x1D724E9A, 0xA5CE29FF, 0xB77B8611, 0x0FC7E174, 0x9210D9CD, 0x2AACBEA8, 0x38191146, 0x80A57623,
+        0xD8C66675, 0x607A0110, 0x72CFAEFE, 0xCA73C99B, 0x57A4F122, 0xEF189647, 0xFDAD39A9, 0x45115ECC,
+        0x764DEE06, 0xCEF18963, 0xDC44268D, 0x64F841E8, 0xF92F7951, 0x41931E34, 0x5326B1DA, 0xEB9AD6BF,
+        0xB3F9C6E9, 0x0B45A18C, 0x19F00E62, 0xA14C6907, 0x3C9B51BE, 0x842736DB, 0x96929935, 0x2E2EFE50,
+        0x2654B999, 0x9EE8DEFC, 0x8C5D7112, 0x34E11677, 0xA9362ECE, 0x118A49AB, 0x033FE645, 0xBB838120,
+        0xE3E09176, 0x5B5CF613, 0x49E959FD, 0xF1553E98, 0x6C820621, 0xD43E6144, 0xC68BCEAA, 0x7E37A9CF,
+        0xD67F4138, 0x6EC3265D, 0x7C7689B3, 0xC4CAEED6, 0x591DD66F, 0xE1A1B10A, 0xF3141EE4, 0x4BA87981,
+        0x13CB69D7, 0xAB770EB2, 0xB9C2A15C, 0x017EC639, 0x9CA9FE80, 0x241599E5, 0x36A0360B, 0x8E1C516E,
+        0x866616A7, 0x3EDA71C2, 0x2C6FDE2C, 0x94D3B949, 0x090481F0, 0xB1B8E695, 0xA30D497B, 0x1BB12E1E,
+        0x43D23E48, 0xFB6E592D, 0xE9DBF6C3, 0x516791A6, 0xCCB0A91F, 0x740CCE7A, 0x66B96194, 0xDE0506F1
+    },
+    {
+        0x00000000, 0x3D6029B0, 0x7AC05360, 0x47A07AD0, 0xF580A6C0, 0xC8E08F70, 0x8F40F5A0, 0xB220DC10,
+        0x30704BC1, 0x0D106271, 0x4AB018A1, 0x77D03111, 0xC5F0ED01, 0xF890C4B1, 0xBF30BE61, 0x825097D1,
+        0x60E09782, 0x5D80BE32, 0x1A20C4E2, 0x2740ED52, 0x95603142, 0xA80018F2, 0xEFA06222, 0xD2C04B92,
+        0x5090DC43, 0x6DF0F5F3, 0x2A508F23, 0x1730A693, 0xA5107A83, 0x98705333, 0xDFD029E3, 0xE2B00053,
+        0xC1C12F04, 0xFCA106B4, 0xBB017C64, 0x866155D4, 0x344189C4, 0x0921A074, 0x4E81DAA4, 0x73E1F314,
+        0xF1B164C5, 0xCCD14D75, 0x8B7137A5, 0xB6111E15, 0x0431C205, 0x3951EBB5, 0x7EF19165, 0x4391B8D5,
+        0xA121B886, 0x9C419136, 0xDBE1EBE6, 0xE681C256, 0x54A11E46, 0x69C137F6, 0x2E614D26, 0x13016496,
+        0x9151F347, 0xAC31DAF7, 0xEB91A027, 0xD6F18997, 0x64D15587, 0x59B17C37, 0x1E1106E7, 0x23712F57,
+        0x58F35849, 0x659371F9, 0x22330B29, 0x1F532299, 0xAD73FE89, 0x9013D739, 0xD7B3ADE9, 0xEAD38459,
+        0x68831388, 0x55E33A38, 0x124340E8, 0x2F236958, 0x9D03B548, 0xA0639CF8, 0xE7C3E628, 0xDAA3CF98,
+        0x3813CFCB, 0x0573E67B, 0x42D39CAB, 0x7FB3B51B, 0xCD93690B, 0xF0F340BB, 0xB7533A6B, 0x8A3313DB,
+        0x0863840A, 0x3503ADBA, 0x72A3D76A, 0x4FC3FEDA, 0xFDE322CA, 0xC0830B7A, 0x872371AA, 0xBA43581A,
+        0x9932774D, 0xA4525EFD, 0xE3F2242D, 0xDE920D9D, 0x6CB2D18D, 0x51D2F83D, 0x167282ED, 0x2B12AB5D,
+        0xA9423C8C, 0x9422153C, 0xD3826FEC, 0xEEE2465C, 0x5CC29A4C, 0x61A2B3FC, 0x2602C92C, 0x1B62E09C,
+        0xF9D2E0CF, 0xC4B2C97F, 0x8312B3AF, 0xBE729A1F, 0x0C52460F, 0x31326FBF, 0x7692156F, 0x4BF23CDF,
+        0xC9A2AB0E, 0xF4C282BE, 0xB362F86E, 0x8E02D1DE, 0x3C220DCE, 0x0142247E, 0x46E25EAE, 0x7B82771E,
+        0xB1E6B092, 0x8C869922, 0xCB26E3F2, 0xF646CA42, 0x44661652, 0x79063FE2, 0x3EA64532, 0x03C66C82,
+        0x8196FB53, 0xBCF6D2E3, 0xFB56A833, 0xC6368183, 0x74165D93, 0x49767423, 0x0ED60EF3, 0x33B62743,
+        0xD1062710, 0xEC660EA0, 0xABC67470, 0x96A65DC0, 0x248681D0, 0x19E6A860, 0x5E46D2B0, 0x6326FB00,
+        0xE1766CD1, 0xDC164561, 0x9BB63FB1, 0xA6D61601, 0x14F6CA11, 0x2996E3A1, 0x6E369971, 0x5356B0C1,
+        0x70279F96, 0x4D47B626, 0x0AE7CCF6, 0x3787E546, 0x85A73956, 0xB8C710E6, 0xFF676A36, 0xC2074386,
+        0x4057D457, 0x7D37FDE7, 0x3A978737, 0x07F7AE87, 0xB5D77297, 0x88B75B27, 0xCF1721F7, 0xF2770847,
+        0x10C70814, 0x2DA721A4, 0x6A075B74, 0x576772C4, 0xE547AED4, 0xD8278764, 0x9F87FDB4, 0xA2E7D404,
+        0x20B743D5, 0x1DD76A65, 0x5A7710B5, 0x67173905, 0xD537E515, 0xE857CCA5, 0xAFF7B675, 0x92979FC5,
+        0xE915E8DB, 0xD475C16B, 0x93D5BBBB, 0xAEB5920B, 0x1C954E1B, 0x21F567AB, 0x66551D7B, 0x5B3534CB,
+        0xD965A31A, 0xE4058AAA, 0xA3A5F07A, 0x9EC5D9CA, 0x2CE505DA, 0x11852C6A, 0x562556BA, 0x6B457F0A,
+        0x89F57F59, 0xB49556E9, 0xF3352C39, 0xCE550589, 0x7C75D999, 0x4115F029, 0x06B58AF9, 0x3BD5A349,
+        0xB9853498, 0x84E51D28, 0xC34567F8, 0xFE254E48, 0x4C059258, 0x7165BBE8, 0x36C5C138, 0x0BA5E888,
+        0x28D4C7DF, 0x15B4EE6F, 0x521494BF, 0x6F74BD0F, 0xDD54611F, 0xE03448AF, 0xA794327F, 0x9AF41BCF,
+        0x18A48C1E, 0x25C4A5AE, 0x6264DF7E, 0x5F04F6CE, 0xED242ADE, 0xD044036E, 0x97E479BE, 0xAA84500E,
+        0x4834505D, 0x755479ED, 0x32F4033D, 0x0F942A8D, 0xBDB4F69D, 0x80D4DF2D, 0xC774A5FD, 0xFA148C4D,
+        0x78441B9C, 0x4524322C, 0x028448FC, 0x3FE4614C, 0x8DC4BD5C, 0xB0A494EC, 0xF704EE3C, 0xCA64C78C
+    },
+    {
+        0x00000000, 0xCB5CD3A5, 0x4DC8A10B, 0x869472AE, 0x9B914216, 0x50CD91B3, 0xD659E31D, 0x1D0530B8,
+        0xEC53826D, 0x270F51C8, 0xA19B2366, 0x6AC7F0C3, 0x77C2C07B, 0xBC9E13DE, 0x3A0A6170, 0xF156B2D5,
+        0x03D6029B, 0xC88AD13E, 0x4E1EA390, 0x85427035, 0x9847408D, 0x531B9328, 0xD58FE186, 0x1ED33223,
+        0xEF8580F6, 0x24D95353, 0xA24D21FD, 0x6911F258, 0x7414C2E0, 0xBF481145, 0x39DC63EB, 0xF280B04E,
+        0x07AC0536, 0xCCF0D693, 0x4A64A43D, 0x81387798, 0x9C3D4720, 0x57619485, 0xD1F5E62B, 0x1AA9358E,
+        0xEBFF875B, 0x20A354FE, 0xA6372650, 0x6D6BF5F5, 0x706EC54D, 0xBB3216E8, 0x3DA66446, 0xF6FAB7E3,
+        0x047A07AD, 0xCF26D408, 0x49B2A6A6, 0x82EE7503, 0x9FEB45BB, 0x54B7961E, 0xD223E4B0, 0x197F3715,
+        0xE82985C0, 0x23755665, 0xA5E124CB, 0x6EBDF76E, 0x73B8C7D6, 0xB8E41473, 0x3E7066DD, 0xF52CB578,
+        0x0F580A6C, 0xC404D9C9, 0x4290AB67, 0x89CC78C2, 0x94C9487A, 0x5F959BDF, 0xD901E971, 0x125D3AD4,
+        0xE30B8801, 0x28575BA4, 0xAEC3290A, 0x659FFAAF, 0x789ACA17, 0xB3C619B2, 0x35526B1C, 0xFE0EB8B9,
+        0x0C8E08F7, 0xC7D2DB52, 0x4146A9FC, 0x8A1A7A59, 0x971F4AE1, 0x5C439944, 0xDAD7EBEA, 0x118B384F,
+        0xE0DD8A9A, 0x2B81593F, 0xAD152B91, 0x6649F834, 0x7B4CC88C, 0xB0101B29, 0x36846987, 0xFDD8BA22,
+        0x08F40F5A, 0xC3A8DCFF, 0x453CAE51, 0x8E607DF4, 0x93654D4C, 0x58399EE9, 0xDEADEC47, 0x15F13FE2,
+        0xE4A78D37, 0x2FFB5E92, 0xA96F2C3C, 0x6233FF99, 0x7F36CF21, 0xB46A1C84, 0x32FE6E2A, 0xF9A2BD8F,
+        0x0B220DC1, 0xC07EDE64, 0x46EAACCA, 0x8DB67F6F, 0x90B34FD7, 0x5BEF9C72, 0xDD7BEEDC, 0x16273D79,
+        0xE7718FAC, 0x2C2D5C09, 0xAAB92EA7, 0x61E5FD02, 0x7CE0CDBA, 0xB7BC1E1F, 0x31286CB1, 0xFA74BF14,
+        0x1EB014D8, 0xD5ECC77D, 0x5378B5D3, 0x98246676, 0x852156CE, 0x4E7D856B, 0xC8E9F7C5, 0x03B52460,
+        0xF2E396B5, 0x39BF4510, 0xBF2B37BE, 0x7477E41B, 0x6972D4A3, 0xA22E0706, 0x24BA75A8, 0xEFE6A60D,
+        0x1D661643, 0xD63AC5E6, 0x50AEB748, 0x9BF264ED, 0x86F75455, 0x4DAB87F0, 0xCB3FF55E, 0x006326FB,
+        0xF135942E, 0x3A69478B, 0xBCFD3525, 0x77A1E680, 0x6AA4D638, 0xA1F8059D, 0x276C7733, 0xEC30A496,
+        0x191C11EE, 0xD240C24B, 0x54D4B0E5, 0x9F886340, 0x828D53F8, 0x49D1805D, 0xCF45F2F3, 0x04192156,
+        0xF54F9383, 0x3E134026, 0xB8873288, 0x73DBE12D, 0x6EDED195, 0xA5820230, 0x2316709E, 0xE84AA33B,
+        0x1ACA1375, 0xD196C0D0, 0x5702B27E, 0x9C5E61DB, 0x815B5163, 0x4A0782C6, 0xCC93F068, 0x07CF23CD,
+        0xF6999118, 0x3DC542BD, 0xBB513013, 0x700DE3B6, 0x6D08D30E, 0xA65400AB, 0x20C07205, 0xEB9CA1A0,
+        0x11E81EB4, 0xDAB4CD11, 0x5C20BFBF, 0x977C6C1A, 0x8A795CA2, 0x41258F07, 0xC7B1FDA9, 0x0CED2E0C,
+        0xFDBB9CD9, 0x36E74F7C, 0xB0733DD2, 0x7B2FEE77, 0x662ADECF, 0xAD760D6A, 0x2BE27FC4, 0xE0BEAC61,
+        0x123E1C2F, 0xD962CF8A, 0x5FF6BD24, 0x94AA6E81, 0x89AF5E39, 0x42F38D9C, 0xC467FF32, 0x0F3B2C97,
+        0xFE6D9E42, 0x35314DE7, 0xB3A53F49, 0x78F9ECEC, 0x65FCDC54, 0xAEA00FF1, 0x28347D5F, 0xE368AEFA,
+        0x16441B82, 0xDD18C827, 0x5B8CBA89, 0x90D0692C, 0x8DD55994, 0x46898A31, 0xC01DF89F, 0x0B412B3A,
+        0xFA1799EF, 0x314B4A4A, 0xB7DF38E4, 0x7C83EB41, 0x6186DBF9, 0xAADA085C, 0x2C4E7AF2, 0xE712A957,
+        0x15921919, 0xDECECABC, 0x585AB812, 0x93066BB7, 0x8E035B0F, 0x455F88AA, 0xC3CBFA04, 0x089729A1,
+        0xF9C19B74, 0x329D48D1, 0xB4093A7F, 0x7F55E9DA, 0x6250D962, 0xA90C0AC7, 0x2F987869, 0xE4C4ABCC
+    },
+    {
+        0x00000000, 0xA6770BB4, 0x979F1129, 0x31E81A9D, 0xF44F2413, 0x52382FA7, 0x63D0353A, 0xC5A73E8E,
+        0x33EF4E67, 0x959845D3, 0xA4705F4E, 0x020754FA, 0xC7A06A74, 0x61D761C0, 0x503F7B5D, 0xF64870E9,
+        0x67DE9CCE, 0xC1A9977A, 0xF0418DE7, 0x56368653, 0x9391B8DD, 0x35E6B369, 0x040EA9F4, 0xA279A240,
+        0x5431D2A9, 0xF246D91D, 0xC3AEC380, 0x65D9C834, 0xA07EF6BA, 0x0609FD0E, 0x37E1E793, 0x9196EC27,
+        0xCFBD399C, 0x69CA3228, 0x582228B5, 0xFE552301, 0x3BF21D8F, 0x9D85163B, 0xAC6D0CA6, 0x0A1A0712,
+        0xFC5277FB, 0x5A257C4F, 0x6BCD66D2, 0xCDBA6D66, 0x081D53E8, 0xAE6A585C, 0x9F8242C1, 0x39F54975,
+        0xA863A552, 0x0E14AEE6, 0x3FFCB47B, 0x998BBFCF, 0x5C2C8141, 0xFA5B8AF5, 0xCBB39068, 0x6DC49BDC,
+        0x9B8CEB35, 0x3DFBE081, 0x0C13FA1C, 0xAA64F1A8, 0x6FC3CF26, 0xC9B4C492, 0xF85CDE0F, 0x5E2BD5BB,
+        0x440B7579, 0xE27C7ECD, 0xD3946450, 0x75E36FE4, 0xB044516A, 0x16335ADE, 0x27DB4043, 0x81AC4BF7,
+        0x77E43B1E, 0xD19330AA, 0xE07B2A37, 0x460C2183, 0x83AB1F0D, 0x25DC14B9, 0x14340E24, 0xB2430590,
+        0x23D5E9B7, 0x85A2E203, 0xB44AF89E, 0x123DF32A, 0xD79ACDA4, 0x71EDC610, 0x4005DC8D, 0xE672D739,
+        0x103AA7D0, 0xB64DAC64, 0x87A5B6F9, 0x21D2BD4D, 0xE47583C3, 0x42028877, 0x73EA92EA, 0xD59D995E,
+        0x8BB64CE5, 0x2DC14751, 0x1C295DCC, 0xBA5E5678, 0x7FF968F6, 0xD98E6342, 0xE86679DF, 0x4E11726B,
+        0xB8590282, 0x1E2E0936, 0x2FC613AB, 0x89B1181F, 0x4C162691, 0xEA612D25, 0xDB8937B8, 0x7DFE3C0C,
+        0xEC68D02B, 0x4A1FDB9F, 0x7BF7C102, 0xDD80CAB6, 0x1827F438, 0xBE50FF8C, 0x8FB8E511, 0x29CFEEA5,
+        0xDF879E4C, 0x79F095F8, 0x48188F65, 0xEE6F84D1, 0x2BC8BA5F, 0x8DBFB1EB, 0xBC57AB76, 0x1A20A0C2,
+        0x8816EAF2, 0x2E61E146, 0x1F89FBDB, 0xB9FEF06F, 0x7C59CEE1, 0xDA2EC555, 0xEBC6DFC8, 0x4DB1D47C,
+        0xBBF9A495, 0x1D8EAF21, 0x2C66B5BC, 0x8A11BE08, 0x4FB68086, 0xE9C18B32, 0xD82991AF, 0x7E5E9A1B,
+        0xEFC8763C, 0x49BF7D88, 0x78576715, 0xDE206CA1, 0x1B87522F, 0xBDF0599B, 0x8C184306, 0x2A6F48B2,
+        0xDC27385B, 0x7A5033EF, 0x4BB82972, 0xEDCF22C6, 0x28681C48, 0x8E1F17FC, 0xBFF70D61, 0x198006D5,
+        0x47ABD36E, 0xE1DCD8DA, 0xD034C247, 0x7643C9F3, 0xB3E4F77D, 0x1593FCC9, 0x247BE654, 0x820CEDE0,
+        0x74449D09, 0xD23396BD, 0xE3DB8C20, 0x45AC8794, 0x800BB91A, 0x267CB2AE, 0x1794A833, 0xB1E3A387,
+        0x20754FA0, 0x86024414, 0xB7EA5E89, 0x119D553D, 0xD43A6BB3, 0x724D6007, 0x43A57A9A, 0xE5D2712E,
+        0x139A01C7, 0xB5ED0A73, 0x840510EE, 0x22721B5A, 0xE7D525D4, 0x41A22E60, 0x704A34FD, 0xD63D3F49,
+        0xCC1D9F8B, 0x6A6A943F, 0x5B828EA2, 0xFDF58516, 0x3852BB98, 0x9E25B02C, 0xAFCDAAB1, 0x09BAA105,
+        0xFFF2D1EC, 0x5985DA58, 0x686DC0C5, 0xCE1ACB71, 0x0BBDF5FF, 0xADCAFE4B, 0x9C22E4D6, 0x3A55EF62,
+        0xABC30345, 0x0DB408F1, 0x3C5C126C, 0x9A2B19D8, 0x5F8C2756, 0xF9FB2CE2, 0xC813367F, 0x6E643DCB,
+        0x982C4D22, 0x3E5B4696, 0x0FB35C0B, 0xA9C457BF, 0x6C636931, 0xCA146285, 0xFBFC7818, 0x5D8B73AC,
+        0x03A0A617, 0xA5D7ADA3, 0x943FB73E, 0x3248BC8A, 0xF7EF8204, 0x519889B0, 0x6070932D, 0xC6079899,
+        0x304FE870, 0x9638E3C4, 0xA7D0F959, 0x01A7F2ED, 0xC400CC63, 0x6277C7D7, 0x539FDD4A, 0xF5E8D6FE,
+        0x647E3AD9, 0xC209316D, 0xF3E12BF0, 0x55962044, 0x90311ECA, 0x3646157E, 0x07AE0FE3, 0xA1D90457,
+        0x579174BE, 0xF1E67F0A, 0xC00E6597, 0x66796E23, 0xA3DE50AD, 0x05A95B19, 0x34414184, 0x92364A30
+    },
+    {
+        0x00000000, 0xCCAA009E, 0x4225077D, 0x8E8F07E3, 0x844A0EFA, 0x48E00E64, 0xC66F0987, 0x0AC50919,
+        0xD3E51BB5, 0x1F4F1B2B, 0x91C01CC8, 0x5D6A1C56, 0x57AF154F, 0x9B0515D1, 0x158A1232, 0xD92012AC,
+        0x7CBB312B, 0xB01131B5, 0x3E9E3656, 0xF23436C8, 0xF8F13FD1, 0x345B3F4F, 0xBAD438AC, 0x767E3832,
+        0xAF5E2A9E, 0x63F42A00, 0xED7B2DE3, 0x21D12D7D, 0x2B142464, 0xE7BE24FA, 0x69312319, 0xA59B2387,
+        0xF9766256, 0x35DC62C8, 0xBB53652B, 0x77F965B5, 0x7D3C6CAC, 0xB1966C32, 0x3F196BD1, 0xF3B36B4F,
+        0x2A9379E3, 0xE639797D, 0x68B67E9E, 0xA41C7E00, 0xAED97719, 0x62737787, 0xECFC7064, 0x205670FA,
+        0x85CD537D, 0x496753E3, 0xC7E85400, 0x0B42549E, 0x01875D87, 0xCD2D5D19, 0x43A25AFA, 0x8F085A64,
+        0x562848C8, 0x9A824856, 0x140D4FB5, 0xD8A74F2B, 0xD2624632, 0x1EC846AC, 0x9047414F, 0x5CED41D1,
+        0x299DC2ED, 0xE537C273, 0x6BB8C590, 0xA712C50E, 0xADD7CC17, 0x617DCC89, 0xEFF2CB6A, 0x2358CBF4,
+        0xFA78D958, 0x36D2D9C6, 0xB85DDE25, 0x74F7DEBB, 0x7E32D7A2, 0xB298D73C, 0x3C17D0DF, 0xF0BDD041,
+        0x5526F3C6, 0x998CF358, 0x1703F4BB, 0xDBA9F425, 0xD16CFD3C, 0x1DC6FDA2, 0x9349FA41, 0x5FE3FADF,
+        0x86C3E873, 0x4A69E8ED, 0xC4E6EF0E, 0x084CEF90, 0x0289E689, 0xCE23E617, 0x40ACE1F4, 0x8C06E16A,
+        0xD0EBA0BB, 0x1C41A025, 0x92CEA7C6, 0x5E64A758, 0x54A1AE41, 0x980BAEDF, 0x1684A93C, 0xDA2EA9A2,
+        0x030EBB0E, 0xCFA4BB90, 0x412BBC73, 0x8D81BCED, 0x8744B5F4, 0x4BEEB56A, 0xC561B289, 0x09CBB217,
+        0xAC509190, 0x60FA910E, 0xEE7596ED, 0x22DF9673, 0x281A9F6A, 0xE4B09FF4, 0x6A3F9817, 0xA6959889,
+        0x7FB58A25, 0xB31F8ABB, 0x3D908D58, 0xF13A8DC6, 0xFBFF84DF, 0x37558441, 0xB9DA83A2, 0x7570833C,
+        0x533B85DA, 0x9F918544, 0x111E82A7, 0xDDB48239, 0xD7718B20, 0x1BDB8BBE, 0x95548C5D, 0x59FE8CC3,
+        0x80DE9E6F, 0x4C749EF1, 0xC2FB9912, 0x0E51998C, 0x04949095, 0xC83E900B, 0x46B197E8, 0x8A1B9776,
+        0x2F80B4F1, 0xE32AB46F, 0x6DA5B38C, 0xA10FB312, 0xABCABA0B, 0x6760BA95, 0xE9EFBD76, 0x2545BDE8,
+        0xFC65AF44, 0x30CFAFDA, 0xBE40A839, 0x72EAA8A7, 0x782FA1BE, 0xB485A120, 0x3A0AA6C3, 0xF6A0A65D,
+        0xAA4DE78C, 0x66E7E712, 0xE868E0F1, 0x24C2E06F, 0x2E07E976, 0xE2ADE9E8, 0x6C22EE0B, 0xA088EE95,
+        0x79A8FC39, 0xB502FCA7, 0x3B8DFB44, 0xF727FBDA, 0xFDE2F2C3, 0x3148F25D, 0xBFC7F5BE, 0x736DF520,
+        0xD6F6D6A7, 0x1A5CD639, 0x94D3D1DA, 0x5879D144, 0x52BCD85D, 0x9E16D8C3, 0x1099DF20, 0xDC33DFBE,
+        0x0513CD12, 0xC9B9CD8C, 0x4736CA6F, 0x8B9CCAF1, 0x8159C3E8, 0x4DF3C376, 0xC37CC495, 0x0FD6C40B,
+        0x7AA64737, 0xB60C47A9, 0x3883404A, 0xF42940D4, 0xFEEC49CD, 0x32464953, 0xBCC94EB0, 0x70634E2E,
+        0xA9435C82, 0x65E95C1C, 0xEB665BFF, 0x27CC5B61, 0x2D095278, 0xE1A352E6, 0x6F2C5505, 0xA386559B,
+        0x061D761C, 0xCAB77682, 0x44387161, 0x889271FF, 0x825778E6, 0x4EFD7878, 0xC0727F9B, 0x0CD87F05,
+        0xD5F86DA9, 0x19526D37, 0x97DD6AD4, 0x5B776A4A, 0x51B26353, 0x9D1863CD, 0x1397642E, 0xDF3D64B0,
+        0x83D02561, 0x4F7A25FF, 0xC1F5221C, 0x0D5F2282, 0x079A2B9B, 0xCB302B05, 0x45BF2CE6, 0x89152C78,
+        0x50353ED4, 0x9C9F3E4A, 0x121039A9, 0xDEBA3937, 0xD47F302E, 0x18D530B0, 0x965A3753, 0x5AF037CD,
+        0xFF6B144A, 0x33C114D4, 0xBD4E1337, 0x71E413A9, 0x7B211AB0, 0xB78B1A2E, 0x39041DCD, 0xF5AE1D53,
+        0x2C8E0FFF, 0xE0240F61, 0x6EAB0882, 0xA201081C, 0xA8C40105, 0x646E019B, 0xEAE10678, 0x264B06E6
+    }
+};
+#if defined(RPNG_CRC32_PCLMUL)
+// Check CPU support for carry-less multiplication (PCLMULQDQ), checked once
+static bool rpng_cpu_has_pclmul(void)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    static int supported = -1;      // NOTE: Same value written by any thread
 
-    unsigned int crc = ~0u;
+    if (supported == -1)
+    {
+        int info[4] = { 0 };
+        __cpuid(info, 1);
+        supported = ((info[2] >> 1) & 1);     // CPUID.01H:ECX.PCLMULQDQ[bit 1]
+    }
+
+    return (supported == 1);
+#else
+    return __builtin_cpu_supports("pclmul");
+#endif
+}
+
+// Compute CRC32 (not inverted) of 16 bytes blocks using carry-less multiplication folding
+// NOTE: Data size must be a multiple of 16 and at least 64 bytes, Intel paper:
+// "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction" (constants for reflected polynomial)
+RPNG_TARGET_PCLMUL static unsigned int update_crc32_pclmul(unsigned int crc, const unsigned char *buffer, int size)
+{
+    const __m128i k1k2 = _mm_set_epi32(0x00000001, 0xc6e41596, 0x00000001, 0x54442bd4);
+    const __m128i k3k4 = _mm_set_epi32(0x00000000, 0xccaa009e, 0x00000001, 0x751997d0);
+    const __m128i k5k0 = _mm_set_epi32(0x00000000, 0x00000000, 0x00000001, 0x63cd6124);
+    const __m128i poly = _mm_set_epi32(0x00000001, 0xf7011641, 0x00000001, 0xdb710641);
+    const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+
+    __m128i x1 = _mm_loadu_si128((const __m128i *)(const void *)(buffer + 0));
+    __m128i x2 = _mm_loadu_si128((const __m128i *)(const void *)(buffer + 16));
+    __m128i x3 = _mm_loadu_si128((const __m128i *)(const void *)(buffer + 32));
+    __m128i x4 = _mm_loadu_si128((const __m128i *)(const void *)(buffer + 48));
+    __m128i x5, x6, x7, x8;
+
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+    buffer += 64;
+    size -= 64;
+
+    // Fold 64 bytes per step (4 independent lanes)
+    while (size >= 64)
+    {
+        x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+        x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+        x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+        x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+
+        x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i *)(const void *)(buffer + 0)));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i *)(const void *)(buffer + 16)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i *)(const void *)(buffer + 32)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i *)(const void *)(buffer + 48)));
+
+        buffer += 64;
+        size -= 64;
+    }
+
+    // Fold 4 lanes into 1 lane
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x2), x5);
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x3), x5);
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x4), x5);
+
+    // Fold remaining 16 bytes blocks
+    while (size >= 16)
+    {
+        x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+        x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), _mm_loadu_si128((const __m128i *)(const void *)buffer)), x5);
+
+        buffer += 16;
+        size -= 16;
+    }
+
+    // Fold 128 bits into 64 bits
+    x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask32);
+    x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, k5k0, 0x00), x2);
+
+    // Barrett reduction to 32 bits
+    x2 = _mm_and_si128(x1, mask32);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+    x2 = _mm_and_si128(x2, mask32);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return (unsigned int)_mm_cvtsi128_si32(_mm_srli_si128(x1, 4));
+}
+#endif
+
+#if defined(RPNG_CRC32_ARM)
+// Compute CRC32 (not inverted) using ARMv8 CRC32 instructions (same polynomial)
+static unsigned int update_crc32_arm(unsigned int crc, const unsigned char *buffer, int size)
+{
+    for (; size >= 8; size -= 8, buffer += 8)
+    {
+        unsigned long long value = 0;
+        memcpy(&value, buffer, 8);      // NOTE: AArch64 instructions expect little-endian value
+        crc = __crc32d(crc, value);
+    }
+
+    for (; size > 0; size--, buffer++) crc = __crc32b(crc, *buffer);
+
+    return crc;
+}
+#endif
+
+// Compute CRC32, continued from provided value (0 for initial value)
+// NOTE: Hardware accelerated if available (PCLMULQDQ checked at runtime, ARMv8 CRC32 at compile time),
+// slice-by-8 tables used otherwise, all paths produce same result
+static unsigned int update_crc32(unsigned int crc, const unsigned char *buffer, int size)
+{
+    crc = ~crc;
+
+#if defined(RPNG_CRC32_PCLMUL)
+    if ((size >= 64) && rpng_cpu_has_pclmul())
+    {
+        int blocks_size = size & ~15;
+        crc = update_crc32_pclmul(crc, buffer, blocks_size);
+        buffer += blocks_size;
+        size -= blocks_size;
+    }
+#elif defined(RPNG_CRC32_ARM)
+    return ~update_crc32_arm(crc, buffer, size);
+#endif
+
+    // Slice-by-8: 8 bytes per step, bytes combined in little-endian order (endianness independent)
+    for (; size >= 8; size -= 8, buffer += 8)
+    {
+        unsigned int low = crc ^ ((unsigned int)buffer[0] | ((unsigned int)buffer[1] << 8) | ((unsigned int)buffer[2] << 16) | ((unsigned int)buffer[3] << 24));
+        unsigned int high = (unsigned int)buffer[4] | ((unsigned int)buffer[5] << 8) | ((unsigned int)buffer[6] << 16) | ((unsigned int)buffer[7] << 24);
+
+        crc = rpng_crc32_table[7][low & 0xff] ^ rpng_crc32_table[6][(low >> 8) & 0xff] ^
+              rpng_crc32_table[5][(low >> 16) & 0xff] ^ rpng_crc32_table[4][low >> 24] ^
+              rpng_crc32_table[3][high & 0xff] ^ rpng_crc32_table[2][(high >> 8) & 0xff] ^
+              rpng_crc32_table[1][(high >> 16) & 0xff] ^ rpng_crc32_table[0][high >> 24];
+    }
 
-    for (int i = 0; i < size; i++) crc = (crc >> 8) ^ crc_table[buffer[i] ^ (crc & 0xff)];
+    for (; size > 0; size--, buffer++) crc = (crc >> 8) ^ rpng_crc32_table[0][(*buffer ^ crc) & 0xff];
 
     return ~crc;
 }
 
+// Compute Adler-32 (zlib checksum), continued from provided value (1 for initial value)
+static unsigned int update_adler32(unsigned int adler, const unsigned char *buffer, int size)
+{
+    unsigned int a = adler & 0xffff;
+    unsigned int b = adler >> 16;
+
+    while (size > 0)
+    {
+        int block = (size < 5552)? size : 5552;     // Max bytes without modulo overflow
+        size -= block;
+
+        for (int i = 0; i < block; i++) { a += buffer[i]; b += a; }
+        buffer += block;
+
+        a %= 65521;
+        b %= 65521;
+    }
+
+    return (b << 16) | a;
+}
+
 // Load data from file into a buffer
 static char *load_file_to_buffer(const char *filename, int *bytes_read)
 {
@@ -2362,12 +4887,12 @@ static bool file_exists(const char *filename)
     return result;
 }
 
-#if defined(RPNG_DEFLATE_IMPLEMENTATION)
-
 //=========================================================================
 //                              SDEFL
 // DEFLATE COMPRESSION algorithm: https://github.com/vurtun/lib/sdefl.h
 //=========================================================================
+// NOTE: sdefl internal functions are static and always included (required by sdefl_compr_range()),
+// public functions (sdeflate(), zsdeflate(), sdefl_bound()) only with RPNG_DEFLATE_IMPLEMENTATION
 #ifdef SDEFL_IMPLEMENTATION
 
 #include <assert.h> /* assert */
@@ -2853,18 +5378,27 @@ sdefl_fnd(struct sdefl_match *m, const struct sdefl *s, int chain_len,
     i = s->prv[i & SDEFL_WIN_MSK];
   }
 }
+/* rpng: compress [begin,in_len) of input, [dict,begin) used as dictionary,
+ * non last ranges end with a one byte stored block to get byte aligned,
+ * empty stored blocks (sync flush) are not accepted by sinfl */
 static int
-sdefl_compr(struct sdefl *s, unsigned char *out, const unsigned char *in,
-            int in_len, int lvl) {
+sdefl_compr_range(struct sdefl *s, unsigned char *out, const unsigned char *in,
+            int dict, int begin, int in_len, int lvl, int is_last) {
   unsigned char *q = out;
   static const unsigned char pref[] = {8,10,14,24,30,48,65,96,130};
   int max_chain = (lvl < 8) ? (1 << (lvl + 1)): (1 << 13);
-  int n, i = 0, litlen = 0;
+  int n, i = begin, litlen = 0;
+  int end = is_last ? in_len : in_len - 1;
   for (n = 0; n < SDEFL_HASH_SIZ; ++n) {
     s->tbl[n] = SDEFL_NIL;
   }
+  for (n = dict; n < begin && n + SDEFL_MIN_MATCH < in_len; ++n) {
+    unsigned h = sdefl_hash32(&in[n]);
+    s->prv[n&SDEFL_WIN_MSK] = s->tbl[h];
+    s->tbl[h] = n;
+  }
   do {int blk_begin = i;
-    int blk_end = ((i + SDEFL_BLK_MAX) < in_len) ? (i + SDEFL_BLK_MAX) : in_len;
+    int blk_end = ((i + SDEFL_BLK_MAX) < end) ? (i + SDEFL_BLK_MAX) : end;
     while (i < blk_end) {
       struct sdefl_match m = {0};
       int left = blk_end - i;
@@ -2912,14 +5446,30 @@ sdefl_compr(struct sdefl *s, unsigned char *out, const unsigned char *in,
       sdefl_seq(s, i - litlen, litlen);
       litlen = 0;
     }
-    sdefl_flush(&q, s, blk_end == in_len, in, blk_begin, blk_end);
-  } while (i < in_len);
+    sdefl_flush(&q, s, is_last && blk_end == end, in, blk_begin, blk_end);
+  } while (i < end);
+  if (!is_last) {
+    sdefl_put(&q, s, 0x00, 1); /* block */
+    sdefl_put(&q, s, 0x00, 2); /* stored block */
+    if (s->bitcnt) {
+      sdefl_put(&q, s, 0x00, 8 - s->bitcnt);
+    }
+    sdefl_put16(&q, 0x0001);
+    sdefl_put16(&q, 0xfffe);
+    *q++ = in[end];
+  }
   if (s->bitcnt) {
     sdefl_put(&q, s, 0x00, 8 - s->bitcnt);
   }
   assert(s->bitcnt == 0);
   return (int)(q - out);
 }
+#if defined(RPNG_DEFLATE_IMPLEMENTATION)
+static int
+sdefl_compr(struct sdefl *s, unsigned char *out, const unsigned char *in,
+            int in_len, int lvl) {
+  return sdefl_compr_range(s, out, in, 0, 0, in_len, lvl, 1);
+}
 extern int
 sdeflate(struct sdefl *s, void *out, const void *in, int n, int lvl) {
   s->bits = s->bitcnt = 0;
@@ -2977,12 +5527,15 @@ zsdeflate(struct sdefl *s, void *out, const void *in, int n, int lvl) {
 }
 extern int
 sdefl_bound(int len) {
-  int max_blocks = 1 + sdefl_div_round_up(len, SDEFL_RAW_BLK_SIZE);
+  /* rpng: every compression block (SDEFL_BLK_MAX) can add one more stored block */
+  int max_blocks = 1 + sdefl_div_round_up(len, SDEFL_RAW_BLK_SIZE) + sdefl_div_round_up(len, SDEFL_BLK_MAX);
   int bound = 5 * max_blocks + len + 1 + 4 + 8;
   return bound;
 }
+#endif /* RPNG_DEFLATE_IMPLEMENTATION */
 #endif /* SDEFL_IMPLEMENTATION */
 
+#if defined(RPNG_DEFLATE_IMPLEMENTATION)
 
 //=========================================================================
 //                           SINFL
@@ -3260,7 +5813,7 @@ sinfl_decompress(unsigned char *out, int cap, const unsigned char *in, int size)
 
       if ((unsigned short)len != (unsigned short)~nlen)
         return (int)(out-o);
-      if (len > (e - s.bitptr) || !len)
+      if (len > (e - s.bitptr) || len > (oe - out) || !len)
         return (int)(out-o);
 
       memcpy(out, s.bitptr, (size_t)len);
@@ -3325,6 +5878,9 @@ sinfl_decompress(unsigned char *out, int cap, const unsigned char *in, int size)
           *out++ = (unsigned char)sym;
           sym = sinfl_decode(&s, s.lits, 10);
           if (sym < 256) {
+            if (sinfl_unlikely(out >= oe)) {
+              return (int)(out-o);
+            }
             *out++ = (unsigned char)sym;
             continue;
           }
@@ -3348,6 +5904,9 @@ sinfl_decompress(unsigned char *out, int cap, const unsigned char *in, int size)
         if (sinfl_unlikely(offs > (int)(out-o))) {
           return (int)(out-o);
         }
+        if (sinfl_unlikely(len > (int)(oe-out))) {
+          return (int)(out-o);
+        }
         out = out + len;
 
 #ifndef SINFL_NO_SIMD
@@ -3452,7 +6011,7 @@ zsinflate(void *out, int cap, const void *mem, int size) {
   const unsigned char *in = (const unsigned char*)mem;
   if (size >= 6) {
     const unsigned char *eob = in + size - 4;
-    int n = sinfl_decompress((unsigned char*)out, cap, in + 2u, size);
+    int n = sinfl_decompress((unsigned char*)out, cap, in + 2u, size - 2);
     unsigned a = sinfl_adler32(1u, (unsigned char*)out, n);
     unsigned h = eob[0] << 24 | eob[1] << 16 | eob[2] << 8 | eob[3] << 0;
     return a == h ? n : -1;
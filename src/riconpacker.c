@@ -11,10 +11,11 @@
 *       - Define custom text data per icon image: icon-poems
 *       - Extract and export icon images as .png files
 *       - WEB: Download exported images as a .zip file
+*       - CLI: Batch processing of multiple icon files from manifest
 *
 *   LIMITATIONS:
-*       - Supports only .ico/.icns files containing .png image data (import/export)
-*       - Supports only several OSTypes for .icns image files (modern OSTypes)
+*       - Supports only .ico files containing .png/.bmp image data (import/export), .icns exported as .png image data
+*       - Supports only several OSTypes for .icns image files (modern OSTypes, legacy RGB/mask OSTypes)
 *
 *   POSSIBLE IMPROVEMENTS:
 *       - Support any-size input images, scaled to closest size
@@ -165,7 +166,7 @@
 #include <stdio.h>                          // Required for: fopen(), fclose(), fread()...
 #include <stdlib.h>                         // Required for: calloc(), free()
 #include <string.h>                         // Required for: strcmp(), strlen()
-#include <math.h>                           // Required for: ceil()
+#include <math.h>                           // Required for: ceil(), log10(), sinf(), floorf(), powf(), cbrtf()
 
 //----------------------------------------------------------------------------------
 // Defines and Macros
@@ -189,12 +190,123 @@ bool __stdcall FreeConsole(void);           // Close console from code (kernel32
 
 #define MAX_IMAGE_TEXT_SIZE     48          // Maximum image text size for text poem lines
 
+#define MAX_OUTPUT_SIZES        64          // Maximum number of output sizes to generate (CLI)
+#define MAX_EXTRACT_SIZES       64          // Maximum number of sizes to extract (CLI)
+#define MAX_BATCH_JOB_INPUTS    64          // Maximum number of input files per batch job (CLI)
+#define OUTPUT_CACHE_VERSION    1           // Output cache file version (CLI), cache files with other version are ignored
+#define BUILD_MANIFEST_VERSION  2           // Build manifest version (CLI, incremental build), manifests with other version are ignored
+
+// SIMD instructions set used for image resampling, selected at compile time
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 1))
+    #include <xmmintrin.h>                  // Required for: SSE intrinsics [ResampleImage()]
+    #define SUPPORT_SIMD_SSE
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+    #include <arm_neon.h>                   // Required for: NEON intrinsics [ResampleImage()]
+    #define SUPPORT_SIMD_NEON
+#endif
+
+// SIMD instructions set used for icns channels interleaving (byte operations), selected at compile time
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>                  // Required for: SSE2 intrinsics [InterleaveIcnsChannels()]
+    #define SUPPORT_SIMD_SSE2
+#endif
+
+#define MAX_GENERATION_LEVELS   16          // Maximum box-filtered pyramid levels for cascaded generation
+#define GENERATION_MIN_PSNR     40.0f       // Minimum PSNR (dB) of cascaded vs direct resampling (balanced quality)
+
+#define QUANTIZE_MAX_SIZE       48          // Maximum icon size quantized when no size is provided (--quantize <psnr>)
+#define QUANTIZE_KMEANS_STEPS   4           // K-means refinement iterations over median-cut palette
+#define MAX_QUANTIZE_THRESHOLDS 16          // Maximum per-size quantization thresholds (CLI)
+
+#define MAX_ENCODE_CACHE_ENTRIES    128                 // Maximum encoded PNG data entries kept in cache
+#define MAX_ENCODE_CACHE_MEMORY     (64*1024*1024)      // Maximum encoded PNG data memory kept in cache (bytes)
+
+// Worker threads support, used for CPU-heavy tasks (i.e. PNG compression of icon entries)
+// NOTE: Threads not available on PLATFORM_WEB, jobs are processed serially by caller thread
+#if !defined(PLATFORM_WEB)
+    #define SUPPORT_WORKER_THREADS
+#endif
+#define MAX_WORKER_THREADS      16          // Maximum worker threads in the pool (caller thread not included)
+#define ENCODE_STRIPES_MIN_SIZE 256         // Minimum icon size encoded by caller thread, image data compressed in stripes on worker pool
+
+#if defined(_WIN32)
+    // NOTE: Required for GetTimeMilliseconds(), raylib GetTime() requires an initialized window
+    __declspec(dllimport) int __stdcall QueryPerformanceCounter(unsigned long long *count);
+    __declspec(dllimport) int __stdcall QueryPerformanceFrequency(unsigned long long *frequency);
+    __declspec(dllimport) int __stdcall CloseHandle(void *handle);
+#else
+    #include <time.h>                       // Required for: clock_gettime()
+#endif
+
+// Memory-mapped input files support, file data is read by LoadFileData() if not available
+#if !defined(PLATFORM_WEB)
+    #define SUPPORT_FILE_MAPPING
+#endif
+
+#if defined(SUPPORT_FILE_MAPPING)
+#if defined(_WIN32)
+    // NOTE: Avoid including windows.h, only required Win32 functions are declared
+    __declspec(dllimport) void *__stdcall CreateFileA(const char *fileName, unsigned long access, unsigned long shareMode, void *security, unsigned long creation, unsigned long flags, void *templateFile);
+    __declspec(dllimport) int __stdcall GetFileSizeEx(void *file, long long *size);
+    __declspec(dllimport) void *__stdcall CreateFileMappingA(void *file, void *security, unsigned long protect, unsigned long sizeHigh, unsigned long sizeLow, const char *name);
+    __declspec(dllimport) void *__stdcall MapViewOfFile(void *mapping, unsigned long access, unsigned long offsetHigh, unsigned long offsetLow, size_t bytes);
+    __declspec(dllimport) int __stdcall UnmapViewOfFile(const void *address);
+#else
+    #include <sys/mman.h>                   // Required for: mmap(), munmap()
+    #include <sys/stat.h>                   // Required for: fstat()
+    #include <fcntl.h>                      // Required for: open()
+    #include <unistd.h>                     // Required for: close()
+#endif
+#endif
+
+// Output files are written to a temporary file and renamed, vectored write used if available
+#if !defined(PLATFORM_WEB) && !defined(_WIN32)
+    #define SUPPORT_FILE_VECTORED_WRITE
+#endif
+
+#if defined(_WIN32)
+    __declspec(dllimport) int __stdcall MoveFileExA(const char *existingFileName, const char *newFileName, unsigned long flags);
+    __declspec(dllimport) unsigned long __stdcall GetCurrentProcessId(void);
+#elif defined(SUPPORT_FILE_VECTORED_WRITE)
+    #include <sys/uio.h>                    // Required for: writev()
+    #include <fcntl.h>                      // Required for: open()
+    #include <unistd.h>                     // Required for: close(), getpid()
+    #include <limits.h>                     // Required for: IOV_MAX
+    #include <errno.h>                      // Required for: errno
+    #if !defined(IOV_MAX)
+        #define IOV_MAX     16              // Minimum value required by POSIX
+    #endif
+#endif
+
+#if defined(SUPPORT_WORKER_THREADS)
+#if defined(_WIN32)
+    // NOTE: Avoid including windows.h, it conflicts with raylib symbols (Rectangle, CloseWindow, DrawText...)
+    // SRWLOCK and CONDITION_VARIABLE are pointer-size opaque structs, only required Win32 functions are declared
+    #include <process.h>                    // Required for: _beginthreadex()
+    __declspec(dllimport) void __stdcall InitializeSRWLock(void *lock);
+    __declspec(dllimport) void __stdcall AcquireSRWLockExclusive(void *lock);
+    __declspec(dllimport) void __stdcall ReleaseSRWLockExclusive(void *lock);
+    __declspec(dllimport) void __stdcall InitializeConditionVariable(void *cond);
+    __declspec(dllimport) int __stdcall SleepConditionVariableSRW(void *cond, void *lock, unsigned long ms, unsigned long flags);
+    __declspec(dllimport) void __stdcall WakeConditionVariable(void *cond);
+    __declspec(dllimport) void __stdcall WakeAllConditionVariable(void *cond);
+    __declspec(dllimport) unsigned long __stdcall WaitForSingleObject(void *handle, unsigned long ms);
+    __declspec(dllimport) unsigned long __stdcall GetActiveProcessorCount(unsigned short groupNumber);
+#else
+    #include <pthread.h>                    // Required for: pthread_create(), pthread_join(), pthread_mutex_lock()...
+    #include <unistd.h>                     // Required for: sysconf()
+#endif
+#endif
+
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
 // NOTE: All image data referenced by entries in the image directory proceed directly after the image directory
 // It is customary practice to store them in the same order as defined in the image directory
 
+// Input file data shared by loaded entries (forward declaration)
+typedef struct SharedMappedFile SharedMappedFile;
+
 // One image entry for ico
 typedef struct {
     int size;                   // Icon size (squared)
@@ -202,6 +314,10 @@ typedef struct {
     Image image;                // Icon image
     char text[MAX_IMAGE_TEXT_SIZE]; // Text to be embedded in the image
     bool generated;             // Image generated
+    unsigned char *data;        // Image compressed data (PNG), decoded into image on demand
+    int dataSize;               // Image compressed data size
+    SharedMappedFile *source;   // Input file data borrowed by compressed data (not freed), NULL if data is an owned copy
+    bool reused;                // Image compressed data reused from previous output (incremental build), written as is
 } IconEntry;
 
 // Icon bucket (platform-independant, image pool)
@@ -229,6 +345,211 @@ typedef enum {
     ICON_PLATFORM_IOS7,
 } IconPlatform;
 
+// Image resampling filter
+typedef enum {
+    RESAMPLE_FILTER_NEAREST = 0,    // Nearest-neighbor
+    RESAMPLE_FILTER_BICUBIC,        // Bicubic (Catmull-Rom), support: 2
+    RESAMPLE_FILTER_LANCZOS3,       // Lanczos (a = 3), support: 3
+} ResampleFilter;
+
+// Image resampling weights for one dimension
+// NOTE: Precomputed per source/target size, every target sample uses a contiguous range of source samples
+typedef struct {
+    int taps;                   // Maximum taps per target sample
+    int *start;                 // First source sample per target sample
+    int *count;                 // Taps used per target sample
+    float *weights;             // Normalized weights (taps per target sample)
+} ResampleWeights;
+
+// Icon images generation quality
+// NOTE: Cascaded generation only applies to smooth scaling, nearest-neighbor is always direct
+typedef enum {
+    GENERATION_QUALITY_FAST = 0,    // Cascaded from box-filtered half-resolution pyramid
+    GENERATION_QUALITY_BALANCED,    // Cascaded, verified on bigger size against direct resampling (min PSNR)
+    GENERATION_QUALITY_BEST,        // Direct resampling from source image for every size
+} GenerationQuality;
+
+// Lossy palette quantization threshold
+// NOTE: Icon entry is quantized to the smallest palette with PSNR over threshold, lossless data kept otherwise
+typedef struct {
+    int size;                   // Icon size, 0 for any size up to QUANTIZE_MAX_SIZE
+    float minPSNR;              // Minimum PSNR (dB) of quantized image against source image
+} QuantizeThreshold;
+
+// Median-cut quantization box, range of pixels on quantization buffer
+typedef struct {
+    int start;                  // First pixel index
+    int count;                  // Pixels count
+    int channel;                // Channel with bigger values range (split channel)
+    int range;                  // Values range on split channel
+} QuantizeBox;
+
+// Input file data, memory-mapped or loaded
+// NOTE: Data is read-only and only available until unloaded, data kept after parsing must be copied
+// or borrowed from a shared mapped file
+typedef struct {
+    unsigned char *data;        // File data
+    unsigned int size;          // File data size
+    bool mapped;                // File data is memory-mapped, loaded with LoadFileData() otherwise
+} MappedFile;
+
+// Input file data shared by loaded entries, PNG entries borrow their compressed data (not copied)
+// NOTE: File data is unloaded once last reference is released, references are only taken and released
+// on main thread (loading and unloading entries), workers only read borrowed data while encoding
+struct SharedMappedFile {
+    MappedFile file;            // File data
+    int refCount;               // References count: loader and entries borrowing file data
+    char fileName[512];         // File name, borrowed data is copied before file is overwritten
+};
+
+// Output file data segment, written in order
+typedef struct {
+    const void *data;           // Segment data
+    unsigned int size;          // Segment data size
+} FileDataSegment;
+
+// Icns element data format
+typedef enum {
+    ICNS_FORMAT_NONE = 0,       // Not an image element (table of contents, version, nested icon set...)
+    ICNS_FORMAT_PNG,            // PNG data, ARGB data (RLE channels) on 16x16 and 32x32 elements, JPEG2000 not supported
+    ICNS_FORMAT_RGB,            // Legacy 24 bit RGB data (RLE channels): is32, il32, ih32, it32
+    ICNS_FORMAT_MASK,           // Legacy 8 bit alpha mask (uncompressed): s8mk, l8mk, h8mk, t8mk
+} IcnsDataFormat;
+
+// Icns loaded entries, array grows as required (no entries limit)
+typedef struct {
+    IconEntry *entries;         // Loaded entries
+    int *priority;              // Entry priority for same size, lower preferred (main icon set, PNG/ARGB data)
+    int count;                  // Loaded entries count
+    int capacity;               // Entries array capacity
+    const char *fileName;       // Icns file name (logging)
+    SharedMappedFile *source;   // Icns file data, borrowed by PNG entries
+} IcnsEntries;
+
+// Icns legacy images of one icon set (16x16, 32x32, 48x48, 128x128)
+// NOTE: RGB and mask elements can come in any order, merged once all icon set elements are loaded
+typedef struct {
+    unsigned char *planes[4];       // RGB data decoded into planar channels (R, G, B)
+    const unsigned char *masks[4];  // 8 bit mask data, referenced from file data
+} IcnsLegacySet;
+
+// Icon pack job (command line)
+// NOTE: Input files are loaded into the icon bucket, output sizes are copied or generated from bucket
+typedef struct {
+    char **inputFiles;          // Input file names
+    int inputFilesCount;        // Input files count
+    const char *outFileName;    // Output icon file name (.ico/.icns)
+    int outPlatform;            // Output platform sizes scheme
+    int *outSizes;              // Output custom sizes to generate (platform sizes are appended)
+    int outSizesCount;          // Output custom sizes count
+    int scaleAlgorythm;         // Scaling algorythm on generation: 1-Nearest-neighbor, 2-Bicubic, 3-Lanczos
+    int scaleQuality;           // Generation quality: 0-Fast, 1-Balanced, 2-Best
+    bool extractAll;            // Extract all input sizes as .png
+    int *extractSizes;          // Sizes to extract as .png (if available)
+    int extractSizesCount;      // Sizes to extract count
+} IconPackJob;
+
+// Output cache file header (command line)
+// NOTE: Header is followed by cached output files, every file: type (int), size (int) and data,
+// file type is 0 for icon file (.ico/.icns) or image size for extracted images (.png)
+typedef struct {
+    char id[4];                 // Output cache file identifier: "rIPc"
+    int version;                // Output cache file version: OUTPUT_CACHE_VERSION
+    int entryCount;             // Icon entries saved by job
+    int fileCount;              // Cached output files count
+} OutputCacheHeader;
+
+// Build manifest input file state (command line, incremental build)
+typedef struct {
+    char fileName[512];         // Input file name
+    long modTime;               // Input file modification time
+    unsigned long long key;     // Input file data hash, 0 if not available
+} BuildManifestInput;
+
+// Build manifest (command line, incremental build)
+// NOTE: Saved as a text file next to the output file (<output>.rdeps), output entries keep the input
+// they are copied or generated from, so entries from unchanged inputs can be reused on next build
+typedef struct {
+    unsigned long long paramsKey;       // Generation/encoding parameters hash
+    int savedCount;                     // Icon entries saved
+    long outputModTime;                 // Output icon file modification time when saved
+    int outputSize;                     // Output icon file size when saved
+    BuildManifestInput *inputs;         // Input files state
+    int inputCount;                     // Input files count
+    int entrySizes[MAX_OUTPUT_SIZES];   // Output entries sizes
+    int entrySources[MAX_OUTPUT_SIZES]; // Output entries source input index
+    int entryCount;                     // Output entries count
+    int extractSizes[MAX_ICON_BUCKET_SIZE + MAX_OUTPUT_SIZES];  // Extracted images sizes
+    int extractCount;                   // Extracted images count
+} BuildManifest;
+
+// Worker job function, processes one job data element
+typedef void (*WorkerJobFunc)(void *jobData);
+
+// Worker pool (persistent threads waiting for jobs)
+// NOTE: Jobs are processed in batches, caller thread also processes jobs until batch is completed
+typedef struct {
+    int threadCount;            // Worker threads count (caller thread not included)
+    bool ready;                 // Worker pool initialized
+    bool shutdown;              // Worker threads exit requested
+    bool busy;                  // Jobs batch in process, nested batches are processed serially
+    unsigned int batchId;       // Jobs batch identifier, workers wake-up on change
+
+    WorkerJobFunc jobFunc;      // Jobs batch function
+    unsigned char *jobsData;    // Jobs batch data array
+    int jobSize;                // Job data element size (bytes)
+    int jobCount;               // Jobs batch count
+    int jobNext;                // Next job to be processed
+    int jobDone;                // Jobs completed
+
+#if defined(SUPPORT_WORKER_THREADS)
+#if defined(_WIN32)
+    void *lock;                 // Win32 SRWLOCK
+    void *jobsReady;            // Win32 CONDITION_VARIABLE: new jobs batch available
+    void *jobsDone;             // Win32 CONDITION_VARIABLE: jobs batch completed
+    void *threads[MAX_WORKER_THREADS];
+#else
+    pthread_mutex_t lock;
+    pthread_cond_t jobsReady;   // New jobs batch available
+    pthread_cond_t jobsDone;    // Jobs batch completed
+    pthread_t threads[MAX_WORKER_THREADS];
+#endif
+#endif
+} WorkerPool;
+
+// Icon entry PNG encoding job
+typedef struct {
+    IconEntry *entry;           // Icon entry to encode (input)
+    bool embedText;             // Embed entry text as rIPt chunk (input)
+    char *pngData;              // Encoded PNG data (output), must be freed with UnloadIconEncodeJobs()
+    int pngDataSize;            // Encoded PNG data size (output)
+    bool passthrough;           // PNG data references entry original data, not encoded (output)
+    int referenceSize;          // PNG data size with default compression or original data size, squeeze only (output)
+    int losslessSize;           // PNG data size before lossy quantization, quantization only (output)
+    int quantizeColors;         // Palette colors of best quantized candidate over threshold, 0 if none (output)
+    float quantizePSNR;         // PSNR (dB) of best quantized candidate (or biggest palette if none over threshold) (output)
+    float quantizeDeltaE;       // Mean color difference (CIE76) of best quantized candidate (output)
+    bool quantized;             // PNG data is quantized (smaller than lossless data) (output)
+    unsigned long long cacheKey; // Encoding content hash, encode cache key (internal)
+} IconEncodeJob;
+
+// Encode cache entry, encoded PNG data by content hash
+// NOTE: Job entry pointer is not valid, PNG data is owned by the cache
+typedef struct {
+    unsigned long long key;     // Content hash: image (or original) data, size, format, encoding settings and text
+    IconEncodeJob job;          // Encoding job results
+    unsigned int lastUse;       // Cache use tick on last access (LRU eviction)
+} EncodeCacheEntry;
+
+// Encode cache, reused by all exports
+// NOTE: Accessed only from main thread, before and after encoding jobs batch
+typedef struct {
+    EncodeCacheEntry entries[MAX_ENCODE_CACHE_ENTRIES];
+    int count;                  // Cache entries count
+    unsigned int memorySize;    // PNG data memory used by cache entries
+    unsigned int useTick;       // Cache use tick, incremented on every access
+} EncodeCache;
+
 //----------------------------------------------------------------------------------
 // Global Variables Definition
 //----------------------------------------------------------------------------------
@@ -257,18 +578,43 @@ static int packValidCount = 0;              // Valid ico entries counter
 
 static int sizeListActive = 0;              // Current list text entry
 static int exportFormatActive = 0;
+static int compressionEffort = RPNG_COMPRESSION_DEFAULT;   // PNG compression effort on export (rpng_compression_effort)
+
+static QuantizeThreshold quantizeThresholds[MAX_QUANTIZE_THRESHOLDS] = { 0 };   // Lossy quantization thresholds per size
+static int quantizeThresholdsCount = 0;     // Lossy quantization thresholds count, quantization disabled if 0
+static float quantizeDithering = 0.0f;      // Lossy quantization dithering strength [0.0f..1.0f] (Floyd-Steinberg)
 
 // WARNING: This global is required by export functions
 static bool exportTextChunkChecked = true;  // Flag to embed text as a PNG chunk (rIPt)
+static bool icoBmpEntries = false;          // Flag to save .ico entries smaller than 256 as BMP data (32 bit + AND mask)
 
 static RenderTexture screenTarget = { 0 };
 
+static WorkerPool workerPool = { 0 };       // Worker pool, initialized on first jobs batch
+static int compressionThreads = 0;          // Threads used to compress one PNG image data (0: processors count)
+static char outputCacheDir[512] = { 0 };    // Output cache directory (command line), cache disabled if empty
+static bool incrementalBuild = false;       // Incremental build (command line), only entries from changed inputs processed
+static rpng_decoder *pngDecoder = NULL;     // PNG streaming decoder, reused by all entries (main thread only)
+static EncodeCache encodeCache = { 0 };     // Encoded PNG data cache, unchanged entries not encoded again
+
 //----------------------------------------------------------------------------------
 // Module Functions Declaration
 //----------------------------------------------------------------------------------
 #if defined(PLATFORM_DESKTOP) || defined(COMMAND_LINE_ONLY)
 static void ShowCommandLineInfo(void);                      // Show command line usage info
 static void ProcessCommandLine(int argc, char *argv[]);     // Process command line input
+static int ProcessIconPackJob(IconPackJob job, bool verbose); // Process icon pack job, returns number of entries saved
+static void ProcessBatchManifest(const char *fileName, int scaleAlgorythm, int scaleQuality); // Process batch manifest, one icon pack job per line
+static unsigned long long GetIconPackJobKey(IconPackJob job); // Get icon pack job content hash (inputs data and parameters), 0 if inputs not available
+static unsigned long long GetIconPackJobParamsKey(IconPackJob job, unsigned long long seed); // Get icon pack job generation/encoding parameters hash
+static int LoadIconPackJobFromCache(IconPackJob job, unsigned long long key); // Save job output files from output cache, returns entries saved, -1 if not cached
+static void SaveIconPackJobToCache(IconPackJob job, unsigned long long key, int entryCount, const int *extractedSizes, int extractedCount); // Save job output files into output cache
+static BuildManifest GetIconPackJobManifest(IconPackJob job, BuildManifest prevManifest); // Get icon pack job build manifest (inputs state and parameters hash)
+static bool IsBuildInputChanged(BuildManifest manifest, BuildManifest prevManifest, int index); // Check if build manifest input has changed from previous manifest
+static bool IsIconPackJobUpToDate(IconPackJob job, BuildManifest manifest, BuildManifest prevManifest); // Check if icon pack job output files are up to date
+static BuildManifest LoadBuildManifest(const char *fileName); // Load build manifest from text file
+static void SaveBuildManifest(BuildManifest manifest, const char *fileName); // Save build manifest to text file
+static void UnloadBuildManifest(BuildManifest manifest);     // Unload build manifest inputs data
 #endif
 
 static void AddIconToBucket(IconBucket *bucket, const char *fileName);      // Add icon images from input file to bucket
@@ -276,18 +622,78 @@ static void RemoveIconFromBucket(IconBucket *bucket, unsigned int size);    // T
 static void UpdateIconPackFromBucket(IconPack *pack, IconBucket bucket);    // Update icon pack with icon bucket data
 static void ClearIconBucket(IconBucket *bucket);                            // Clear icon bucket, unload all contained images
 
+static IconEntry LoadIconEntryFromMemory(const unsigned char *fileData, int dataSize, SharedMappedFile *source); // Load icon entry from PNG data (not decoded, data borrowed from source or copied)
+static bool LoadIconEntryImage(IconEntry *entry);           // Load icon entry image from compressed data, if not decoded yet
+static void CopyIconEntryScanline(const char *scanline, int row, void *userData); // Copy decoded scanline into icon entry image (decoder callback)
+static void UnloadIconEntry(IconEntry *entry);              // Unload icon entry image and compressed data (borrowed data released)
+static void CopyIconEntriesSourceData(IconEntry *entries, int entryCount, IconEntry *sharing, int sharingCount, const char *fileName); // Copy entries data borrowed from files overwritten by output
+
 static void ResetIconPack(IconPack *pack, int platform);    // Reset icon pack, unload generated images and textures
 static char *GetTextIconSizes(IconPack pack);               // Get sizes as a text array separated by semicolon (ready for GuiListView())
 
 // Load/Save/Export data functions
 static IconEntry *LoadIconPackFromICO(const char *fileName, int *count);                    // Load icon pack from .ico file
-static void SaveIconPackToICO(IconEntry *entries, int entryCount, const char *fileName);    // Save icon pack to.ico file
+static IconEntry LoadIconEntryFromBMP(const unsigned char *data, unsigned int dataSize);    // Load icon entry from ICO BMP data (DIB), image decoded
+static unsigned char *SaveIconEntryBMP(const IconEntry *entry, int *dataSize);              // Save icon entry image as ICO BMP data (DIB, 32 bit + AND mask)
+static void SwapPixelsRedBlue(const unsigned char *src, unsigned char *dst, int pixelCount); // Swap red and blue channels of 32 bit pixels (BGRA <-> RGBA)
+static bool SaveIconPackToICO(IconEntry *entries, int entryCount, const char *fileName);    // Save icon pack to.ico file
 static void ExportIconPackImages(IconEntry *entries, int entryCount, const char *fileName); // Export icon pack to multiple .png images
 static IconEntry *LoadIconPackFromICNS(const char *fileName, int *count);                   // Load icon pack from .icns file
-static void SaveIconPackToICNS(IconEntry *entries, int entryCount, const char *fileName);   // Save icon pack to .icns file
+static void LoadIcnsElements(IcnsEntries *icns, const unsigned char *data, unsigned int size, int depth); // Load icns elements into entries (nested icon sets supported)
+static bool SaveIconPackToICNS(IconEntry *entries, int entryCount, const char *fileName);   // Save icon pack to .icns file
+
+// Icon images generation functions
+static void GenerateIconImages(Image source, IconEntry *entries, int entryCount, int scaleAlgorythm, int quality); // Generate missing entries images from source image
+static Image GenImageHalfBox(Image image);                  // Generate half-resolution image with 2x2 box filter (premultiplied alpha)
+static float GetImagePSNR(Image image1, Image image2);      // Get PSNR (dB) between two images of same size and format (R8G8B8A8)
+static float GetImageDeltaE(Image image1, Image image2);    // Get mean color difference (CIE76) between two images of same size and format (R8G8B8A8)
+static unsigned char *QuantizeImage(Image image, int maxColors, float dithering, Color *palette, int *colorCount); // Quantize image to indexed data (median-cut + k-means)
+static void UpdateQuantizeBox(QuantizeBox *box, const unsigned char *colors); // Update quantization box split channel and range
+static int GetNearestPaletteColor(const unsigned char *palette, int colorCount, int r, int g, int b, int a); // Get nearest palette color index
+
+// Image resampling functions
+static Image ResampleImage(Image image, int newWidth, int newHeight, int filter); // Resample image to new size (separable filter, premultiplied alpha)
+static ResampleWeights LoadResampleWeights(int srcSize, int dstSize, int filter); // Load resampling weights for one dimension
+static void UnloadResampleWeights(ResampleWeights weights); // Unload resampling weights
+static float GetResampleKernelValue(float x, int filter);   // Get resampling filter kernel value at provided distance
 
 // Misc functions
+static MappedFile LoadMappedFile(const char *fileName);     // Load file data, memory-mapped if supported (read-only)
+static void UnloadMappedFile(MappedFile file);              // Unload file data (unmap or free)
+static SharedMappedFile *LoadSharedMappedFile(const char *fileName); // Load file data shared by loaded entries, NULL if not loaded
+static void UnloadSharedMappedFile(SharedMappedFile *file); // Release file data reference, unloaded with last reference
+static bool SaveFileDataSegments(const char *fileName, const FileDataSegment *segments, int segmentCount); // Save data segments to file (temp file renamed on completion)
+static bool IsPngDataBounded(const unsigned char *data, unsigned int size); // Check PNG chunks (up to IEND) are contained in data size
 static unsigned int CountIconPackTextLines(IconPack pack);  // Count text lines available on icon pack
+static IconEncodeJob *EncodeIconPackEntries(IconEntry *entries, int entryCount, bool embedText, int *jobCount); // Encode valid icon entries into PNG data (multithreaded)
+static void EncodeIconEntryJob(void *jobData);             // Worker job: Encode one icon entry into PNG data
+static bool IsIconEntryDataDirectColor(const IconEntry *entry); // Check if entry PNG data is direct color (gray/RGB, 8/16 bit, no tRNS chunk)
+static char *SqueezeIconEntryData(IconEntry *entry, const rpng_chunk *chunks, int chunkCount, int *dataSize); // Recompress entry original PNG data (squeeze), NULL if not smaller
+static float GetQuantizeMinPSNR(int size);                  // Get lossy quantization threshold for icon size, 0.0f if not quantized
+static char *QuantizeIconEntryData(IconEntry *entry, float minPSNR, const rpng_chunk *chunks, int chunkCount, int *dataSize, IconEncodeJob *job); // Quantize entry image to smallest indexed PNG over threshold
+static void UnloadIconEncodeJobs(IconEncodeJob *jobs, int jobCount); // Unload icon encoding jobs PNG data
+static unsigned long long GetIconEncodeKey(IconEntry *entry, bool embedText); // Get icon entry encoding content hash (encode cache key)
+static bool GetEncodeCacheData(unsigned long long key, IconEncodeJob *job); // Get encoded data from cache into job (data copied), false if not found
+static void AddEncodeCacheData(unsigned long long key, IconEncodeJob job); // Add encoded job data to cache (data copied), least recently used entries evicted
+static void UnloadEncodeCache(void);                        // Unload encode cache data
+
+// Worker pool functions
+static void InitWorkerPool(int threadCount);                // Initialize worker pool, launching worker threads
+static void CloseWorkerPool(void);                          // Close worker pool, joining worker threads
+static void RunWorkerJobs(WorkerJobFunc jobFunc, void *jobsData, int jobSize, int jobCount); // Run jobs batch, waits until all jobs are completed
+static bool RunWorkerJobsParallel(WorkerJobFunc jobFunc, void *jobsData, int jobSize, int jobCount); // Run jobs batch on worker pool, false if pool not available (jobs not processed)
+static int GetProcessorCount(void);                         // Get available logical processors
+static void SetCompressionThreads(int threadCount);         // Set threads used to compress one PNG image data (multithreaded deflate)
+#if defined(PLATFORM_DESKTOP) || defined(COMMAND_LINE_ONLY)
+static int GetCompressionEffort(const char *text);          // Get compression effort from text (name or value), -1 if not valid
+#endif
+#if defined(PLATFORM_WEB) || defined(EXPORT_IMAGE_PACK_AS_ZIP)
+static int GetZipCompressionLevel(int effort);              // Get zip compression level for PNG compression effort
+#endif
+static double GetTimeMilliseconds(void);                    // Get monotonic time in milliseconds (no window required)
+static unsigned long long GetDataHash(const void *data, unsigned int size, unsigned long long seed); // Get data 64bit hash (xxHash64)
+static int SplitTextInPlace(char *text, char delimiter, char **parts, int maxParts); // Split text in place, delimiters replaced by '\0'
+static char *TrimTextInPlace(char *text);                   // Trim text spaces in place (start and end)
 
 //------------------------------------------------------------------------------------
 // Program main entry point
@@ -304,8 +710,12 @@ int main(int argc, char *argv[])
 #if !defined(_DEBUG)
     SetTraceLogLevel(LOG_NONE);         // Disable raylib trace log messsages
 #endif
+    SetCompressionThreads(compressionThreads);  // Big images data compressed in stripes on worker pool
 #if defined(COMMAND_LINE_ONLY)
     ProcessCommandLine(argc, argv);
+    CloseWorkerPool();
+    rpng_decoder_destroy(pngDecoder);
+    UnloadEncodeCache();
 #else
 #if defined(PLATFORM_DESKTOP)
     // Command-line usage mode
@@ -325,6 +735,9 @@ int main(int argc, char *argv[])
         else
         {
             ProcessCommandLine(argc, argv);
+            CloseWorkerPool();
+            rpng_decoder_destroy(pngDecoder);
+            UnloadEncodeCache();
             return 0;
         }
     }
@@ -350,6 +763,7 @@ int main(int argc, char *argv[])
     Vector2 anchorMain = { 0, 0 };
 
     int scaleAlgorythmActive = 1;
+    int scaleQualityActive = GENERATION_QUALITY_BALANCED;   // Generate all sizes cascaded (verified), selected size regenerated directly
 
     bool btnGenIconImagePressed = false;
     bool btnClearIconImagePressed = false;
@@ -533,6 +947,9 @@ int main(int argc, char *argv[])
                 // Reset one pack entry
                 currentPack.entries[sizeListActive - 1].valid = false;
                 currentPack.entries[sizeListActive - 1].image = (Image){ 0 };
+                currentPack.entries[sizeListActive - 1].data = NULL;
+                currentPack.entries[sizeListActive - 1].source = NULL;
+                currentPack.entries[sizeListActive - 1].dataSize = 0;
                 UnloadTexture(currentPack.textures[sizeListActive - 1]);
                 memset(currentPack.entries[sizeListActive - 1].text, 0, MAX_IMAGE_TEXT_SIZE);
             }
@@ -642,26 +1059,29 @@ int main(int argc, char *argv[])
                 }
 
                 // Generate all missing entries in the series
+                bool missing[MAX_PACK_ELEMENTS] = { 0 };
+
                 for (int i = 0; i < currentPack.count; i++)
                 {
                     if (!currentPack.entries[i].valid)
                     {
                         if (currentPack.entries[i].generated) UnloadImage(currentPack.entries[i].image);
                         else currentPack.entries[i].image = (Image){ 0 };   // Unlink from bucket image
-                        //currentPack.entries[i].image = ImageCopy(bucket.entries[biggerSizeIndex].image);
 
-                        Image newImage = ImageCopy(bucket.entries[biggerSizeIndex].image);
-
-                        if (scaleAlgorythmActive == 0) ImageResizeNN(&newImage, currentPack.entries[i].size, currentPack.entries[i].size);
-                        else if (scaleAlgorythmActive == 1) ImageResize(&newImage, currentPack.entries[i].size, currentPack.entries[i].size);
+                        missing[i] = true;
+                    }
+                }
 
-                        currentPack.entries[i].image = newImage;
+                // NOTE: Missing sizes are generated as a cascade, from bigger to smaller size
+                LoadIconEntryImage(&bucket.entries[biggerSizeIndex]);
+                GenerateIconImages(bucket.entries[biggerSizeIndex].image, currentPack.entries, currentPack.count, scaleAlgorythmActive + 1, scaleQualityActive);
 
+                for (int i = 0; i < currentPack.count; i++)
+                {
+                    if (missing[i])
+                    {
                         UnloadTexture(currentPack.textures[i]);
                         currentPack.textures[i] = LoadTextureFromImage(currentPack.entries[i].image);
-
-                        currentPack.entries[i].generated = true;
-                        currentPack.entries[i].valid = true;
                     }
                 }
             }
@@ -689,20 +1109,12 @@ int main(int argc, char *argv[])
                 {
                     if (currentPack.entries[sizeListActive - 1].generated) UnloadImage(currentPack.entries[sizeListActive - 1].image);
                     else currentPack.entries[sizeListActive - 1].image = (Image){ 0 };   // Unlink from bucket image
-                    //currentPack.entries[sizeListActive - 1].image = ImageCopy(bucket.entries[biggerSizeIndex].image);
-
-                    Image newImage = ImageCopy(currentPack.entries[biggerSizeIndex].image);
 
-                    if (scaleAlgorythmActive == 0) ImageResizeNN(&newImage, currentPack.entries[sizeListActive - 1].size, currentPack.entries[sizeListActive - 1].size);
-                    else if (scaleAlgorythmActive == 1) ImageResize(&newImage, currentPack.entries[sizeListActive - 1].size, currentPack.entries[sizeListActive - 1].size);
-
-                    currentPack.entries[sizeListActive - 1].image = newImage;
+                    // NOTE: One size generated by direct resampling, no pyramid levels required
+                    GenerateIconImages(currentPack.entries[biggerSizeIndex].image, &currentPack.entries[sizeListActive - 1], 1, scaleAlgorythmActive + 1, GENERATION_QUALITY_BEST);
 
                     UnloadTexture(currentPack.textures[sizeListActive - 1]);
                     currentPack.textures[sizeListActive - 1] = LoadTextureFromImage(currentPack.entries[sizeListActive - 1].image);
-
-                    currentPack.entries[sizeListActive - 1].generated = true;
-                    currentPack.entries[sizeListActive - 1].valid = true;
                 }
             }
         }
@@ -919,7 +1331,7 @@ int main(int argc, char *argv[])
             //----------------------------------------------------------------------------------------
             if (showExportWindow)
             {
-                Rectangle messageBox = { (float)screenWidth/2 - 248/2, (float)screenHeight/2 - 200/2, 248, 112 };
+                Rectangle messageBox = { (float)screenWidth/2 - 248/2, (float)screenHeight/2 - 200/2, 248, 144 };
                 int result = GuiMessageBox(messageBox, "#7#Export Icon File", " ", "#7#Export Icon");
 
                 GuiLabel((Rectangle){ messageBox.x + 12, messageBox.y + 12 + 24, 106, 24 }, "Icon Format:");
@@ -927,6 +1339,10 @@ int main(int argc, char *argv[])
                 // NOTE: If current platform is macOS, support .icns file export
                 GuiComboBox((Rectangle){ messageBox.x + 12 + 88, messageBox.y + 12 + 24, 136, 24 }, (mainToolbarState.platformActive == 1)? "Icon (.ico);Images (.png);Icns (.icns)" : "Icon (.ico);Images (.png)", &exportFormatActive);
 
+                // NOTE: Store/Fast compression for quick iteration exports, Max/Squeeze for smaller release files
+                GuiLabel((Rectangle){ messageBox.x + 12, messageBox.y + 12 + 24 + 32, 106, 24 }, "Compression:");
+                GuiComboBox((Rectangle){ messageBox.x + 12 + 88, messageBox.y + 12 + 24 + 32, 136, 24 }, "Store;Fast;Default;Max;Squeeze", &compressionEffort);
+
                 // WARNING: exportTextChunkChecked is used as a global variable required by SaveICO() and SaveICNS() functions
                 //GuiCheckBox((Rectangle){ messageBox.x + 20, messageBox.y + 48 + 24, 16, 16 }, "Export text poem with icon", &exportTextChunkChecked);
 
@@ -997,6 +1413,9 @@ int main(int argc, char *argv[])
                     }
 
                     // Save into icon file provided pack entries
+                    // NOTE: Bucket entries data borrowed from overwritten files is copied first
+                    CopyIconEntriesSourceData(bucket.entries, bucket.count, currentPack.entries, currentPack.count, outFileName);
+                    rpng_set_compression_effort(compressionEffort);
                     if (exportFormatActive == 0) SaveIconPackToICO(currentPack.entries, currentPack.count, outFileName);
                     else if (exportFormatActive == 1) ExportIconPackImages(currentPack.entries, currentPack.count, outFileName);
                     else if (exportFormatActive == 2) SaveIconPackToICNS(currentPack.entries, currentPack.count, outFileName);
@@ -1017,7 +1436,7 @@ int main(int argc, char *argv[])
                                 mz_ret = mz_zip_writer_add_file(&zip,
                                     TextFormat("%s_%ix%i.png", GetFileNameWithoutExt(outFileName), currentPack.entries[i].image.width, currentPack.entries[i].image.height),
                                     TextFormat("%s/%s_%ix%i.png", GetDirectoryPath(outFileName), GetFileNameWithoutExt(outFileName), currentPack.entries[i].image.width, currentPack.entries[i].image.height),
-                                    "Comment", (mz_uint16)strlen("Comment"), MZ_BEST_SPEED);
+                                    "Comment", (mz_uint16)strlen("Comment"), GetZipCompressionLevel(compressionEffort));
                                 if (!mz_ret) printf("Could not add file to zip archive\n");
                             }
                         }
@@ -1044,7 +1463,7 @@ int main(int argc, char *argv[])
                                 mz_ret = mz_zip_writer_add_file(&zip,
                                     TextFormat("%s_%ix%i.png", GetFileNameWithoutExt(outFileName), currentPack.entries[i].image.width, currentPack.entries[i].image.height),
                                     TextFormat("%s\\%s_%ix%i.png", GetDirectoryPath(outFileName), GetFileNameWithoutExt(outFileName), currentPack.entries[i].image.width, currentPack.entries[i].image.height),
-                                    "Comment", (mz_uint16)strlen("Comment"), MZ_BEST_SPEED);
+                                    "Comment", (mz_uint16)strlen("Comment"), GetZipCompressionLevel(compressionEffort));
                                 if (!mz_ret) printf("Could not add file to zip archive\n");
                             }
                         }
@@ -1126,6 +1545,10 @@ int main(int argc, char *argv[])
     ClearIconBucket(&bucket);
     RL_FREE(bucket.entries);
 
+    CloseWorkerPool();  // Close worker threads
+    rpng_decoder_destroy(pngDecoder);
+    UnloadEncodeCache();
+
     CloseWindow();      // Close window and OpenGL context
     //--------------------------------------------------------------------------------------
 
@@ -1154,7 +1577,10 @@ static void ShowCommandLineInfo(void)
     printf("USAGE:\n\n");
     printf("    > riconpacker [--help] --input <file01.ext>,[file02.ext],... [--output <filename.ico>]\n");
     printf("                  [--out-sizes <size01>,[size02],...] [--out-platform <value>] [--scale-algorythm <value>]\n");
-    printf("                  [--extract-size <size01>,[size02],...] [--extract-all]\n");
+    printf("                  [--scale-quality <value>] [--compression <value>] [--compression-threads <value>]\n");
+    printf("                  [--quantize <psnr>|<size01>:<psnr>,...] [--quantize-dither <value>] [--cache-dir <path>]\n");
+    printf("                  [--incremental] [--ico-bmp]\n");
+    printf("                  [--extract-size <size01>,[size02],...] [--extract-all] [--batch <manifest.txt>]\n");
 
     printf("\nOPTIONS:\n\n");
     printf("    -h, --help                      : Show tool version and command line usage help\n\n");
@@ -1178,28 +1604,70 @@ static void ShowCommandLineInfo(void)
     printf("    -sa, --scale-algorythm <value>  : Define the algorythm used to scale images.\n");
     printf("                                      Supported values:\n");
     printf("                                          1 - Nearest-neighbor scaling algorythm\n");
-    printf("                                          2 - Bicubic scaling algorythm (default)\n\n");
+    printf("                                          2 - Bicubic scaling algorythm (default)\n");
+    printf("                                          3 - Lanczos scaling algorythm\n\n");
+    printf("    -sq, --scale-quality <value>    : Define the quality of missing sizes generation (bicubic/lanczos).\n");
+    printf("                                      Supported values:\n");
+    printf("                                          0 - Fast: Cascaded from half-resolution images pyramid\n");
+    printf("                                          1 - Balanced: Cascaded, falls back to direct scaling\n");
+    printf("                                              if PSNR is below %.0f dB (default)\n", GENERATION_MIN_PSNR);
+    printf("                                          2 - Best: Direct scaling from bigger image\n\n");
+    printf("    -c, --compression <value>       : Define PNG compression effort for icon entries.\n");
+    printf("                                      Supported values:\n");
+    printf("                                          0 - store: No compression, fastest export\n");
+    printf("                                          1 - fast: Fixed filter, low deflate level\n");
+    printf("                                          2 - default: Adaptive filter, default deflate level (default)\n");
+    printf("                                          3 - max: All filter strategies tried, highest deflate level\n");
+    printf("                                          4 - squeeze: Filter strategies (brute force included) and deflate\n");
+    printf("                                              levels tried in parallel, smallest kept, savings reported\n\n");
+    printf("    -ct, --compression-threads <value>\n");
+    printf("                                    : Define threads used to compress one image data (big sizes).\n");
+    printf("                                      Image data is compressed in stripes, joined into one stream.\n");
+    printf("                                      NOTE: If not specified or 0, defaults to processors count\n\n");
+    printf("    -q, --quantize <psnr>|<size01>:<psnr>,...\n");
+    printf("                                    : Enable lossy palette quantization (256 colors or less).\n");
+    printf("                                      Smallest palette with PSNR (dB) over threshold is used,\n");
+    printf("                                      lossless data kept if smaller, error reported per size.\n");
+    printf("                                      NOTE: Threshold without size applies to sizes up to %i\n\n", QUANTIZE_MAX_SIZE);
+    printf("    -qd, --quantize-dither <value>  : Define quantization dithering strength, 0..100 (default: 0)\n\n");
+    printf("    -cd, --cache-dir <path>         : Define output cache directory (must exist). Output files are\n");
+    printf("                                      saved from cache if inputs data and parameters are unchanged,\n");
+    printf("                                      no decoding, resampling or compression required.\n");
+    printf("                                      NOTE: Applies to batch manifest jobs as well\n\n");
+    printf("    -inc, --incremental             : Incremental build, inputs state saved next to output file\n");
+    printf("                                      (<output>.rdeps). Nothing is done if inputs and parameters\n");
+    printf("                                      are unchanged, only entries from changed inputs are processed\n");
+    printf("                                      otherwise (other entries reused from existing output file).\n\n");
+    printf("    -ib, --ico-bmp                  : Save .ico sizes smaller than 256 as BMP data (32 bit + mask)\n");
+    printf("                                      instead of PNG data, bigger but faster to load on Windows.\n");
+    printf("                                      NOTE: Text poem (rIPt chunk) only saved with PNG data\n\n");
     printf("    -xs, --extract-size <size01>,[size02],...\n");
     printf("                                    : Extract image sizes from input (if size is available)\n");
     printf("                                      NOTE: Exported images name: output_{size}.png\n\n");
     printf("    -xa, --extract-all              : Extract all images from icon.\n");
     printf("                                      NOTE: Exported images naming: output_{size}.png,...\n\n");
+    printf("    -b, --batch <manifest.txt>      : Process multiple icon files, one job per manifest line:\n");
+    printf("                                          <file01.ext>,[file02.ext],...;[platform];[size01],[size02],...;<output.ico>\n");
+    printf("                                      NOTE: Empty lines and lines starting with '#' are skipped,\n");
+    printf("                                      jobs timing summary is shown at the end\n\n");
     printf("\nEXAMPLES:\n\n");
     printf("    > riconpacker --input image.png --output image.ico --out-platform 0\n");
     printf("        Process <image.png> to generate <image.ico> including full Windows icons sequence\n\n");
     printf("    > riconpacker --input image.png --out-sizes 256,64,48,32\n");
     printf("        Process <image.png> to generate <output.ico> including sizes: 256,64,48,32\n");
     printf("        NOTE: If a specific size is not found on input file, it's generated from bigger available size\n\n");
+    printf("    > riconpacker --input image.png --out-sizes 64,48,32,16 --quantize 38,48:42\n");
+    printf("        Process <image.png> to generate <output.ico>, sizes 32 and 16 quantized with a minimum\n");
+    printf("        PSNR of 38 dB, size 48 with a minimum PSNR of 42 dB, size 64 not quantized\n\n");
     printf("    > riconpacker --input image.ico --extract-all\n");
     printf("        Extract all available images contained in image.ico\n\n");
+    printf("    > riconpacker --batch icons.txt\n");
+    printf("        Process all icon jobs defined in <icons.txt>, i.e. line: app.png;1;;app.icns\n\n");
 }
 
 // Process command line input
 static void ProcessCommandLine(int argc, char *argv[])
 {
-    #define MAX_OUTPUT_SIZES    64      // Maximum number of output sizes to generate
-    #define MAX_EXTRACT_SIZES   64      // Maximum number of sizes to extract
-
     // CLI required variables
     bool showUsageInfo = false;         // Toggle command line usage info
 
@@ -1213,6 +1681,7 @@ static void ProcessCommandLine(int argc, char *argv[])
     int outSizesCount = 0;              // Number of sizes to generate
 
     int scaleAlgorythm = 2;             // Scaling algorythm on generation
+    int scaleQuality = GENERATION_QUALITY_BALANCED; // Generation quality (cascaded generation)
 
     bool extractSize = false;           // Extract size required
     int extractSizes[MAX_EXTRACT_SIZES] = { 0 }; // Sizes to extract
@@ -1220,6 +1689,8 @@ static void ProcessCommandLine(int argc, char *argv[])
 
     bool extractAll = false;            // Extract all sizes required
 
+    char batchFileName[512] = { 0 };    // Batch manifest file name
+
 #if defined(COMMAND_LINE_ONLY)
     if (argc == 1) showUsageInfo = true;
 #endif
@@ -1301,11 +1772,107 @@ static void ProcessCommandLine(int argc, char *argv[])
             {
                 int scale = TextToInteger(argv[i + 1]);   // Read provided scale algorythm value
 
-                if ((scale == 1) || (scale == 2)) scaleAlgorythm = scale;
+                if ((scale >= 1) && (scale <= 3)) scaleAlgorythm = scale;
                 else printf("WARNING: Scale algorythm not recognized, default to Bicubic\n");
             }
             else printf("WARNING: No scale algortyhm provided\n");
         }
+        else if ((strcmp(argv[i], "-sq") == 0) || (strcmp(argv[i], "--scale-quality") == 0))
+        {
+            if (((i + 1) < argc) && (argv[i + 1][0] != '-'))
+            {
+                int quality = TextToInteger(argv[i + 1]);   // Read provided scale quality value
+
+                if ((quality >= GENERATION_QUALITY_FAST) && (quality <= GENERATION_QUALITY_BEST)) scaleQuality = quality;
+                else printf("WARNING: Scale quality not recognized, default to Balanced\n");
+            }
+            else printf("WARNING: No scale quality provided\n");
+        }
+        else if ((strcmp(argv[i], "-c") == 0) || (strcmp(argv[i], "--compression") == 0))
+        {
+            if (((i + 1) < argc) && (argv[i + 1][0] != '-'))
+            {
+                int effort = GetCompressionEffort(argv[i + 1]);   // Read provided compression effort (name or value)
+
+                if (effort >= 0) compressionEffort = effort;
+                else printf("WARNING: Compression effort not recognized, default to: default\n");
+
+                rpng_set_compression_effort(compressionEffort);
+                i++;
+            }
+            else printf("WARNING: No compression effort provided\n");
+        }
+        else if ((strcmp(argv[i], "-ct") == 0) || (strcmp(argv[i], "--compression-threads") == 0))
+        {
+            if (((i + 1) < argc) && (argv[i + 1][0] != '-'))
+            {
+                int threads = TextToInteger(argv[i + 1]);   // Read provided compression threads value
+
+                if (threads >= 0) SetCompressionThreads(threads);
+                else printf("WARNING: Compression threads not valid, default to processors count\n");
+
+                i++;
+            }
+            else printf("WARNING: No compression threads provided\n");
+        }
+        else if ((strcmp(argv[i], "-inc") == 0) || (strcmp(argv[i], "--incremental") == 0))
+        {
+            incrementalBuild = true;
+        }
+        else if ((strcmp(argv[i], "-ib") == 0) || (strcmp(argv[i], "--ico-bmp") == 0))
+        {
+            icoBmpEntries = true;
+        }
+        else if ((strcmp(argv[i], "-cd") == 0) || (strcmp(argv[i], "--cache-dir") == 0))
+        {
+            if (((i + 1) < argc) && (argv[i + 1][0] != '-'))
+            {
+                if (DirectoryExists(argv[i + 1])) strncpy(outputCacheDir, argv[i + 1], sizeof(outputCacheDir) - 1);   // Read output cache directory
+                else printf("WARNING: Output cache directory not found, cache disabled: %s\n", argv[i + 1]);
+
+                i++;
+            }
+            else printf("WARNING: No output cache directory provided\n");
+        }
+        else if ((strcmp(argv[i], "-q") == 0) || (strcmp(argv[i], "--quantize") == 0))
+        {
+            if (((i + 1) < argc) && (argv[i + 1][0] != '-'))
+            {
+                int numValues = 0;
+                char **values = TextSplit(argv[i + 1], ',', &numValues);
+
+                for (int j = 0; (j < numValues) && (quantizeThresholdsCount < MAX_QUANTIZE_THRESHOLDS); j++)
+                {
+                    // Threshold provided per size (<size>:<psnr>) or for any size up to QUANTIZE_MAX_SIZE (<psnr>)
+                    const char *separator = strchr(values[j], ':');
+                    int size = (separator != NULL)? TextToInteger(values[j]) : 0;
+                    float minPSNR = (float)atof((separator != NULL)? (separator + 1) : values[j]);
+
+                    if ((size >= 0) && (size <= 1024) && (minPSNR > 0.0f))
+                    {
+                        quantizeThresholds[quantizeThresholdsCount] = (QuantizeThreshold){ size, minPSNR };
+                        quantizeThresholdsCount++;
+                    }
+                    else printf("WARNING: Quantization threshold not valid: %s\n", values[j]);
+                }
+
+                i++;
+            }
+            else printf("WARNING: No quantization threshold provided\n");
+        }
+        else if ((strcmp(argv[i], "-qd") == 0) || (strcmp(argv[i], "--quantize-dither") == 0))
+        {
+            if (((i + 1) < argc) && (argv[i + 1][0] != '-'))
+            {
+                int dithering = TextToInteger(argv[i + 1]);   // Read provided dithering strength (percentage)
+
+                if ((dithering >= 0) && (dithering <= 100)) quantizeDithering = dithering/100.0f;
+                else printf("WARNING: Quantization dithering not valid, default to 0 (no dithering)\n");
+
+                i++;
+            }
+            else printf("WARNING: No quantization dithering provided\n");
+        }
         else if ((strcmp(argv[i], "-xs") == 0) || (strcmp(argv[i], "--extract-size") == 0))
         {
             if (((i + 1) < argc) && (argv[i + 1][0] != '-'))
@@ -1330,10 +1897,20 @@ static void ProcessCommandLine(int argc, char *argv[])
             else printf("WARNING: No sizes provided\n");
         }
         else if ((strcmp(argv[i], "-xa") == 0) || (strcmp(argv[i], "--extract-all") == 0)) extractAll = true;
+        else if ((strcmp(argv[i], "-b") == 0) || (strcmp(argv[i], "--batch") == 0))
+        {
+            if (((i + 1) < argc) && (argv[i + 1][0] != '-'))
+            {
+                strcpy(batchFileName, argv[i + 1]);   // Read batch manifest filename
+                i++;
+            }
+            else printf("WARNING: No batch manifest file provided\n");
+        }
     }
 
-    // Process input files if provided
-    if (inputFilesCount > 0)
+    // Process batch manifest jobs if provided, input files otherwise
+    if (batchFileName[0] != '\0') ProcessBatchManifest(batchFileName, scaleAlgorythm, scaleQuality);
+    else if (inputFilesCount > 0)
     {
         if (outFileName[0] == '\0') strcpy(outFileName, (outPlatform == 1)? "output.icns" : "output.ico");  // Set a default name for output in case not provided
 
@@ -1341,33 +1918,138 @@ static void ProcessCommandLine(int argc, char *argv[])
         for (int i = 1; i < inputFilesCount; i++) printf(",%s", inputFiles[i]);
         printf("\nOutput file:      %s\n\n", outFileName);
 
-        printf(" > PROCESSING INPUT FILES\n");
+        IconPackJob job = {
+            .inputFiles = inputFiles,
+            .inputFilesCount = inputFilesCount,
+            .outFileName = outFileName,
+            .outPlatform = outPlatform,
+            .outSizes = outSizes,
+            .outSizesCount = outSizesCount,
+            .scaleAlgorythm = scaleAlgorythm,
+            .scaleQuality = scaleQuality,
+            .extractAll = extractAll,
+            .extractSizes = extractSize? extractSizes : NULL,
+            .extractSizesCount = extractSize? extractSizesCount : 0
+        };
+
+        ProcessIconPackJob(job, true);
+
+        for (int i = 0; i < inputFilesCount; i++) RL_FREE(inputFiles[i]);    // Free input file name memory
+        RL_FREE(inputFiles);           // Free input file names array memory
+    }
+
+    if (showUsageInfo) ShowCommandLineInfo();
+}
+
+// Process icon pack job: load input files into bucket, copy or generate output sizes and save icon file
+// NOTE: Bucket is cleared after job processing to be reused by next job
+static int ProcessIconPackJob(IconPackJob job, bool verbose)
+{
+    int outSizes[MAX_OUTPUT_SIZES] = { 0 };     // Sizes to generate
+    int outSizesCount = 0;                      // Number of sizes to generate
+    int savedCount = 0;
+
+    for (int i = 0; (i < job.outSizesCount) && (outSizesCount < MAX_OUTPUT_SIZES); i++) outSizes[outSizesCount++] = job.outSizes[i];
+
+    // Incremental build: inputs state checked against previous build manifest, no work required if nothing changed
+    // NOTE: Inputs with unchanged modification time are not hashed again
+    char manifestFileName[1024] = { 0 };
+    BuildManifest prevManifest = { 0 };
+    BuildManifest manifest = { 0 };
+    bool prevOutputValid = false;           // Previous output built with same parameters, entries can be reused
+
+    if (incrementalBuild)
+    {
+        snprintf(manifestFileName, sizeof(manifestFileName), "%s.rdeps", job.outFileName);
+        prevManifest = LoadBuildManifest(manifestFileName);
+        manifest = GetIconPackJobManifest(job, prevManifest);
 
-        // Load input files (all of them) into bucket,
-        // NOTE: If one size has been previously loaded, it is overriden
-        for (int i = 0; i < inputFilesCount; i++)
+        if (IsIconPackJobUpToDate(job, manifest, prevManifest))
         {
-            AddIconToBucket(&bucket, inputFiles[i]);
-            printf("\nInput file: %s - Added to icon bucket - Total files: %i\n", inputFiles[i], bucket.count);
+            if (verbose) printf(" > UP TO DATE, nothing to build: %s\n\n", job.outFileName);
+            savedCount = prevManifest.savedCount;
 
-            RL_FREE(inputFiles[i]);    // Free input file name memory
+            UnloadBuildManifest(manifest);
+            UnloadBuildManifest(prevManifest);
+            return savedCount;
         }
 
-        RL_FREE(inputFiles);           // Free input file names array memory
+        prevOutputValid = (prevManifest.savedCount > 0) && (manifest.paramsKey == prevManifest.paramsKey) && FileExists(job.outFileName);
+    }
+
+    // Output cache: job output files saved from cache if available, no input processing required
+    unsigned long long cacheKey = 0;
 
-        // Get bigger available input image in bucket
-        int biggerSizeIndex = 0;
-        int biggerSize = bucket.entries[0].size;
+    if (outputCacheDir[0] != '\0')
+    {
+        cacheKey = GetIconPackJobKey(job);
+        int cachedCount = (cacheKey != 0)? LoadIconPackJobFromCache(job, cacheKey) : -1;
 
-        for (int i = 1; i < bucket.count; i++)
+        if (cachedCount >= 0)
         {
-            if (bucket.entries[i].size > biggerSize)
+            if (verbose) printf(" > OUTPUT CACHE HIT (%016llx): %s\n\n", cacheKey, job.outFileName);
+
+            // NOTE: Output entries sources not available, entries not reused on next incremental build
+            if (incrementalBuild)
             {
-                biggerSize = bucket.entries[i].size;
-                biggerSizeIndex = i;
+                manifest.savedCount = cachedCount;
+                manifest.outputModTime = GetFileModTime(job.outFileName);
+                manifest.outputSize = GetFileLength(job.outFileName);
+                SaveBuildManifest(manifest, manifestFileName);
+                UnloadBuildManifest(manifest);
+                UnloadBuildManifest(prevManifest);
             }
+
+            return cachedCount;
+        }
+    }
+
+    if (verbose) printf(" > PROCESSING INPUT FILES\n");
+
+    int bucketSources[MAX_ICON_BUCKET_SIZE] = { 0 };    // Bucket entries source input index, required by incremental build
+
+    // Load input files (all of them) into bucket,
+    // NOTE: If one size has been previously loaded, it is overriden
+    for (int i = 0; i < job.inputFilesCount; i++)
+    {
+        // Bucket entries added or replaced (data changed) come from current input
+        const void *prevData[MAX_ICON_BUCKET_SIZE] = { 0 };
+        int prevCount = bucket.count;
+        for (int k = 0; k < bucket.count; k++) prevData[k] = (bucket.entries[k].data != NULL)? (const void *)bucket.entries[k].data : bucket.entries[k].image.data;
+
+        AddIconToBucket(&bucket, job.inputFiles[i]);
+        if (verbose) printf("\nInput file: %s - Added to icon bucket - Total files: %i\n", job.inputFiles[i], bucket.count);
+
+        for (int k = 0; k < bucket.count; k++)
+        {
+            const void *data = (bucket.entries[k].data != NULL)? (const void *)bucket.entries[k].data : bucket.entries[k].image.data;
+            if ((k >= prevCount) || (data != prevData[k])) bucketSources[k] = i;
+        }
+    }
+
+    if (bucket.count == 0)
+    {
+        printf("WARNING: No valid input images loaded for: %s\n", job.outFileName);
+        UnloadBuildManifest(manifest);
+        UnloadBuildManifest(prevManifest);
+        return 0;
+    }
+
+    // Get bigger available input image in bucket
+    int biggerSizeIndex = 0;
+    int biggerSize = bucket.entries[0].size;
+
+    for (int i = 1; i < bucket.count; i++)
+    {
+        if (bucket.entries[i].size > biggerSize)
+        {
+            biggerSize = bucket.entries[i].size;
+            biggerSizeIndex = i;
         }
+    }
 
+    if (verbose)
+    {
         printf("\nAll input images processed.\n");
         printf("Image sizes added to the bucket: %i (%i", bucket.count, bucket.entries[0].size);
         for (int i = 1; i < bucket.count; i++) printf(",%i", bucket.entries[i].size);
@@ -1375,855 +2057,3873 @@ static void ProcessCommandLine(int argc, char *argv[])
         printf("Biggest size available: %i\n\n", biggerSize);
 
         printf(" > PROCESSING OUTPUT FILE\n\n");
+    }
 
-        // Generate output sizes list by platform scheme
-        switch (outPlatform)
+    // Generate output sizes list by platform scheme
+    // NOTE: Platform sizes are appended to provided sizes, up to MAX_OUTPUT_SIZES
+    unsigned int *platformSizes = NULL;
+    int platformSizesCount = 0;
+
+    switch (job.outPlatform)
+    {
+        case ICON_PLATFORM_WINDOWS: platformSizes = icoSizesWindows; platformSizesCount = 8; break;
+        case ICON_PLATFORM_MACOS: platformSizes = icoSizesMacOS; platformSizesCount = 8; break;
+        case ICON_PLATFORM_FAVICON: platformSizes = icoSizesFavicon; platformSizesCount = 10; break;
+        case ICON_PLATFORM_ANDROID: platformSizes = icoSizesAndroid; platformSizesCount = 10; break;
+        case ICON_PLATFORM_IOS7: platformSizes = icoSizesiOS; platformSizesCount = 9; break;
+        default:
         {
-            case ICON_PLATFORM_WINDOWS: for (int i = 0; i < 8; i++) { outSizes[outSizesCount] = icoSizesWindows[i]; outSizesCount++; }; break;
-            case ICON_PLATFORM_MACOS: for (int i = 0; i < 8; i++) { outSizes[outSizesCount] = icoSizesMacOS[i]; outSizesCount++; }; break;
-            case ICON_PLATFORM_FAVICON: for (int i = 0; i < 10; i++) { outSizes[outSizesCount] = icoSizesFavicon[i]; outSizesCount++; }; break;
-            case ICON_PLATFORM_ANDROID: for (int i = 0; i < 10; i++) { outSizes[outSizesCount] = icoSizesAndroid[i]; outSizesCount++; }; break;
-            case ICON_PLATFORM_IOS7: for (int i = 0; i < 9; i++) { outSizes[outSizesCount] = icoSizesiOS[i]; outSizesCount++; }; break;
-            default: return;
+            ClearIconBucket(&bucket);
+            UnloadBuildManifest(manifest);
+            UnloadBuildManifest(prevManifest);
+            return 0;
         }
+    }
+
+    if ((outSizesCount + platformSizesCount) > MAX_OUTPUT_SIZES) printf("WARNING: Maximum output sizes reached (%i), %i platform sizes ignored\n",
+        MAX_OUTPUT_SIZES, outSizesCount + platformSizesCount - MAX_OUTPUT_SIZES);
+
+    for (int i = 0; (i < platformSizesCount) && (outSizesCount < MAX_OUTPUT_SIZES); i++) outSizes[outSizesCount++] = platformSizes[i];
 
-        IconEntry *outPack = NULL;
-        int outPackCount = 0;
+    IconEntry *outPack = NULL;
+    int outPackCount = 0;
+    int *outSources = NULL;             // Output entries source input index (copied or generated from)
 
-        if (outSizesCount > 0)
+    IconEntry *prevEntries = NULL;      // Previous output entries, reused if source input has not changed
+    int prevEntriesCount = 0;
+
+    int extractedSizes[MAX_ICON_BUCKET_SIZE + MAX_OUTPUT_SIZES] = { 0 };   // Extracted images sizes, required by output cache
+    int extractedCount = 0;
+    bool extractFailed = false;     // Any extracted image could not be saved, output not cached
+
+    if (outSizesCount > 0)
+    {
+        if (verbose)
         {
             printf("Output sizes requested: %i", outSizes[0]);
             for (int i = 1; i < outSizesCount; i++) printf(",%i", outSizes[i]);
             printf("\n");
+        }
 
-            // Generate custom sizes if required, use biggest available input size and use provided scale algorythm
-            outPackCount = outSizesCount;
-            outPack = (IconEntry *)RL_CALLOC(outPackCount, sizeof(IconEntry));
+        // Generate custom sizes if required, use biggest available input size and use provided scale algorythm
+        outPackCount = outSizesCount;
+        outPack = (IconEntry *)RL_CALLOC(outPackCount, sizeof(IconEntry));
+        outSources = (int *)RL_CALLOC(outPackCount, sizeof(int));
 
-            // Copy from inputPack or generate if required
-            for (int i = 0; i < outPackCount; i++)
+        if (prevOutputValid)
+        {
+            if (IsFileExtension(job.outFileName, ".icns")) prevEntries = LoadIconPackFromICNS(job.outFileName, &prevEntriesCount);
+            else prevEntries = LoadIconPackFromICO(job.outFileName, &prevEntriesCount);
+        }
+
+        // Copy from inputPack if available
+        for (int i = 0; i < outPackCount; i++)
+        {
+            outPack[i].size = outSizes[i];
+
+            // Get entry source input: input with same size or input with bigger size (generated)
+            bool copied = false;
+            outSources[i] = bucketSources[biggerSizeIndex];
+            for (int j = 0; j < bucket.count; j++) if (outPack[i].size == bucket.entries[j].size) { outSources[i] = bucketSources[j]; copied = true; }
+
+            // Generated entries requested to be extracted require previous build extracted image available
+            bool extractRequired = false;
+            for (int j = 0; !copied && (j < job.extractSizesCount); j++) if (job.extractSizes[j] == outPack[i].size) extractRequired = true;
+
+            // Reuse previous output entry data if it comes from same unchanged input
+            if ((prevEntries != NULL) && !IsBuildInputChanged(manifest, prevManifest, outSources[i]) &&
+                (!extractRequired || FileExists(TextFormat("%s_%ix%i.png", GetFileNameWithoutExt(job.outFileName), outPack[i].size, outPack[i].size))))
             {
-                outPack[i].size = outSizes[i];
+                bool sameSource = false;
+                for (int k = 0; k < prevManifest.entryCount; k++)
+                {
+                    if ((prevManifest.entrySizes[k] == outPack[i].size) && (prevManifest.entrySources[k] == outSources[i])) { sameSource = true; break; }
+                }
 
-                // Check input pack for size to copy
-                for (int j = 0; j < bucket.count; j++)
+                for (int k = 0; sameSource && (k < prevEntriesCount); k++)
                 {
-                    if (outPack[i].size == bucket.entries[j].size)
+                    if ((prevEntries[k].size == outPack[i].size) && (prevEntries[k].data != NULL))
                     {
-                        printf(" > Size %i: COPIED from input images.\n", outPack[i].size);
-                        outPack[i].image = bucket.entries[j].image;
+                        if (verbose) printf(" > Size %i: REUSED from previous output (input unchanged).\n", outPack[i].size);
+                        outPack[i].data = prevEntries[k].data;
+                        outPack[i].dataSize = prevEntries[k].dataSize;
+                        memcpy(outPack[i].text, prevEntries[k].text, MAX_IMAGE_TEXT_SIZE);
                         outPack[i].valid = true;
+                        outPack[i].reused = true;
                         break;
                     }
                 }
 
-                // Generate image size if not copied
-                if (!outPack[i].valid)
-                {
-                    printf(" > Size %i: GENERATED from input bigger image (%i).\n", outPack[i].size, biggerSize);
-                    outPack[i].image = ImageCopy(bucket.entries[biggerSizeIndex].image);
-
-                    if (scaleAlgorythm == 1) ImageResizeNN(&outPack[i].image, outPack[i].size, outPack[i].size);
-                    else if (scaleAlgorythm == 2) ImageResize(&outPack[i].image, outPack[i].size, outPack[i].size);
+                if (outPack[i].reused) continue;
+            }
 
-                    outPack[i].generated = true;
+            // Check input pack for size to copy
+            for (int j = 0; j < bucket.count; j++)
+            {
+                // NOTE: Entries with original PNG data are not decoded, data is written as is
+                if ((outPack[i].size == bucket.entries[j].size) && ((bucket.entries[j].data != NULL) || LoadIconEntryImage(&bucket.entries[j])))
+                {
+                    if (verbose) printf(" > Size %i: COPIED from input images.\n", outPack[i].size);
+                    outPack[i].image = bucket.entries[j].image;
+                    outPack[i].data = bucket.entries[j].data;
+                    outPack[i].dataSize = bucket.entries[j].dataSize;
+                    memcpy(outPack[i].text, bucket.entries[j].text, MAX_IMAGE_TEXT_SIZE);
                     outPack[i].valid = true;
+                    break;
                 }
             }
 
-            printf("\n");
+            if (verbose && !outPack[i].valid) printf(" > Size %i: GENERATED from input bigger image (%i).\n", outPack[i].size, biggerSize);
+        }
 
-            // Save into icon file provided pack entries
-            // NOTE: Only valid entries are exported, png zip packaging also done (if required)
-            if (outPlatform == 1) SaveIconPackToICNS(outPack, outPackCount, outFileName);
-            else SaveIconPackToICO(outPack, outPackCount, outFileName);
+        // Generate sizes not copied, cascaded from bigger to smaller size
+        long long generatedPixels = 0;
+        for (int i = 0; i < outPackCount; i++) if (!outPack[i].valid) generatedPixels += (long long)outPack[i].size*outPack[i].size;
+
+        double generationTime = GetTimeMilliseconds();
+        if (generatedPixels > 0)
+        {
+            LoadIconEntryImage(&bucket.entries[biggerSizeIndex]);
+            GenerateIconImages(bucket.entries[biggerSizeIndex].image, outPack, outPackCount, job.scaleAlgorythm, job.scaleQuality);
         }
-        else printf("WARNING: No output sizes defined\n");
+        generationTime = GetTimeMilliseconds() - generationTime;
+
+        if (verbose && (generatedPixels > 0)) printf("\nSizes generated in %.2f ms (%.2f Mpix/s generated)\n", generationTime, (double)generatedPixels/(generationTime*1000.0));
+
+        if (verbose) printf("\n");
+
+        // Copy inputs and previous output entries data borrowed from overwritten files
+        CopyIconEntriesSourceData(bucket.entries, bucket.count, outPack, outPackCount, job.outFileName);
+        CopyIconEntriesSourceData(prevEntries, prevEntriesCount, outPack, outPackCount, job.outFileName);
+
+        // Save into icon file provided pack entries
+        // NOTE: Only valid entries are exported, png zip packaging also done (if required),
+        // icon file format defined by output file extension (batch jobs platform is optional)
+        bool saved = false;
+        if (IsFileExtension(job.outFileName, ".icns")) saved = SaveIconPackToICNS(outPack, outPackCount, job.outFileName);
+        else saved = SaveIconPackToICO(outPack, outPackCount, job.outFileName);
+
+        if (saved) savedCount = outPackCount;
+        else printf("WARNING: Output file could not be saved: %s\n", job.outFileName);
+    }
+    else printf("WARNING: No output sizes defined\n");
 
-        // Extract required entries: all or provided sizes (only available ones)
-        if (extractAll)
+    // Extract required entries: all or provided sizes (only available ones)
+    if (job.extractAll)
+    {
+        // Extract all input pack entries
+        for (int i = 0; i < bucket.count; i++)
         {
-            // Extract all input pack entries
-            for (int i = 0; i < bucket.count; i++)
+            if (bucket.entries[i].valid && LoadIconEntryImage(&bucket.entries[i]))
             {
-                if (bucket.entries[i].valid)
-                {
-                    printf(" > Image extract requested (%i): %s_%ix%i.png\n", bucket.entries[i].size, GetFileNameWithoutExt(outFileName), bucket.entries[i].size, bucket.entries[i].size);
-                    ExportImage(bucket.entries[i].image, TextFormat("%s_%ix%i.png", GetFileNameWithoutExt(outFileName), bucket.entries[i].size, bucket.entries[i].size));
-                }
+                printf(" > Image extract requested (%i): %s_%ix%i.png\n", bucket.entries[i].size, GetFileNameWithoutExt(job.outFileName), bucket.entries[i].size, bucket.entries[i].size);
+                if (ExportImage(bucket.entries[i].image, TextFormat("%s_%ix%i.png", GetFileNameWithoutExt(job.outFileName), bucket.entries[i].size, bucket.entries[i].size))) extractedSizes[extractedCount++] = bucket.entries[i].size;
+                else extractFailed = true;
             }
         }
-        else if (extractSize)
+    }
+    else if (job.extractSizesCount > 0)
+    {
+        // Extract requested sizes from pack (if available)
+        for (int i = 0; i < bucket.count; i++)
         {
-            // Extract requested sizes from pack (if available)
-            for (int i = 0; i < bucket.count; i++)
+            for (int j = 0; j < job.extractSizesCount; j++)
             {
-                for (int j = 0; j < extractSizesCount; j++)
+                if ((bucket.entries[i].size == job.extractSizes[j]) && LoadIconEntryImage(&bucket.entries[i]))
                 {
-                    if (bucket.entries[i].size == extractSizes[j])
-                    {
-                        printf(" > Image extract requested (%i): %s_%ix%i.png\n", extractSizes[j], GetFileNameWithoutExt(outFileName), bucket.entries[i].size, bucket.entries[i].size);
-                        ExportImage(bucket.entries[i].image, TextFormat("%s_%ix%i.png", GetFileNameWithoutExt(outFileName), bucket.entries[i].size, bucket.entries[i].size));
-                    }
+                    printf(" > Image extract requested (%i): %s_%ix%i.png\n", job.extractSizes[j], GetFileNameWithoutExt(job.outFileName), bucket.entries[i].size, bucket.entries[i].size);
+                    if (!ExportImage(bucket.entries[i].image, TextFormat("%s_%ix%i.png", GetFileNameWithoutExt(job.outFileName), bucket.entries[i].size, bucket.entries[i].size))) extractFailed = true;
+                    else if (extractedCount < (MAX_ICON_BUCKET_SIZE + MAX_OUTPUT_SIZES)) extractedSizes[extractedCount++] = bucket.entries[i].size;
                 }
             }
+        }
 
-            // Extract requested sizes from output pack (if available)
-            for (int i = 0; i < outPackCount; i++)
+        // Extract requested sizes from output pack (if available)
+        // NOTE: Copied entries have been already extracted from bucket
+        for (int i = 0; i < outPackCount; i++)
+        {
+            // Reused entries not available in bucket were generated on previous build
+            bool reusedGenerated = outPack[i].reused;
+            for (int k = 0; reusedGenerated && (k < bucket.count); k++) if (bucket.entries[k].size == outPack[i].size) reusedGenerated = false;
+
+            for (int j = 0; j < job.extractSizesCount; j++)
             {
-                for (int j = 0; j < extractSizesCount; j++)
+                // NOTE: Reused generated entries keep previous build extracted image (same input)
+                if ((job.extractSizes[j] > 0) && (outPack[i].size == job.extractSizes[j]) && reusedGenerated)
                 {
-                    if ((extractSizes[j] > 0) && (outPack[i].size == extractSizes[j]))
-                    {
-                        printf(" > Image extract requested (%i): %s_%ix%i.png\n", extractSizes[j], GetFileNameWithoutExt(outFileName), outPack[i].size, outPack[i].size);
-                        ExportImage(outPack[i].image, TextFormat("%s_%ix%i.png", GetFileNameWithoutExt(outFileName), outPack[i].size, outPack[i].size));
-                    }
+                    printf(" > Image extract requested (%i): %s_%ix%i.png [kept from previous build]\n", job.extractSizes[j], GetFileNameWithoutExt(job.outFileName), outPack[i].size, outPack[i].size);
+                    if (extractedCount < (MAX_ICON_BUCKET_SIZE + MAX_OUTPUT_SIZES)) extractedSizes[extractedCount++] = outPack[i].size;
+                }
+                else if ((job.extractSizes[j] > 0) && (outPack[i].size == job.extractSizes[j]) && outPack[i].generated)
+                {
+                    printf(" > Image extract requested (%i): %s_%ix%i.png\n", job.extractSizes[j], GetFileNameWithoutExt(job.outFileName), outPack[i].size, outPack[i].size);
+                    if (!ExportImage(outPack[i].image, TextFormat("%s_%ix%i.png", GetFileNameWithoutExt(job.outFileName), outPack[i].size, outPack[i].size))) extractFailed = true;
+                    else if (extractedCount < (MAX_ICON_BUCKET_SIZE + MAX_OUTPUT_SIZES)) extractedSizes[extractedCount++] = outPack[i].size;
                 }
             }
         }
+    }
+
+    // Save output files into output cache for next runs
+    // NOTE: Only cached if all output files have been saved by this job (files read back from disk)
+    if ((cacheKey != 0) && (savedCount > 0) && !extractFailed) SaveIconPackJobToCache(job, cacheKey, savedCount, extractedSizes, extractedCount);
+
+    // Save build manifest for next incremental build: output entries sources and extracted images
+    // NOTE: Manifest only saved if output file has been saved, previous manifest removed otherwise
+    // (previous output file, if available, is not up to date)
+    if (incrementalBuild && (savedCount > 0))
+    {
+        manifest.savedCount = savedCount;
+        manifest.outputModTime = GetFileModTime(job.outFileName);
+        manifest.outputSize = GetFileLength(job.outFileName);
+        for (int i = 0; (i < outPackCount) && (manifest.entryCount < MAX_OUTPUT_SIZES); i++)
+        {
+            manifest.entrySizes[manifest.entryCount] = outPack[i].size;
+            manifest.entrySources[manifest.entryCount] = outSources[i];
+            manifest.entryCount++;
+        }
 
-        // Memory cleaning
-        for (int i = 0; i < bucket.count; i++) UnloadImage(bucket.entries[i].image);
-        for (int i = 0; i < outPackCount; i++) if (outPack[i].generated) UnloadImage(outPack[i].image);
-        RL_FREE(outPack);
+        for (int i = 0; i < extractedCount; i++) manifest.extractSizes[manifest.extractCount++] = extractedSizes[i];
+
+        SaveBuildManifest(manifest, manifestFileName);
     }
+    else if (incrementalBuild && FileExists(manifestFileName)) remove(manifestFileName);
 
-    if (showUsageInfo) ShowCommandLineInfo();
+    // Memory cleaning
+    // NOTE: Bucket allocation is kept to be reused by next job, reused entries data owned by previous entries
+    for (int i = 0; i < outPackCount; i++) if (outPack[i].generated) UnloadImage(outPack[i].image);
+    RL_FREE(outPack);
+    RL_FREE(outSources);
+
+    for (int i = 0; i < prevEntriesCount; i++) UnloadIconEntry(&prevEntries[i]);
+    RL_FREE(prevEntries);
+
+    UnloadBuildManifest(manifest);
+    UnloadBuildManifest(prevManifest);
+
+    ClearIconBucket(&bucket);
+
+    return savedCount;
 }
-#endif
 
-//--------------------------------------------------------------------------------------------
-// Load/Save/Export functions
-//--------------------------------------------------------------------------------------------
-// Get sizes as a text array separated by semicolon (ready for GuiListView())
-static char *GetTextIconSizes(IconPack pack)
+// Process batch manifest, one icon pack job per line
+// NOTE: Line format: <file01.ext>,[file02.ext],...;[platform];[size01],[size02],...;<output.ico|output.icns>
+// Process, icon bucket and worker pool are reused by all jobs, a timing summary is shown at the end
+static void ProcessBatchManifest(const char *fileName, int scaleAlgorythm, int scaleQuality)
 {
-    static char buffer[512] = { 0 };
-    memset(buffer, 0, 512);
+    // Batch job result, for timing summary
+    typedef struct {
+        int line;                   // Manifest line
+        const char *outFileName;    // Output file name (pointing to manifest text)
+        int entryCount;             // Entries saved (0 if failed)
+        double time;                // Processing time in milliseconds
+    } BatchJobResult;
 
-    int offset = 0;
-    int length = 0;
-    memcpy(buffer, "ALL;", 4);
-    offset += 4;
+    char *text = LoadFileText(fileName);
 
-    for (int i = 0; i < pack.count; i++)
+    if (text == NULL)
     {
-        length = TextLength(TextFormat("%i x %i;", pack.entries[i].size, pack.entries[i].size));
-        memcpy(buffer + offset, TextFormat("%i x %i;", pack.entries[i].size, pack.entries[i].size), length);
-        offset += length;
+        printf("WARNING: Batch manifest file could not be loaded: %s\n", fileName);
+        return;
     }
 
-    buffer[offset - 1] = '\0';
-
-    return buffer;
-}
-
-// Icon File Header (6 bytes)
-typedef struct {
-    unsigned short reserved;    // Must always be 0
-    unsigned short imageType;   // Specifies image type: 1 for icon (.ICO) image, 2 for cursor (.CUR) image. Other values are invalid
-    unsigned short imageCount;  // Specifies number of entries in the file
-} IcoHeader;
+    int resultsCount = 0;
+    int resultsCapacity = 256;
+    BatchJobResult *results = (BatchJobResult *)RL_CALLOC(resultsCapacity, sizeof(BatchJobResult));
 
-// Icon Entry info (16 bytes)
-typedef struct {
-    unsigned char width;        // Specifies image width in pixels. Can be any number between 0 and 255. Value 0 means image width is 256 pixels
-    unsigned char height;       // Specifies image height in pixels. Can be any number between 0 and 255. Value 0 means image height is 256 pixels
-    unsigned char colpalette;   // Specifies number of colors in the color palette. Should be 0 if the image does not use a color palette
-    unsigned char reserved;     // Reserved. Should be 0
-    unsigned short planes;      // In ICO format: Specifies color planes; should be 0 or 1
-    // In CUR format: Specifies the horizontal coordinates of the hotspot in number of pixels from the left
-    unsigned short bpp;         // In ICO format: Specifies bits per pixel. [Notes 4]
-    // In CUR format: Specifies the vertical coordinates of the hotspot in number of pixels from the top.
-    unsigned int size;          // Specifies the size of the image's data in bytes
-    unsigned int offset;        // Specifies the offset of BMP or PNG data from the beginning of the ICO/CUR file
-} IcoDirEntry;
+    printf("\nBatch manifest:   %s\n\n", fileName);
 
-// Icon data loader
-static IconEntry *LoadIconPackFromICO(const char *fileName, int *count)
-{
-    IconEntry *entries = NULL;
-    int imageCounter = 0;
+    double batchStartTime = GetTimeMilliseconds();
 
-    FILE *icoFile = fopen(fileName, "rb");
+    char *line = text;
+    int lineNumber = 0;
 
-    if (icoFile != NULL)
+    while ((line != NULL) && (line[0] != '\0'))
     {
-        // Load .ico information
-        IcoHeader icoHeader = { 0 };
-        fread(&icoHeader, sizeof(IcoHeader), 1, icoFile);
-
-        entries = (IconEntry *)RL_CALLOC(icoHeader.imageCount, sizeof(IconEntry));
-
-        IcoDirEntry *icoDirEntry = (IcoDirEntry *)RL_CALLOC(icoHeader.imageCount, sizeof(IcoDirEntry));
+        char *nextLine = strchr(line, '\n');
+        if (nextLine != NULL) { nextLine[0] = '\0'; nextLine++; }
+        lineNumber++;
 
-        for (int i = 0; i < icoHeader.imageCount; i++) fread(&icoDirEntry[i], sizeof(IcoDirEntry), 1, icoFile);
+        line = TrimTextInPlace(line);
 
-        for (int i = 0; i < icoHeader.imageCount; i++)
+        if ((line[0] != '\0') && (line[0] != '#'))
         {
-            unsigned char *icoImageData = (unsigned char *)RL_CALLOC(icoDirEntry[i].size, 1);
-            fread(icoImageData, 1, icoDirEntry[i].size, icoFile);    // Read icon image data
+            char *fields[4] = { 0 };
+            char *inputFiles[MAX_BATCH_JOB_INPUTS] = { 0 };
+            int outSizes[MAX_OUTPUT_SIZES] = { 0 };
+            int outSizesCount = 0;
+            int outPlatform = ICON_PLATFORM_WINDOWS;
 
-            // Verify PNG signature for loaded image data
-            if ((icoImageData[0] == 0x89) &&
-                (icoImageData[1] == 0x50) &&
-                (icoImageData[2] == 0x4e) &&
-                (icoImageData[3] == 0x47) &&
-                (icoImageData[4] == 0x0d) &&
-                (icoImageData[5] == 0x0a) &&
-                (icoImageData[6] == 0x1a) &&
-                (icoImageData[7] == 0x0a))
+            if (SplitTextInPlace(line, ';', fields, 4) == 4)
             {
-                // Reading image data from memory buffer
-                // WARNING: Image data on th IcoDirEntry may be in either:
-                //  - Windows BMP format, excluding the BITMAPFILEHEADER structure
-                //  - PNG format, stored in its entirety
-                // NOTE: Only supporting the PNG format, not BMP data
-                entries[i].image = LoadImageFromMemory(".png", icoImageData, icoDirEntry[i].size);
+                for (int i = 0; i < 4; i++) fields[i] = TrimTextInPlace(fields[i]);
+
+                int inputFilesCount = SplitTextInPlace(fields[0], ',', inputFiles, MAX_BATCH_JOB_INPUTS);
+                for (int i = 0; i < inputFilesCount; i++) inputFiles[i] = TrimTextInPlace(inputFiles[i]);
 
-                if ((entries[i].image.data != NULL) && (entries[i].image.width != 0))
+                if (fields[1][0] != '\0') outPlatform = TextToInteger(fields[1]);
+
+                if (fields[2][0] != '\0')
                 {
-                    entries[i].size = entries[i].image.width;   // Icon size (expected squared)
-                    entries[i].valid = false;                   // Not valid until it is checked against the current package (sizes)
+                    char *values[MAX_OUTPUT_SIZES] = { 0 };
+                    int valuesCount = SplitTextInPlace(fields[2], ',', values, MAX_OUTPUT_SIZES);
+
+                    for (int i = 0; i < valuesCount; i++)
+                    {
+                        int value = TextToInteger(TrimTextInPlace(values[i]));
+
+                        if ((value > 0) && (value <= 256)) outSizes[outSizesCount++] = value;
+                        else printf("WARNING: [line %i] Provided generation size not valid: %i\n", lineNumber, value);
+                    }
+                }
 
-                    // Read custom rIconPacker text chunk from PNG
-                    rpng_chunk chunk = rpng_chunk_read_from_memory(icoImageData, "rIPt");
-                    memcpy(entries[i].text, chunk.data, (chunk.length < MAX_IMAGE_TEXT_SIZE)? chunk.length : MAX_IMAGE_TEXT_SIZE - 1);
-                    RPNG_FREE(chunk.data);
+                if ((inputFiles[0][0] == '\0') || (fields[3][0] == '\0')) printf("WARNING: [line %i] Input or output files not provided\n", lineNumber);
+                else if ((outPlatform < 0) || (outPlatform > 4)) printf("WARNING: [line %i] Platform requested not recognized\n", lineNumber);
+                else if (!IsFileExtension(fields[3], ".ico;.icns")) printf("WARNING: [line %i] Output file extension not recognized\n", lineNumber);
+                else
+                {
+                    IconPackJob job = {
+                        .inputFiles = inputFiles,
+                        .inputFilesCount = inputFilesCount,
+                        .outFileName = fields[3],
+                        .outPlatform = outPlatform,
+                        .outSizes = outSizes,
+                        .outSizesCount = outSizesCount,
+                        .scaleAlgorythm = scaleAlgorythm,
+                        .scaleQuality = scaleQuality
+                    };
+
+                    if (resultsCount >= resultsCapacity)
+                    {
+                        resultsCapacity *= 2;
+                        results = (BatchJobResult *)RL_REALLOC(results, resultsCapacity*sizeof(BatchJobResult));
+                    }
 
-                    imageCounter++;
+                    double startTime = GetTimeMilliseconds();
+                    results[resultsCount].entryCount = ProcessIconPackJob(job, false);
+                    results[resultsCount].time = GetTimeMilliseconds() - startTime;
+                    results[resultsCount].line = lineNumber;
+                    results[resultsCount].outFileName = fields[3];
+                    resultsCount++;
                 }
             }
-
-            RL_FREE(icoImageData);
+            else printf("WARNING: [line %i] Batch job not valid, expected 4 fields separated by ';'\n", lineNumber);
         }
 
-        RL_FREE(icoDirEntry);
-
-        fclose(icoFile);
+        line = nextLine;
     }
 
-    *count = imageCounter;
-    return entries;
-}
-
-// Save icon (.ico)
-// NOTE: Make sure entries array sizes are valid!
-static void SaveIconPackToICO(IconEntry *entries, int entryCount, const char *fileName)
-{
-    // Verify icon pack valid entries (not placeholder ones)
-    int packValidCount = 0;
-    for (int i = 0; i < entryCount; i++) if (entries[i].valid) packValidCount++;
-
-    if (packValidCount == 0) return;
+    double batchTime = GetTimeMilliseconds() - batchStartTime;
 
-    // Define ico file header and entry
-    IcoHeader icoHeader = { .reserved = 0, .imageType = 1, .imageCount = packValidCount };
-    IcoDirEntry *icoDirEntry = (IcoDirEntry *)RL_CALLOC(icoHeader.imageCount, sizeof(IcoDirEntry));
+    // Show jobs timing summary
+    int failedCount = 0;
 
-    char **pngDataPtrs = (char **)RL_CALLOC(icoHeader.imageCount, sizeof(char *));     // Pointers array to PNG image data
-    int offset = 6 + 16*icoHeader.imageCount;
+    printf("\n > BATCH JOBS SUMMARY\n\n");
+    printf("    JOB     LINE    ENTRIES    TIME (ms)    OUTPUT\n");
 
-    // Get image png data (and pointers to each image)
-    // NOTE: In case of PNG export as ZIP, files are directly packed in the loop, one by one
-    for (int i = 0, k = 0; i < entryCount; i++)
+    for (int i = 0; i < resultsCount; i++)
     {
-        if (entries[i].valid)
-        {
-            int fileSize = 0;           // Store generated png file size (with rIPt chunk)
-            int tempFileSize = 0;       // Store generated png file size (no text chunk)
-            int colorChannels = 0;
-
-            // Compress entries data into PNG file data streams
-            // Image data format could be RGB (3 bytes) instead of RGBA (4 bytes)
-            if (entries[i].image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8) colorChannels = 3;
-            else if (entries[i].image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) colorChannels = 4;
-
-            // NOTE: Memory is allocated internally using RPNG_MALLOC(), must be freed with RPNG_FREE()
-            char *tempPngData = rpng_save_image_to_memory(entries[i].image.data, entries[i].image.width, entries[i].image.height, colorChannels, 8, &tempFileSize);
+        if (results[i].entryCount == 0) failedCount++;
 
-            // Check if exporting text chunks is required
-            if (exportTextChunkChecked && (entries[i].text[0] != '\0'))
-            {
-                // Add image text chunks to generated PNGs
-                rpng_chunk chunk = { 0 };
-                chunk.data = entries[i].text;
-                chunk.length = strlen(entries[i].text);
-                memcpy(chunk.type, "rIPt", 4);
-                pngDataPtrs[k] = rpng_chunk_write_from_memory(tempPngData, chunk, &fileSize);
-            }
-            else
-            {
-                pngDataPtrs[k] = tempPngData;
-                fileSize = tempFileSize;
-            }
+        printf("    %-6i  %-6i  %-9i  %11.2f    %s%s\n", i + 1, results[i].line, results[i].entryCount,
+            results[i].time, results[i].outFileName, (results[i].entryCount == 0)? " [FAILED]" : "");
+    }
 
-            icoDirEntry[k].width = (entries[i].image.width == 256)? 0 : entries[i].image.width;
-            icoDirEntry[k].height = (entries[i].image.width == 256)? 0 : entries[i].image.width;
-            icoDirEntry[k].bpp = 32;
-            icoDirEntry[k].size = fileSize;
-            icoDirEntry[k].offset = offset;
+    printf("\nJobs processed: %i (%i failed)\n", resultsCount, failedCount);
+    printf("Total time: %.2f ms (%.2f ms per job)\n\n", batchTime, (resultsCount > 0)? batchTime/resultsCount : 0.0);
 
-            offset += fileSize;
-            k++;
-        }
-    }
+    RL_FREE(results);
+    UnloadFileText(text);
+}
 
-    FILE *icoFile = fopen(fileName, "wb");
+// Get icon pack job content hash: input files data (in order) and generation/encoding parameters
+// NOTE: Returns 0 if any input file can not be loaded (job not cached)
+static unsigned long long GetIconPackJobKey(IconPackJob job)
+{
+    unsigned long long key = GetDataHash(TOOL_VERSION, (unsigned int)strlen(TOOL_VERSION), OUTPUT_CACHE_VERSION);
 
-    if (icoFile != NULL)
+    for (int i = 0; i < job.inputFilesCount; i++)
     {
-        // Write ico header
-        fwrite(&icoHeader, sizeof(IcoHeader), 1, icoFile);
+        MappedFile file = LoadMappedFile(job.inputFiles[i]);
+        if (file.data == NULL) return 0;
 
-        // Write icon entries entries data
-        for (int i = 0; i < icoHeader.imageCount; i++) fwrite(&icoDirEntry[i], sizeof(IcoDirEntry), 1, icoFile);
+        key = GetDataHash(file.data, file.size, key);
+        UnloadMappedFile(file);
+    }
 
-        // Write icon png data
-        for (int i = 0; i < icoHeader.imageCount; i++) fwrite(pngDataPtrs[i], icoDirEntry[i].size, 1, icoFile);
+    return GetIconPackJobParamsKey(job, key);
+}
 
-        fclose(icoFile);
-    }
+// Get icon pack job generation/encoding parameters hash (input files data not included)
+static unsigned long long GetIconPackJobParamsKey(IconPackJob job, unsigned long long seed)
+{
+    // NOTE: Compression threads define image data stripes, compressed data depends on it
+    int params[14] = { job.inputFilesCount, job.outPlatform, job.outSizesCount, job.scaleAlgorythm, job.scaleQuality,
+        job.extractAll, job.extractSizesCount, IsFileExtension(job.outFileName, ".icns"), compressionEffort,
+        exportTextChunkChecked, quantizeThresholdsCount, (int)(quantizeDithering*1000.0f), icoBmpEntries, compressionThreads };
 
-    // Free used data (pngs data)
-    for (int i = 0; i < icoHeader.imageCount; i++) RPNG_FREE(pngDataPtrs[i]);
+    unsigned long long key = GetDataHash(params, sizeof(params), seed);
+    key = GetDataHash(job.outSizes, job.outSizesCount*sizeof(int), key);
+    key = GetDataHash(job.extractSizes, job.extractSizesCount*sizeof(int), key);
+    key = GetDataHash(quantizeThresholds, quantizeThresholdsCount*sizeof(QuantizeThreshold), key);
 
-    RL_FREE(icoDirEntry);
-    RL_FREE(pngDataPtrs);
+    return key;
 }
 
-// Save images as .png
-static void ExportIconPackImages(IconEntry *entries, int entryCount, const char *fileName)
+// Save job output files from output cache, returns entries saved, -1 if not cached
+// NOTE: Cached data is validated before writing any output file, output files are written as is (no processing),
+// in case any output file can not be written, -1 is returned (job must be processed)
+static int LoadIconPackJobFromCache(IconPackJob job, unsigned long long key)
 {
-    // Verify icon pack valid entries (not placeholder ones)
-    int packValidCount = 0;
-    for (int i = 0; i < entryCount; i++) if (entries[i].valid) packValidCount++;
+    int entryCount = -1;
+    char cacheFileName[1024] = { 0 };
+    snprintf(cacheFileName, sizeof(cacheFileName), "%s/%016llx.rcache", outputCacheDir, key);
 
-    if (packValidCount == 0) return;
+    if (!FileExists(cacheFileName)) return -1;
 
-    char **pngDataPtrs = (char **)RL_CALLOC(packValidCount, sizeof(char *));     // Pointers array to PNG image data
+    MappedFile file = LoadMappedFile(cacheFileName);
+    OutputCacheHeader header = { 0 };
 
-    // Get image png data (and pointers to each image)
-    // NOTE: In case of PNG export as ZIP, files are directly packed in the loop, one by one
-    for (int i = 0, k = 0; i < entryCount; i++)
+    if ((file.data != NULL) && (file.size >= sizeof(OutputCacheHeader))) memcpy(&header, file.data, sizeof(OutputCacheHeader));
+
+    if ((memcmp(header.id, "rIPc", 4) == 0) && (header.version == OUTPUT_CACHE_VERSION) && (header.fileCount > 0))
     {
-        if (entries[i].valid)
+        // Check cached files are contained in cache file data
+        unsigned int offset = sizeof(OutputCacheHeader);
+        bool valid = true;
+
+        for (int i = 0; valid && (i < header.fileCount); i++)
         {
-            int fileSize = 0;           // Store generated png file size (with rIPt chunk)
-            int tempFileSize = 0;       // Store generated png file size (no text chunk)
-            int colorChannels = 0;
+            int fileInfo[2] = { 0 };    // Cached file type (0: icon file, extracted image size otherwise) and size
+
+            if ((file.size - offset) < sizeof(fileInfo)) valid = false;
+            else
+            {
+                memcpy(fileInfo, file.data + offset, sizeof(fileInfo));
+                offset += sizeof(fileInfo);
 
-            // Compress entries data into PNG file data streams
-            // Image data format could be RGB (3 bytes) instead of RGBA (4 bytes)
-            if (entries[i].image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8) colorChannels = 3;
-            else if (entries[i].image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) colorChannels = 4;
+                if ((fileInfo[0] < 0) || (fileInfo[1] < 0) || ((unsigned int)fileInfo[1] > (file.size - offset))) valid = false;
+                else offset += fileInfo[1];
+            }
+        }
 
-            // NOTE: Memory is allocated internally using RPNG_MALLOC(), must be freed with RPNG_FREE()
-            char *tempPngData = rpng_save_image_to_memory(entries[i].image.data, entries[i].image.width, entries[i].image.height, colorChannels, 8, &tempFileSize);
+        if (valid && (offset == file.size))
+        {
+            bool saved = true;
+            offset = sizeof(OutputCacheHeader);
 
-            // Check if exporting text chunks is required
-            if (exportTextChunkChecked && (entries[i].text[0] != '\0'))
+            for (int i = 0; i < header.fileCount; i++)
             {
-                // Add image text chunks to generated PNGs
-                rpng_chunk chunk = { 0 };
-                chunk.data = entries[i].text;
-                chunk.length = strlen(entries[i].text);
-                memcpy(chunk.type, "rIPt", 4);
-                pngDataPtrs[k] = rpng_chunk_write_from_memory(tempPngData, chunk, &fileSize);
+                int fileInfo[2] = { 0 };
+                memcpy(fileInfo, file.data + offset, sizeof(fileInfo));
+                offset += sizeof(fileInfo);
+
+                const char *fileName = (fileInfo[0] == 0)? job.outFileName :
+                    TextFormat("%s_%ix%i.png", GetFileNameWithoutExt(job.outFileName), fileInfo[0], fileInfo[0]);
+                FileDataSegment segment = { file.data + offset, (unsigned int)fileInfo[1] };
+
+                if (!SaveFileDataSegments(fileName, &segment, 1))
+                {
+                    printf("WARNING: Output file could not be saved from cache: %s\n", fileName);
+                    saved = false;
+                }
+
+                offset += fileInfo[1];
             }
+
+            if (saved) entryCount = header.entryCount;
             else
             {
-                pngDataPtrs[k] = tempPngData;
-                fileSize = tempFileSize;
+                UnloadMappedFile(file);
+                return -1;
             }
-
-#if defined(EXPORT_IMAGE_PACK_AS_ZIP)
-            // Export a single .zip file containing all images
-            // Package every image into an output ZIP file (fileName.zip)
-            mz_bool status = mz_zip_add_mem_to_archive_file_in_place(TextFormat("%s.zip", fileName), TextFormat("%s_%ix%i.png", GetFileNameWithoutExt(fileName), entries[i].image.width, entries[i].image.height), pngDataPtrs[i], fileSize, NULL, 0, MZ_BEST_SPEED); //MZ_BEST_COMPRESSION, MZ_DEFAULT_COMPRESSION
-            if (!status) LOG("WARNING: Zip accumulation process failed\n");
-#else
-            // Save every PNG file individually
-            SaveFileData(TextFormat("%s/%s_%ix%i.png", GetDirectoryPath(fileName), GetFileNameWithoutExt(fileName), entries[i].image.width, entries[i].image.height), pngDataPtrs[i], fileSize);
-#endif
-            k++;
         }
     }
 
-    // Free used data (pngs data)
-    for (int i = 0; i < packValidCount; i++) RPNG_FREE(pngDataPtrs[i]);
-    RL_FREE(pngDataPtrs);
-}
-
-// Icns data loader
-// NOTE: ARGB and JPEG2000 image data formats not supported, only PNG
-static IconEntry *LoadIconPackFromICNS(const char *fileName, int *count)
-{
-    #define MAX_ICNS_IMAGE_SUPPORTED    32
-
-    #define SWAP_INT32(x) (((x) >> 24) | (((x) & 0x00ff0000) >> 8) | (((x) & 0x0000ff00) << 8) | ((x) << 24))
+    if (entryCount < 0) printf("WARNING: Output cache file not valid, ignored: %s\n", cacheFileName);
 
-    IconEntry *entries = NULL;
-    unsigned int imageCounter = 0;
-
-    FILE *icnsFile = fopen(fileName, "rb");
-
-    if (icnsFile != NULL)
-    {
-        unsigned char icnsSig[4] = { 0 };
-        fread(icnsSig, 1, 4, icnsFile);
-
-        if ((icnsSig[0] == 'i') && (icnsSig[1] == 'c') && (icnsSig[2] == 'n') && (icnsSig[3] == 's'))
-        {
-            unsigned char icnType[4] = { 0 };
-            unsigned int fileSize = 0;
-            unsigned int sizeBE = 0;
-            fread(&sizeBE, sizeof(unsigned int), 1, icnsFile);
-            fileSize = SWAP_INT32(sizeBE);
-
-            // Allocate space for the maximum number of entries supported
-            // NOTE: Only the valid loaded images will be filled, some entries will be empty,
-            // but the returned entries count will refer to the loaded images
-            // There shouldn't be any problem when freeing the pointer...
-            entries = (IconEntry *)RL_CALLOC(MAX_ICNS_IMAGE_SUPPORTED, sizeof(IconEntry));
-
-            unsigned int processedSize = 8;
-
-            for (int i = 0; (i < MAX_ICNS_IMAGE_SUPPORTED) && (processedSize < fileSize); i++)
-            {
-                fread(icnType, 1, 4, icnsFile);
-
-                unsigned int icnSize = 0;
-                fread(&sizeBE, sizeof(unsigned int), 1, icnsFile);
-                icnSize = SWAP_INT32(sizeBE);
-
-                processedSize += 8;     // IcnType an IcnSize parameters
-                icnSize -= 8;           // IcnSize also considers type and size parameters, it must be subtracted to get actual data size
-
-                LOG("INFO: [%s] ICNS OSType: %c%c%c%c [%i bytes]\n", GetFileName(fileName), icnType[0], icnType[1], icnType[2], icnType[3], icnSize);
-
-                // NOTE: Only supported formats including PNG data
-                if (((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == 'p') && (icnType[3] == '4')) ||   // 16x16, icp4, not properly displayed on .app
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == 'p') && (icnType[3] == '5')) ||   // 32x32, icp5, not properly displayed on .app
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == 'p') && (icnType[3] == '6')) ||   // 48x48, icp6, not properly displayed on .app
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == '0') && (icnType[3] == '4')) ||   // 16x16, ic04
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == 's') && (icnType[3] == 'b')) ||   // 18x18, icsb
-                    ((icnType[0] == 's') && (icnType[1] == 'b') && (icnType[2] == '2') && (icnType[3] == '4')) ||   // 24x24, sb24
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == 'p') && (icnType[3] == '5')) ||   // 32x32, icp5, not properly displayed on .app
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == '0') && (icnType[3] == '5')) ||   // 32x32, ic05 (16x16@2x "retina")
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == '1') && (icnType[3] == '1')) ||   // 32x32, ic11 (16x16@2x "retina")
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == 's') && (icnType[3] == 'B')) ||   // 36x36, icsB (18x18@2x "retina")
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == 'p') && (icnType[3] == '6')) ||   // 48x48, icp6, not properly displayed on .app
-                    ((icnType[0] == 'S') && (icnType[1] == 'B') && (icnType[2] == '2') && (icnType[3] == '4')) ||   // 48x48, SB24 (24x24@2x "retina")
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == '1') && (icnType[3] == '2')) ||   // 64x64, ic12 (32x32@2x "retina")
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == '0') && (icnType[3] == '7')) ||   // 128x128, ic07
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == '0') && (icnType[3] == '8')) ||   // 256x256, ic08
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == '1') && (icnType[3] == '3')) ||   // 256x256, ic13 (128x128@2x "retina")
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == '0') && (icnType[3] == '9')) ||   // 512x512, ic09
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == '1') && (icnType[3] == '4')) ||   // 512x512, ic14 (256x256@2x "retina")
-                    ((icnType[0] == 'i') && (icnType[1] == 'c') && (icnType[2] == '1') && (icnType[3] == '0')))     // 1024x1024, ic10 (512x512@2x "retina")
-                {
-                    // NOTE: Only support loading PNG data, JPEG2000 and ARGB data not supported
-
-                    unsigned char *icnImageData = (unsigned char *)RL_CALLOC(icnSize, 1);
-                    fread(icnImageData, 1, icnSize, icnsFile);
-
-                    // Verify PNG signature for loaded image data
-                    if ((icnImageData[0] == 0x89) &&
-                        (icnImageData[1] == 0x50) &&
-                        (icnImageData[2] == 0x4e) &&
-                        (icnImageData[3] == 0x47) &&
-                        (icnImageData[4] == 0x0d) &&
-                        (icnImageData[5] == 0x0a) &&
-                        (icnImageData[6] == 0x1a) &&
-                        (icnImageData[7] == 0x0a))
-                    {
-                        // Data contains a valid PNG file, it can be loaded
-                        /*
-                        int colors = 0;
-                        int bits = 0;
-                        int width = 0;
-                        int height = 0;
-                        char *data = rpng_load_image_from_memory(icnImageData, &width, &height, &colors, &bits); // Image loaded successfully
-                        Image image = {
-                            .width = width,
-                            .height = height,
-                            .mipmaps = 1,
-                            .data = data,
-                            .format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8
-                        };
-                        entries[imageCounter].image = image;
-                        //if (image.width == 512) ExportImage(image, "D:\\testing_512x512.png");    // Image saved successfully, no lost pixels
-                        */
-
-                        entries[imageCounter].image = LoadImageFromMemory(".png", icnImageData, icnSize);
-
-                        if ((entries[imageCounter].image.data != NULL) && (entries[imageCounter].image.width != 0))
-                        {
-                            entries[imageCounter].size = entries[imageCounter].image.width;   // Icon size (expected squared)
-                            entries[imageCounter].valid = false;    // Not valid until it is checked against the current package (sizes)
-                            entries[imageCounter].generated = false;
+    UnloadMappedFile(file);
 
-                            // Read custom rIconPacker text chunk from PNG
-                            rpng_chunk chunk = rpng_chunk_read_from_memory(icnImageData, "rIPt");
-                            memcpy(entries[imageCounter].text, chunk.data, (chunk.length < MAX_IMAGE_TEXT_SIZE)? chunk.length : MAX_IMAGE_TEXT_SIZE - 1);
-                            RPNG_FREE(chunk.data);
+    return entryCount;
+}
 
-                            imageCounter++;
-                        }
-                    }
-                    else LOG("WARNING: ICNS data format not supported\n");
+// Save job output files into output cache
+// NOTE: Output files are read back once written: icon file and extracted images (by size)
+static void SaveIconPackJobToCache(IconPackJob job, unsigned long long key, int entryCount, const int *extractedSizes, int extractedCount)
+{
+    int fileCount = 1 + extractedCount;
+    MappedFile *files = (MappedFile *)RL_CALLOC(fileCount, sizeof(MappedFile));
+    int *fileInfo = (int *)RL_CALLOC(fileCount*2, sizeof(int));
+    FileDataSegment *segments = (FileDataSegment *)RL_CALLOC(1 + fileCount*2, sizeof(FileDataSegment));
 
-                    // JPEG2000 data signatures (not supported)
-                    // Option 1: 0x00 0x00 0x00 0x0c 0x6a 0x50 0x20 0x20 0x0d 0x0a 0x87 0x0a
-                    // Option 2: 0xff 0x4f 0xff 0x51
+    OutputCacheHeader header = { 0 };
+    memcpy(header.id, "rIPc", 4);
+    header.version = OUTPUT_CACHE_VERSION;
+    header.entryCount = entryCount;
+    header.fileCount = fileCount;
+    segments[0] = (FileDataSegment){ &header, sizeof(OutputCacheHeader) };
 
-                    // Useful for the future: ARGB to RGBA
-                    /*
-                    // Source is in format: 0xAARRGGBB
-                    ((x & 0xFF000000) >> 24) | //______AA
-                    ((x & 0x00FF0000) >>  8) | //____RR__
-                    ((x & 0x0000FF00) <<  8) | //__GG____
-                    ((x & 0x000000FF) << 24);  //BB______
-                    // Return value is in format:  0xBBGGRRAA   -> ARGB?
-                    */
+    bool valid = true;
 
-                    RL_FREE(icnImageData);
-                }
-                else
-                {
-                    // In case OSType is not supported, just skip the required size
-                    fseek(icnsFile, icnSize, SEEK_CUR);
-                }
+    for (int i = 0; valid && (i < fileCount); i++)
+    {
+        int type = (i == 0)? 0 : extractedSizes[i - 1];
+        const char *fileName = (type == 0)? job.outFileName : TextFormat("%s_%ix%i.png", GetFileNameWithoutExt(job.outFileName), type, type);
 
-                processedSize += icnSize;
-            }
+        files[i] = LoadMappedFile(fileName);
 
-            LOG("INFO: Total images extracted from ICNS file: %i\n", imageCounter);
+        if (files[i].data != NULL)
+        {
+            fileInfo[i*2] = type;
+            fileInfo[i*2 + 1] = (int)files[i].size;
+            segments[1 + i*2] = (FileDataSegment){ &fileInfo[i*2], 2*sizeof(int) };
+            segments[2 + i*2] = (FileDataSegment){ files[i].data, files[i].size };
         }
+        else valid = false;
+    }
 
-        fclose(icnsFile);
+    if (valid)
+    {
+        char cacheFileName[1024] = { 0 };
+        snprintf(cacheFileName, sizeof(cacheFileName), "%s/%016llx.rcache", outputCacheDir, key);
+
+        if (!SaveFileDataSegments(cacheFileName, segments, 1 + fileCount*2)) printf("WARNING: Output cache file could not be saved: %s\n", cacheFileName);
     }
 
-    *count = imageCounter;
-    return entries;
+    for (int i = 0; i < fileCount; i++) if (files[i].data != NULL) UnloadMappedFile(files[i]);
+
+    RL_FREE(segments);
+    RL_FREE(fileInfo);
+    RL_FREE(files);
 }
 
-// Save icns file (Apple)
-// LIMITATIONS:
-//  - Supported OS Version: >=10.7
-//  - Supported PNG compressed images only
-//  - Supported OSTypes [8]: ic11, SB24, ic12, ic07, ic13, ic14, ic10
-//  - Supported image sizes [8]: 32, 48, 64, 128, 256, 512, 1024
-//  - No TOC or additional chunks supported
-//  - Main focus on .app package icns generation
-// REF: https://en.wikipedia.org/wiki/Apple_Icon_Image_format
-static void SaveIconPackToICNS(IconEntry *entries, int entryCount, const char *fileName)
+// Get icon pack job build manifest: inputs state (modification time and content hash) and parameters hash
+// NOTE: Inputs with same file name and modification time than previous manifest are not hashed again,
+// inputs not available get a 0 hash (always considered changed)
+static BuildManifest GetIconPackJobManifest(IconPackJob job, BuildManifest prevManifest)
 {
-    // Verify icon pack valid entries (not placeholder ones)
-    int packValidCount = 0;
-    for (int i = 0; i < entryCount; i++) if (entries[i].valid) packValidCount++;
-    if (packValidCount == 0) return;
-/*
-    // NOTE: This validation is not required because it is already done when
-    // adding icons from input files into icon package entries
+    BuildManifest manifest = { 0 };
 
-    #define ICNS_MAX_SUPPORTED_IMAGES   8
+    manifest.paramsKey = GetIconPackJobParamsKey(job, GetDataHash(TOOL_VERSION, (unsigned int)strlen(TOOL_VERSION), BUILD_MANIFEST_VERSION));
+    manifest.inputCount = job.inputFilesCount;
+    manifest.inputs = (BuildManifestInput *)RL_CALLOC((job.inputFilesCount > 0)? job.inputFilesCount : 1, sizeof(BuildManifestInput));
 
-    // Validate input entries image data to get only supported sizes
-    int validCount = 0;
-    int validIndex[ICNS_MAX_SUPPORTED_IMAGES] = { -1 };
-    for (int i = 0; (i < entryCount) && (validCount < ICNS_MAX_SUPPORTED_IMAGES); i++)
+    for (int i = 0; i < job.inputFilesCount; i++)
     {
-        if ((entries[i].image.width == 16) && (entries[i].image.height == 16)) { validIndex[validCount] = i; validCount++; }
-        else if ((entries[i].image.width == 32) && (entries[i].image.height == 32)) { validIndex[validCount] = i; validCount++; }
-        else if ((entries[i].image.width == 48) && (entries[i].image.height == 48)) { validIndex[validCount] = i; validCount++; }
-        else if ((entries[i].image.width == 64) && (entries[i].image.height == 64)) { validIndex[validCount] = i; validCount++; }
-        else if ((entries[i].image.width == 128) && (entries[i].image.height == 128)) { validIndex[validCount] = i; validCount++; }
-        else if ((entries[i].image.width == 256) && (entries[i].image.height == 256)) { validIndex[validCount] = i; validCount++; }
-        else if ((entries[i].image.width == 512) && (entries[i].image.height == 512)) { validIndex[validCount] = i; validCount++; }
-        else if ((entries[i].image.width == 1024) && (entries[i].image.height == 1024)) { validIndex[validCount] = i; validCount++; }
-    }
-*/
-    // Compress provided images into PNG data
-    char **pngDataPtrs = (char **)RL_CALLOC(packValidCount, sizeof(char *));     // Pointers array to PNG image data
-    unsigned int *pngDataSizes = (unsigned int *)RL_CALLOC(packValidCount, sizeof(unsigned int));   // PNG data size
+        BuildManifestInput *input = &manifest.inputs[i];
+        strncpy(input->fileName, job.inputFiles[i], sizeof(input->fileName) - 1);
 
-    // Get image png data (and pointers to each image)
-    // NOTE: In case of PNG export as ZIP, files are directly packed in the loop, one by one
-    for (int i = 0, k = 0; i < entryCount; i++)
-    {
-        if (entries[i].valid)
-        {
-            // Compress entries data into PNG file data streams
-            // Image data format could be RGB (3 bytes) instead of RGBA (4 bytes)
-            int colorChannels = 0;
-            if (entries[i].image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8) colorChannels = 3;
-            else if (entries[i].image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) colorChannels = 4;
+        if (!FileExists(input->fileName)) continue;
 
-            // NOTE: Memory is allocated internally using RPNG_MALLOC(), must be freed with RPNG_FREE()
-            pngDataPtrs[k] = rpng_save_image_to_memory(entries[i].image.data, entries[i].image.width, entries[i].image.height, colorChannels, 8, &pngDataSizes[k]);
+        input->modTime = GetFileModTime(input->fileName);
 
-            k++;
+        if ((i < prevManifest.inputCount) && (input->modTime != 0) && (input->modTime == prevManifest.inputs[i].modTime) &&
+            (strcmp(input->fileName, prevManifest.inputs[i].fileName) == 0)) input->key = prevManifest.inputs[i].key;
+        else
+        {
+            MappedFile file = LoadMappedFile(input->fileName);
+            if (file.data != NULL) input->key = GetDataHash(file.data, file.size, 0);
+            UnloadMappedFile(file);
         }
     }
 
-    // Got the images converted to PNG in memory, now the icns file can be created
+    return manifest;
+}
+
+// Check if build manifest input has changed from previous manifest (file name or content)
+static bool IsBuildInputChanged(BuildManifest manifest, BuildManifest prevManifest, int index)
+{
+    if ((index >= manifest.inputCount) || (index >= prevManifest.inputCount) || (manifest.inputs[index].key == 0)) return true;
 
-    FILE *icnsFile = fopen(fileName, "wb");
+    return ((manifest.inputs[index].key != prevManifest.inputs[index].key) || (strcmp(manifest.inputs[index].fileName, prevManifest.inputs[index].fileName) != 0));
+}
+
+// Check if icon pack job output files are up to date: same parameters and inputs, output files available and unchanged
+static bool IsIconPackJobUpToDate(IconPackJob job, BuildManifest manifest, BuildManifest prevManifest)
+{
+    if ((prevManifest.savedCount <= 0) || (manifest.paramsKey != prevManifest.paramsKey) ||
+        (manifest.inputCount != prevManifest.inputCount) || !FileExists(job.outFileName)) return false;
+
+    // Output file must be the one saved by previous build (not replaced or modified)
+    if ((GetFileModTime(job.outFileName) != prevManifest.outputModTime) || (GetFileLength(job.outFileName) != prevManifest.outputSize)) return false;
 
-    if (icnsFile != NULL)
+    for (int i = 0; i < manifest.inputCount; i++) if (IsBuildInputChanged(manifest, prevManifest, i)) return false;
+
+    for (int i = 0; i < prevManifest.extractCount; i++)
     {
-        /*
-        // Data structures to know how data is organized inside the .icns file
+        if (!FileExists(TextFormat("%s_%ix%i.png", GetFileNameWithoutExt(job.outFileName), prevManifest.extractSizes[i], prevManifest.extractSizes[i]))) return false;
+    }
 
-        // Icns File Header (8 bytes)
-        typedef struct {
-        unsigned char id[4];        // Magic literal: "icns" (0x69, 0x63, 0x6e, 0x73)
-        unsigned int size;          // Length of file, in bytes, MSB first (Big Endian)
-        } IcnsHeader;
+    return true;
+}
 
-        for (int i = 0; i < count; i++)
-        {
-        // Icon Entry info (8 bytes + data)
-        typedef struct {
-        unsigned char type[4];      // Icon type, defined by OSType (Big Endian)
-        unsigned int dataSize;      // Length of data, in bytes (including type and length), MSB first
-        unsigned char *data;        // Icon data
-        } IcnsEntry;
-        }
-        */
+// Load build manifest from text file, manifest parameters hash is 0 if not available or not valid
+// NOTE: Line format: "rIPd <version> <params-hash> <saved-count> <output-mod-time> <output-size>" (header), "input <mod-time> <hash> <file-name>",
+// "entry <size> <input-index>" and "extract <size>"
+static BuildManifest LoadBuildManifest(const char *fileName)
+{
+    BuildManifest manifest = { 0 };
 
-        // Write icns header signature
-        // unsigned char icnsId[4] = { 0x69, 0x63, 0x6e, 0x73 };     // "icns"
-        fwrite("icns", 1, 4, icnsFile);
+    if (!FileExists(fileName)) return manifest;
 
-        // ICNS file size, all file including header,
-        // Init it with expected chunck size but every generated PNG size needs to be accumulated
-        unsigned int icnsFileSize = 8 + 8*packValidCount;
-        for (int i = 0; i < packValidCount; i++) icnsFileSize += pngDataSizes[i];
-        unsigned char sizeBE[4] = { 0 };
+    char *text = LoadFileText(fileName);
+    if (text == NULL) return manifest;
 
-        // Write icns total data size (Big Endian)
-        sizeBE[0] = (icnsFileSize >> 24) & 0xff;
-        sizeBE[1] = (icnsFileSize >> 16) & 0xff;
-        sizeBE[2] = (icnsFileSize >> 8) & 0xff;
-        sizeBE[3] = icnsFileSize & 0xff;
-        fwrite(sizeBE, 1, 4, icnsFile);
+    int inputsCapacity = 0;
+    bool valid = false;
 
-        unsigned char icnType[4] = { 0 };
+    char *line = text;
 
-        // Write icns entries
-        for (int i = 0, k = 0; i < entryCount; i++)
-        {
-            if (entries[i].valid)
-            {
-                switch (entries[i].image.width)
-                {
-                    case 16:   { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = 'p'; icnType[3] = '4'; } break;   // icp4, not properly displayed on .app
-                    //case 32: { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = 'p'; icnType[3] = '5'; } break;   // icp5, not properly displayed on .app
-                    case 32:   { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '1'; icnType[3] = '1'; } break;   // ic11 (16x16@2x "retina")
-                    //case 48: { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = 'p'; icnType[3] = '6'; } break;   // icp6, not properly displayed on .app
-                    case 48:   { icnType[0] = 'S'; icnType[1] = 'B'; icnType[2] = '2'; icnType[3] = '4'; } break;   // SB24 (24x24@2x "retina")
-                    case 64:   { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '1'; icnType[3] = '2'; } break;   // ic12 (32x32@2x "retina")
-                    case 128:  { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '0'; icnType[3] = '7'; } break;   // ic07
-                   //case 256: { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '0'; icnType[3] = '8'; } break;   // ic08
-                    case 256:  { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '1'; icnType[3] = '3'; } break;   // ic13 (128x128@2x "retina")
-                   //case 512: { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '0'; icnType[3] = '9'; } break;   // ic09
-                    case 512:  { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '1'; icnType[3] = '4'; } break;   // ic14 (256x256@2x "retina")
-                    case 1024: { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '1'; icnType[3] = '0'; } break;   // ic10 (512x512@2x "retina")
-                    default: LOG("WARNING: Image size for ICNS generation not supported!\n"); break;
-                }
+    while ((line != NULL) && (line[0] != '\0'))
+    {
+        char *nextLine = strchr(line, '\n');
+        if (nextLine != NULL) { nextLine[0] = '\0'; nextLine++; }
+
+        line = TrimTextInPlace(line);
 
-                // Write entry type
-                fwrite(icnType, 1, 4, icnsFile);
+        int version = 0;
+        long long modTime = 0;
+        unsigned long long key = 0;
+        int size = 0;
+        int source = 0;
+        int offset = 0;
 
-                // Write entry size (Big endian)
-                unsigned int size = pngDataSizes[k] + 8;   // Size must include type and length size
-                sizeBE[0] = (size >> 24) & 0xff;
-                sizeBE[1] = (size >> 16) & 0xff;
-                sizeBE[2] = (size >> 8) & 0xff;
-                sizeBE[3] = size & 0xff;
-                fwrite(sizeBE, 1, 4, icnsFile);
+        if (!valid)
+        {
+            // Header required as first line, version checked
+            if ((sscanf(line, "rIPd %i %llx %i %lld %i", &version, &manifest.paramsKey, &manifest.savedCount, &modTime, &manifest.outputSize) != 5) ||
+                (version != BUILD_MANIFEST_VERSION)) break;
 
-                // Write entry PNG icon data
-                fwrite(pngDataPtrs[k], pngDataSizes[k], 1, icnsFile);
+            manifest.outputModTime = (long)modTime;
+            valid = true;
+        }
+        else if ((sscanf(line, "input %lld %llx %n", &modTime, &key, &offset) == 2) && (offset > 0))
+        {
+            if (manifest.inputCount >= inputsCapacity)
+            {
+                inputsCapacity = (inputsCapacity > 0)? inputsCapacity*2 : 16;
+                manifest.inputs = (BuildManifestInput *)RL_REALLOC(manifest.inputs, inputsCapacity*sizeof(BuildManifestInput));
+            }
 
-                k++;
+            BuildManifestInput *input = &manifest.inputs[manifest.inputCount];
+            memset(input, 0, sizeof(BuildManifestInput));
+            input->modTime = (long)modTime;
+            input->key = key;
+            strncpy(input->fileName, line + offset, sizeof(input->fileName) - 1);
+            manifest.inputCount++;
+        }
+        else if (sscanf(line, "entry %i %i", &size, &source) == 2)
+        {
+            if (manifest.entryCount < MAX_OUTPUT_SIZES)
+            {
+                manifest.entrySizes[manifest.entryCount] = size;
+                manifest.entrySources[manifest.entryCount] = source;
+                manifest.entryCount++;
             }
         }
+        else if (sscanf(line, "extract %i", &size) == 1)
+        {
+            if (manifest.extractCount < (MAX_ICON_BUCKET_SIZE + MAX_OUTPUT_SIZES)) manifest.extractSizes[manifest.extractCount++] = size;
+        }
 
-        fclose(icnsFile);
+        line = nextLine;
     }
 
-    // Free used data (pngs data)
-    for (int i = 0; i < packValidCount; i++) RPNG_FREE(pngDataPtrs[i]);
+    UnloadFileText(text);
 
-    RL_FREE(pngDataPtrs);
-    RL_FREE(pngDataSizes);
+    if (!valid)
+    {
+        UnloadBuildManifest(manifest);
+        manifest = (BuildManifest){ 0 };
+    }
+
+    return manifest;
 }
 
-// Get text lines available on icon pack
-// NOTE: Only valid icons considered
-static unsigned int CountIconPackTextLines(IconPack pack)
+// Save build manifest to text file (temp file renamed on completion)
+static void SaveBuildManifest(BuildManifest manifest, const char *fileName)
 {
-    //static const char *textLines[MAX_PACK_ELEMENTS] = { 0 }; // Pointers array to possible text lines
-    unsigned int counter = 0;
+    int textCapacity = 128 + manifest.inputCount*(sizeof(manifest.inputs[0].fileName) + 64) + (manifest.entryCount + manifest.extractCount)*32;
+    char *text = (char *)RL_CALLOC(textCapacity, 1);
+    int textSize = 0;
 
-    for (int i = 0; i < pack.count; i++)
+    textSize += snprintf(text + textSize, textCapacity - textSize, "rIPd %i %016llx %i %lld %i\n", BUILD_MANIFEST_VERSION, manifest.paramsKey, manifest.savedCount,
+        (long long)manifest.outputModTime, manifest.outputSize);
+
+    for (int i = 0; i < manifest.inputCount; i++)
     {
-        if (pack.entries[i].valid && (strlen(pack.entries[i].text) > 0))
-        {
-            //textLines[counter] = pack.entries[i].text;
-            counter++;
-        }
+        textSize += snprintf(text + textSize, textCapacity - textSize, "input %lld %016llx %s\n",
+            (long long)manifest.inputs[i].modTime, manifest.inputs[i].key, manifest.inputs[i].fileName);
     }
 
-    return counter;
+    for (int i = 0; i < manifest.entryCount; i++) textSize += snprintf(text + textSize, textCapacity - textSize, "entry %i %i\n", manifest.entrySizes[i], manifest.entrySources[i]);
+    for (int i = 0; i < manifest.extractCount; i++) textSize += snprintf(text + textSize, textCapacity - textSize, "extract %i\n", manifest.extractSizes[i]);
+
+    FileDataSegment segment = { text, (unsigned int)textSize };
+    if (!SaveFileDataSegments(fileName, &segment, 1)) printf("WARNING: Build manifest could not be saved: %s\n", fileName);
+
+    RL_FREE(text);
 }
 
-// Add icon to bucket
-static void AddIconToBucket(IconBucket *bucket, const char *fileName)
+// Unload build manifest inputs data
+static void UnloadBuildManifest(BuildManifest manifest)
 {
-    IconEntry *entries = NULL;
-    int imageCount = 0;
-
-    // Load all available entries
-    if (IsFileExtension(fileName, ".ico")) entries = LoadIconPackFromICO(fileName, &imageCount);
-    if (IsFileExtension(fileName, ".icns")) entries = LoadIconPackFromICNS(fileName, &imageCount);
-    else if (IsFileExtension(fileName, ".png;.bmp;.qoi"))
-    {
-        Image image = LoadImage(fileName);
+    RL_FREE(manifest.inputs);
+}
+#endif
 
-        // Minimal image validation
-        if ((image.data != NULL) && (image.width <= 1024) && (image.width == image.height))
-        {
-            imageCount = 1;
-            entries = (IconEntry *)RL_CALLOC(imageCount, sizeof(IconEntry));
-            entries[0].image = image;
+//--------------------------------------------------------------------------------------------
+// Load/Save/Export functions
+//--------------------------------------------------------------------------------------------
+// Get sizes as a text array separated by semicolon (ready for GuiListView())
+static char *GetTextIconSizes(IconPack pack)
+{
+    static char buffer[512] = { 0 };
+    memset(buffer, 0, 512);
+
+    int offset = 0;
+    int length = 0;
+    memcpy(buffer, "ALL;", 4);
+    offset += 4;
+
+    for (int i = 0; i < pack.count; i++)
+    {
+        length = TextLength(TextFormat("%i x %i;", pack.entries[i].size, pack.entries[i].size));
+        memcpy(buffer + offset, TextFormat("%i x %i;", pack.entries[i].size, pack.entries[i].size), length);
+        offset += length;
+    }
+
+    buffer[offset - 1] = '\0';
+
+    return buffer;
+}
+
+// Icon File Header (6 bytes)
+typedef struct {
+    unsigned short reserved;    // Must always be 0
+    unsigned short imageType;   // Specifies image type: 1 for icon (.ICO) image, 2 for cursor (.CUR) image. Other values are invalid
+    unsigned short imageCount;  // Specifies number of entries in the file
+} IcoHeader;
+
+// Icon Entry info (16 bytes)
+typedef struct {
+    unsigned char width;        // Specifies image width in pixels. Can be any number between 0 and 255. Value 0 means image width is 256 pixels
+    unsigned char height;       // Specifies image height in pixels. Can be any number between 0 and 255. Value 0 means image height is 256 pixels
+    unsigned char colpalette;   // Specifies number of colors in the color palette. Should be 0 if the image does not use a color palette
+    unsigned char reserved;     // Reserved. Should be 0
+    unsigned short planes;      // In ICO format: Specifies color planes; should be 0 or 1
+    // In CUR format: Specifies the horizontal coordinates of the hotspot in number of pixels from the left
+    unsigned short bpp;         // In ICO format: Specifies bits per pixel. [Notes 4]
+    // In CUR format: Specifies the vertical coordinates of the hotspot in number of pixels from the top.
+    unsigned int size;          // Specifies the size of the image's data in bytes
+    unsigned int offset;        // Specifies the offset of BMP or PNG data from the beginning of the ICO/CUR file
+} IcoDirEntry;
+
+// ICO BMP data header (BITMAPINFOHEADER), followed by palette (up to 8 bits per pixel), color bitmap and AND mask
+typedef struct {
+    unsigned int size;          // Header size (40 bytes)
+    int width;                  // Bitmap width
+    int height;                 // Bitmap height: color bitmap and AND mask (image height*2)
+    unsigned short planes;      // Color planes, must be 1
+    unsigned short bitCount;    // Bits per pixel: 1, 4, 8, 24, 32
+    unsigned int compression;   // Compression type, only 0 (BI_RGB) supported
+    unsigned int imageSize;     // Color bitmap and AND mask size, can be 0 for BI_RGB
+    int xPixelsPerMeter;        // Horizontal resolution (not used)
+    int yPixelsPerMeter;        // Vertical resolution (not used)
+    unsigned int colorsUsed;    // Palette colors, 0 for bits per pixel maximum
+    unsigned int colorsImportant; // Palette important colors (not used)
+} IcoBmpInfoHeader;
+
+// Swap red and blue channels of 32 bit pixels (BGRA <-> RGBA)
+// NOTE: Source and destination can be the same buffer, SIMD: 4 pixels per step (SSE2), 16 pixels per step (NEON)
+static void SwapPixelsRedBlue(const unsigned char *src, unsigned char *dst, int pixelCount)
+{
+    int i = 0;
+
+#if defined(SUPPORT_SIMD_SSE2)
+    const __m128i maskGA = _mm_set1_epi32((int)0xff00ff00);
+    const __m128i maskRB = _mm_set1_epi32(0x00ff00ff);
+
+    for (; (i + 4) <= pixelCount; i += 4)
+    {
+        __m128i pixels = _mm_loadu_si128((const __m128i *)(src + i*4));
+        __m128i rb = _mm_and_si128(pixels, maskRB);
+        rb = _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16));
+        _mm_storeu_si128((__m128i *)(dst + i*4), _mm_or_si128(_mm_and_si128(pixels, maskGA), rb));
+    }
+#elif defined(SUPPORT_SIMD_NEON)
+    for (; (i + 16) <= pixelCount; i += 16)
+    {
+        uint8x16x4_t pixels = vld4q_u8(src + i*4);
+        uint8x16_t red = pixels.val[0];
+        pixels.val[0] = pixels.val[2];
+        pixels.val[2] = red;
+        vst4q_u8(dst + i*4, pixels);
+    }
+#endif
+
+    for (; i < pixelCount; i++)
+    {
+        unsigned char red = src[i*4];
+        dst[i*4] = src[i*4 + 2];
+        dst[i*4 + 1] = src[i*4 + 1];
+        dst[i*4 + 2] = red;
+        dst[i*4 + 3] = src[i*4 + 3];
+    }
+}
+
+// Load icon entry from ICO BMP data (DIB, no file header): 1, 4, 8, 24 and 32 bits per pixel (BI_RGB)
+// NOTE: Color bitmap (bottom-up) is followed by 1 bit AND mask (transparency), used if color bitmap has no alpha
+// (32 bit with all alpha values 0 included), image decoded on loading, returned entry size is 0 if data is not valid
+static IconEntry LoadIconEntryFromBMP(const unsigned char *data, unsigned int dataSize)
+{
+    IconEntry entry = { 0 };
+    IcoBmpInfoHeader header = { 0 };
+
+    if (dataSize >= sizeof(IcoBmpInfoHeader)) memcpy(&header, data, sizeof(IcoBmpInfoHeader));
+
+    int size = header.width;
+    int bpp = header.bitCount;
+    int colorCount = (bpp <= 8)? ((header.colorsUsed > 0)? (int)header.colorsUsed : (1 << bpp)) : 0;
+
+    // Color and mask bitmaps height included in header height, squared images expected
+    if ((header.size < sizeof(IcoBmpInfoHeader)) || (header.size > dataSize) || (size <= 0) || (size > 256) || (header.height != size*2) ||
+        (header.compression != 0) || ((bpp != 1) && (bpp != 4) && (bpp != 8) && (bpp != 24) && (bpp != 32)) || ((bpp <= 8) && (colorCount > (1 << bpp))))
+    {
+        LOG("WARNING: ICO BMP data format not supported\n");
+        return entry;
+    }
+
+    unsigned int colorStride = ((size*bpp + 31)/32)*4;
+    unsigned int maskStride = ((size + 31)/32)*4;
+    unsigned int pixelsOffset = header.size + colorCount*4;
+
+    if ((pixelsOffset > dataSize) || ((unsigned long long)colorStride*size > (dataSize - pixelsOffset)))
+    {
+        LOG("WARNING: ICO BMP data out of bounds\n");
+        return entry;
+    }
+
+    // AND mask not available on some 32 bit entries
+    const unsigned char *mask = data + pixelsOffset + colorStride*size;
+    if ((unsigned long long)maskStride*size > (dataSize - pixelsOffset - colorStride*size)) mask = NULL;
+
+    // Palette converted to RGBA once, indices copied as 32 bit values
+    unsigned char palette[256][4] = { 0 };
+    for (int i = 0; i < colorCount; i++)
+    {
+        const unsigned char *color = data + header.size + i*4;
+        palette[i][0] = color[2];
+        palette[i][1] = color[1];
+        palette[i][2] = color[0];
+        palette[i][3] = 255;
+    }
+
+    unsigned char *pixels = (unsigned char *)RL_MALLOC(size*size*4);
+    bool useMask = (bpp < 32);
+
+    for (int y = 0; y < size; y++)
+    {
+        const unsigned char *src = data + pixelsOffset + (size - 1 - y)*colorStride;   // Bottom-up rows
+        unsigned char *dst = pixels + y*size*4;
+
+        switch (bpp)
+        {
+            case 32: SwapPixelsRedBlue(src, dst, size); break;
+            case 24:
+            {
+                for (int x = 0; x < size; x++)
+                {
+                    dst[x*4] = src[x*3 + 2];
+                    dst[x*4 + 1] = src[x*3 + 1];
+                    dst[x*4 + 2] = src[x*3];
+                    dst[x*4 + 3] = 255;
+                }
+            } break;
+            case 8: for (int x = 0; x < size; x++) memcpy(dst + x*4, palette[src[x]], 4); break;
+            case 4: for (int x = 0; x < size; x++) memcpy(dst + x*4, palette[(src[x >> 1] >> ((x & 1)? 0 : 4)) & 0x0f], 4); break;
+            case 1: for (int x = 0; x < size; x++) memcpy(dst + x*4, palette[(src[x >> 3] >> (7 - (x & 7))) & 0x01], 4); break;
+            default: break;
+        }
+    }
+
+    // 32 bit data with all alpha values 0 uses AND mask (opaque if not available)
+    if (bpp == 32)
+    {
+        useMask = true;
+        for (int i = 0; i < size*size; i++) if (pixels[i*4 + 3] != 0) { useMask = false; break; }
+    }
+
+    if (useMask)
+    {
+        for (int y = 0; y < size; y++)
+        {
+            const unsigned char *maskRow = (mask != NULL)? (mask + (size - 1 - y)*maskStride) : NULL;
+            unsigned char *dst = pixels + y*size*4;
+
+            for (int x = 0; x < size; x++) dst[x*4 + 3] = ((maskRow != NULL) && ((maskRow[x >> 3] >> (7 - (x & 7))) & 0x01))? 0 : 255;
+        }
+    }
+
+    entry.size = size;
+    entry.image.data = pixels;
+    entry.image.width = size;
+    entry.image.height = size;
+    entry.image.mipmaps = 1;
+    entry.image.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+
+    return entry;
+}
+
+// Save icon entry image as ICO BMP data (DIB, no file header): 32 bit BGRA color bitmap and 1 bit AND mask
+// NOTE: Entry image decoded on a copy if required (entry not modified), RGBA/RGB images supported,
+// AND mask bit set for fully transparent pixels, returned data must be freed with RL_FREE()
+static unsigned char *SaveIconEntryBMP(const IconEntry *entry, int *dataSize)
+{
+    unsigned char *data = NULL;
+    *dataSize = 0;
+
+    IconEntry temp = *entry;
+
+    if (LoadIconEntryImage(&temp) && ((temp.image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) || (temp.image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8)))
+    {
+        int size = temp.size;
+        int colorStride = size*4;
+        int maskStride = ((size + 31)/32)*4;
+
+        IcoBmpInfoHeader header = { 0 };
+        header.size = sizeof(IcoBmpInfoHeader);
+        header.width = size;
+        header.height = size*2;     // Color and mask bitmaps
+        header.planes = 1;
+        header.bitCount = 32;
+        header.imageSize = (colorStride + maskStride)*size;
+
+        *dataSize = sizeof(IcoBmpInfoHeader) + header.imageSize;
+        data = (unsigned char *)RL_CALLOC(*dataSize, 1);
+        memcpy(data, &header, sizeof(IcoBmpInfoHeader));
+
+        unsigned char *colors = data + sizeof(IcoBmpInfoHeader);
+        unsigned char *mask = colors + colorStride*size;
+
+        for (int y = 0; y < size; y++)
+        {
+            unsigned char *dst = colors + (size - 1 - y)*colorStride;   // Bottom-up rows
+            unsigned char *maskRow = mask + (size - 1 - y)*maskStride;
+
+            if (temp.image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) SwapPixelsRedBlue((unsigned char *)temp.image.data + y*size*4, dst, size);
+            else
+            {
+                const unsigned char *src = (unsigned char *)temp.image.data + y*size*3;
+
+                for (int x = 0; x < size; x++)
+                {
+                    dst[x*4] = src[x*3 + 2];
+                    dst[x*4 + 1] = src[x*3 + 1];
+                    dst[x*4 + 2] = src[x*3];
+                    dst[x*4 + 3] = 255;
+                }
+            }
+
+            for (int x = 0; x < size; x++) if (dst[x*4 + 3] == 0) maskRow[x >> 3] |= (0x80 >> (x & 7));
+        }
+    }
+
+    if (temp.image.data != entry->image.data) UnloadImage(temp.image);
+
+    return data;
+}
+
+// Icon data loader
+// NOTE: File is memory-mapped, directory entries are validated against file size, PNG entries borrow
+// PNG data from file data (decoded on demand by LoadIconEntryImage()), BMP entries are decoded on loading
+static IconEntry *LoadIconPackFromICO(const char *fileName, int *count)
+{
+    IconEntry *entries = NULL;
+    int imageCounter = 0;
+
+    SharedMappedFile *icoShared = LoadSharedMappedFile(fileName);
+
+    if (icoShared != NULL)
+    {
+        MappedFile icoFile = icoShared->file;
+
+        // Load .ico information
+        IcoHeader icoHeader = { 0 };
+        if (icoFile.size >= sizeof(IcoHeader)) memcpy(&icoHeader, icoFile.data, sizeof(IcoHeader));
+
+        // Validate header and directory entries fit into file
+        if ((icoHeader.reserved != 0) || (icoHeader.imageType != 1) ||
+            ((sizeof(IcoHeader) + icoHeader.imageCount*sizeof(IcoDirEntry)) > icoFile.size))
+        {
+            LOG("WARNING: [%s] ICO file header not valid\n", fileName);
+            icoHeader.imageCount = 0;
+        }
+
+        if (icoHeader.imageCount > 0) entries = (IconEntry *)RL_CALLOC(icoHeader.imageCount, sizeof(IconEntry));
+
+        for (int i = 0; i < icoHeader.imageCount; i++)
+        {
+            IcoDirEntry icoDirEntry = { 0 };
+            memcpy(&icoDirEntry, icoFile.data + sizeof(IcoHeader) + i*sizeof(IcoDirEntry), sizeof(IcoDirEntry));
+
+            // Validate image data is contained in file
+            if ((icoDirEntry.offset > icoFile.size) || (icoDirEntry.size > (icoFile.size - icoDirEntry.offset)) || (icoDirEntry.size < 8))
+            {
+                LOG("WARNING: [%s] ICO entry %i data out of file bounds\n", fileName, i);
+                continue;
+            }
+
+            const unsigned char *icoImageData = icoFile.data + icoDirEntry.offset;
+
+            // Image data on the IcoDirEntry may be in either:
+            //  - Windows BMP format, excluding the BITMAPFILEHEADER structure
+            //  - PNG format, stored in its entirety
+            // NOTE: Data format detected from PNG signature, BMP data starts with header size
+            if ((icoImageData[0] == 0x89) &&
+                (icoImageData[1] == 0x50) &&
+                (icoImageData[2] == 0x4e) &&
+                (icoImageData[3] == 0x47) &&
+                (icoImageData[4] == 0x0d) &&
+                (icoImageData[5] == 0x0a) &&
+                (icoImageData[6] == 0x1a) &&
+                (icoImageData[7] == 0x0a))
+            {
+                entries[imageCounter] = LoadIconEntryFromMemory(icoImageData, icoDirEntry.size, icoShared);
+            }
+            else entries[imageCounter] = LoadIconEntryFromBMP(icoImageData, icoDirEntry.size);
+
+            if (entries[imageCounter].size > 0) imageCounter++;
+        }
+
+        // NOTE: File data is kept while PNG entries borrow it
+        UnloadSharedMappedFile(icoShared);
+    }
+
+    *count = imageCounter;
+    return entries;
+}
+
+// Save icon (.ico), returns true if file has been saved
+// NOTE: Make sure entries array sizes are valid!
+static bool SaveIconPackToICO(IconEntry *entries, int entryCount, const char *fileName)
+{
+    // Verify icon pack valid entries (not placeholder ones)
+    int packValidCount = 0;
+    for (int i = 0; i < entryCount; i++) if (entries[i].valid) packValidCount++;
+
+    if (packValidCount == 0) return false;
+
+    // Define ico file header and entry
+    IcoHeader icoHeader = { .reserved = 0, .imageType = 1, .imageCount = packValidCount };
+
+    // Entries smaller than 256 saved as BMP data if required (faster loading on Windows), not encoded as PNG
+    // NOTE: Entries are copied to be excluded from encoding, copies share entries data
+    unsigned char **bmpData = (unsigned char **)RL_CALLOC(entryCount, sizeof(unsigned char *));
+    int *bmpDataSize = (int *)RL_CALLOC(entryCount, sizeof(int));
+    IconEntry *pngEntries = (IconEntry *)RL_MALLOC(entryCount*sizeof(IconEntry));
+    memcpy(pngEntries, entries, entryCount*sizeof(IconEntry));
+
+    for (int i = 0; icoBmpEntries && (i < entryCount); i++)
+    {
+        if (entries[i].valid && (entries[i].size < 256))
+        {
+            bmpData[i] = SaveIconEntryBMP(&entries[i], &bmpDataSize[i]);
+            if (bmpData[i] != NULL) pngEntries[i].valid = false;
+        }
+    }
+
+    // Compress valid entries into PNG data streams (with rIPt chunk if required)
+    // NOTE: Encoding is done in parallel, output jobs keep entries order
+    int encodeCount = 0;
+    IconEncodeJob *encodeJobs = EncodeIconPackEntries(pngEntries, entryCount, exportTextChunkChecked, &encodeCount);
+
+    // File header and directory are precomputed into a single buffer, followed by PNG/BMP data streams
+    int headerSize = sizeof(IcoHeader) + icoHeader.imageCount*sizeof(IcoDirEntry);
+    unsigned char *header = (unsigned char *)RL_CALLOC(headerSize, 1);
+    memcpy(header, &icoHeader, sizeof(IcoHeader));
+
+    FileDataSegment *segments = (FileDataSegment *)RL_CALLOC(1 + icoHeader.imageCount, sizeof(FileDataSegment));
+    segments[0] = (FileDataSegment){ header, headerSize };
+
+    int offset = headerSize;
+
+    for (int i = 0, k = 0, n = 0; i < entryCount; i++)
+    {
+        if (!entries[i].valid) continue;
+
+        IcoDirEntry icoDirEntry = { 0 };
+        icoDirEntry.width = (entries[i].size == 256)? 0 : entries[i].size;
+        icoDirEntry.height = (entries[i].size == 256)? 0 : entries[i].size;
+        icoDirEntry.bpp = 32;
+        icoDirEntry.offset = offset;
+
+        if (bmpData[i] != NULL)
+        {
+            icoDirEntry.planes = 1;
+            icoDirEntry.size = bmpDataSize[i];
+            segments[1 + n] = (FileDataSegment){ bmpData[i], bmpDataSize[i] };
+        }
+        else if (k < encodeCount)
+        {
+            icoDirEntry.size = encodeJobs[k].pngDataSize;
+            segments[1 + n] = (FileDataSegment){ encodeJobs[k].pngData, encodeJobs[k].pngDataSize };
+            k++;
+        }
+
+        memcpy(header + sizeof(IcoHeader) + n*sizeof(IcoDirEntry), &icoDirEntry, sizeof(IcoDirEntry));
+
+        offset += icoDirEntry.size;
+        n++;
+    }
+
+    bool saved = SaveFileDataSegments(fileName, segments, 1 + icoHeader.imageCount);
+    if (!saved) LOG("WARNING: [%s] ICO file could not be saved\n", fileName);
+
+    // Free used data (pngs and bmps data)
+    UnloadIconEncodeJobs(encodeJobs, encodeCount);
+
+    for (int i = 0; i < entryCount; i++) RL_FREE(bmpData[i]);
+    RL_FREE(bmpData);
+    RL_FREE(bmpDataSize);
+    RL_FREE(pngEntries);
+
+    RL_FREE(segments);
+    RL_FREE(header);
+
+    return saved;
+}
+
+// Save images as .png
+static void ExportIconPackImages(IconEntry *entries, int entryCount, const char *fileName)
+{
+    // Verify icon pack valid entries (not placeholder ones)
+    int packValidCount = 0;
+    for (int i = 0; i < entryCount; i++) if (entries[i].valid) packValidCount++;
+
+    if (packValidCount == 0) return;
+
+    // Compress valid entries into PNG data streams (with rIPt chunk if required)
+    int encodeCount = 0;
+    IconEncodeJob *encodeJobs = EncodeIconPackEntries(entries, entryCount, exportTextChunkChecked, &encodeCount);
+
+    // NOTE: In case of PNG export as ZIP, files are packed one by one
+    for (int k = 0; k < encodeCount; k++)
+    {
+        int size = encodeJobs[k].entry->size;
+
+#if defined(EXPORT_IMAGE_PACK_AS_ZIP)
+        // Export a single .zip file containing all images
+        // Package every image into an output ZIP file (fileName.zip)
+        mz_bool status = mz_zip_add_mem_to_archive_file_in_place(TextFormat("%s.zip", fileName), TextFormat("%s_%ix%i.png", GetFileNameWithoutExt(fileName), size, size), encodeJobs[k].pngData, encodeJobs[k].pngDataSize, NULL, 0, GetZipCompressionLevel(compressionEffort));
+        if (!status) LOG("WARNING: Zip accumulation process failed\n");
+#else
+        // Save every PNG file individually
+        SaveFileData(TextFormat("%s/%s_%ix%i.png", GetDirectoryPath(fileName), GetFileNameWithoutExt(fileName), size, size), encodeJobs[k].pngData, encodeJobs[k].pngDataSize);
+#endif
+    }
+
+    // Free used data (pngs data)
+    UnloadIconEncodeJobs(encodeJobs, encodeCount);
+}
+
+// ICNS element OSType packed as big-endian uint32 (i.e. 'ic07' -> 0x69633037)
+#define ICNS_OSTYPE(a, b, c, d)     (((unsigned int)(a) << 24) | ((unsigned int)(b) << 16) | ((unsigned int)(c) << 8) | (unsigned int)(d))
+#define ICNS_OSTYPE_DARK            0xfdd92fa8      // Dark mode icon set (nested icns data), no printable OSType
+#define MAX_ICNS_NESTING_DEPTH      2               // Maximum nested icon sets depth (dark mode, selected variants)
+
+// Get big-endian uint32 value from icns data
+static unsigned int GetIcnsUInt32(const unsigned char *data)
+{
+    return (((unsigned int)data[0] << 24) | ((unsigned int)data[1] << 16) | ((unsigned int)data[2] << 8) | (unsigned int)data[3]);
+}
+
+// Get ICNS OSType image size and data format, 0 if OSType is not an image type
+static int GetIcnsTypeImageSize(unsigned int osType, int *format)
+{
+    int size = 0;
+    *format = ICNS_FORMAT_PNG;
+
+    switch (osType)
+    {
+        case ICNS_OSTYPE('i','c','p','4'):      // 16x16, icp4, not properly displayed on .app
+        case ICNS_OSTYPE('i','c','0','4'): size = 16; break;     // 16x16, ic04
+        case ICNS_OSTYPE('i','c','s','b'): size = 18; break;     // 18x18, icsb
+        case ICNS_OSTYPE('s','b','2','4'): size = 24; break;     // 24x24, sb24
+        case ICNS_OSTYPE('i','c','p','5'):      // 32x32, icp5, not properly displayed on .app
+        case ICNS_OSTYPE('i','c','0','5'):      // 32x32, ic05 (16x16@2x "retina")
+        case ICNS_OSTYPE('i','c','1','1'): size = 32; break;     // 32x32, ic11 (16x16@2x "retina")
+        case ICNS_OSTYPE('i','c','s','B'): size = 36; break;     // 36x36, icsB (18x18@2x "retina")
+        case ICNS_OSTYPE('i','c','p','6'):      // 48x48, icp6, not properly displayed on .app
+        case ICNS_OSTYPE('S','B','2','4'): size = 48; break;     // 48x48, SB24 (24x24@2x "retina")
+        case ICNS_OSTYPE('i','c','1','2'): size = 64; break;     // 64x64, ic12 (32x32@2x "retina")
+        case ICNS_OSTYPE('i','c','0','7'): size = 128; break;    // 128x128, ic07
+        case ICNS_OSTYPE('i','c','0','8'):      // 256x256, ic08
+        case ICNS_OSTYPE('i','c','1','3'): size = 256; break;    // 256x256, ic13 (128x128@2x "retina")
+        case ICNS_OSTYPE('i','c','0','9'):      // 512x512, ic09
+        case ICNS_OSTYPE('i','c','1','4'): size = 512; break;    // 512x512, ic14 (256x256@2x "retina")
+        case ICNS_OSTYPE('i','c','1','0'): size = 1024; break;   // 1024x1024, ic10 (512x512@2x "retina")
+
+        // Legacy image types: 24 bit RGB (RLE channels) and 8 bit alpha masks
+        case ICNS_OSTYPE('i','s','3','2'): size = 16; *format = ICNS_FORMAT_RGB; break;
+        case ICNS_OSTYPE('i','l','3','2'): size = 32; *format = ICNS_FORMAT_RGB; break;
+        case ICNS_OSTYPE('i','h','3','2'): size = 48; *format = ICNS_FORMAT_RGB; break;
+        case ICNS_OSTYPE('i','t','3','2'): size = 128; *format = ICNS_FORMAT_RGB; break;
+        case ICNS_OSTYPE('s','8','m','k'): size = 16; *format = ICNS_FORMAT_MASK; break;
+        case ICNS_OSTYPE('l','8','m','k'): size = 32; *format = ICNS_FORMAT_MASK; break;
+        case ICNS_OSTYPE('h','8','m','k'): size = 48; *format = ICNS_FORMAT_MASK; break;
+        case ICNS_OSTYPE('t','8','m','k'): size = 128; *format = ICNS_FORMAT_MASK; break;
+        default: *format = ICNS_FORMAT_NONE; break;
+    }
+
+    return size;
+}
+
+// Get icns legacy image index (16x16, 32x32, 48x48, 128x128), -1 if size not supported
+static int GetIcnsLegacyIndex(int size)
+{
+    switch (size)
+    {
+        case 16: return 0;
+        case 32: return 1;
+        case 48: return 2;
+        case 128: return 3;
+        default: break;
+    }
+
+    return -1;
+}
+
+// Decode icns packbits RLE data into planar channels
+// NOTE: Run header n < 128: n + 1 literal bytes, n >= 128: next byte repeated n - 125 times,
+// channels are decoded consecutively (runs crossing channels supported), returns false if data does not fill output
+static bool DecodeIcnsRLE(const unsigned char *data, unsigned int dataSize, unsigned char *output, int outputSize)
+{
+    unsigned int offset = 0;
+    int outputOffset = 0;
+
+    while ((outputOffset < outputSize) && (offset < dataSize))
+    {
+        int run = data[offset++];
+
+        if (run < 128)
+        {
+            run += 1;
+            if ((run > (outputSize - outputOffset)) || ((unsigned int)run > (dataSize - offset))) return false;
+
+            memcpy(output + outputOffset, data + offset, run);
+            offset += run;
+        }
+        else
+        {
+            run -= 125;
+            if ((run > (outputSize - outputOffset)) || (offset >= dataSize)) return false;
+
+            memset(output + outputOffset, data[offset++], run);
+        }
+
+        outputOffset += run;
+    }
+
+    return (outputOffset == outputSize);
+}
+
+// Decode icns legacy RGB data (is32, il32, ih32, it32) into planar channels (R, G, B), NULL if not valid
+// NOTE: Data is RLE compressed, uncompressed 32 bit xRGB data also supported (data size is pixels*4)
+static unsigned char *DecodeIcnsRGB(unsigned int osType, const unsigned char *data, unsigned int dataSize, int size)
+{
+    int pixelCount = size*size;
+    unsigned char *planes = (unsigned char *)RL_MALLOC(pixelCount*3);
+
+    // NOTE: it32 data starts with 4 zero bytes
+    if ((osType == ICNS_OSTYPE('i','t','3','2')) && (dataSize >= 4) && (GetIcnsUInt32(data) == 0)) { data += 4; dataSize -= 4; }
+
+    if (dataSize == (unsigned int)pixelCount*4)
+    {
+        for (int i = 0; i < pixelCount; i++)
+        {
+            planes[i] = data[i*4 + 1];
+            planes[pixelCount + i] = data[i*4 + 2];
+            planes[pixelCount*2 + i] = data[i*4 + 3];
+        }
+    }
+    else if (!DecodeIcnsRLE(data, dataSize, planes, pixelCount*3))
+    {
+        RL_FREE(planes);
+        planes = NULL;
+    }
+
+    return planes;
+}
+
+// Interleave planar channels into RGBA pixels, alpha set to 255 if alpha channel not provided
+// NOTE: 16 pixels per step with SIMD (SSE2: byte unpacking, NEON: interleaved store)
+static void InterleaveIcnsChannels(const unsigned char *r, const unsigned char *g, const unsigned char *b, const unsigned char *a, unsigned char *rgba, int pixelCount)
+{
+    int i = 0;
+
+#if defined(SUPPORT_SIMD_SSE2)
+    const __m128i opaque = _mm_set1_epi8((char)0xff);
+
+    for (; (i + 16) <= pixelCount; i += 16)
+    {
+        __m128i vr = _mm_loadu_si128((const __m128i *)(r + i));
+        __m128i vg = _mm_loadu_si128((const __m128i *)(g + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *)(b + i));
+        __m128i va = (a != NULL)? _mm_loadu_si128((const __m128i *)(a + i)) : opaque;
+
+        __m128i rgLow = _mm_unpacklo_epi8(vr, vg);
+        __m128i rgHigh = _mm_unpackhi_epi8(vr, vg);
+        __m128i baLow = _mm_unpacklo_epi8(vb, va);
+        __m128i baHigh = _mm_unpackhi_epi8(vb, va);
+
+        _mm_storeu_si128((__m128i *)(rgba + i*4), _mm_unpacklo_epi16(rgLow, baLow));
+        _mm_storeu_si128((__m128i *)(rgba + i*4 + 16), _mm_unpackhi_epi16(rgLow, baLow));
+        _mm_storeu_si128((__m128i *)(rgba + i*4 + 32), _mm_unpacklo_epi16(rgHigh, baHigh));
+        _mm_storeu_si128((__m128i *)(rgba + i*4 + 48), _mm_unpackhi_epi16(rgHigh, baHigh));
+    }
+#elif defined(SUPPORT_SIMD_NEON)
+    for (; (i + 16) <= pixelCount; i += 16)
+    {
+        uint8x16x4_t pixels;
+        pixels.val[0] = vld1q_u8(r + i);
+        pixels.val[1] = vld1q_u8(g + i);
+        pixels.val[2] = vld1q_u8(b + i);
+        pixels.val[3] = (a != NULL)? vld1q_u8(a + i) : vdupq_n_u8(0xff);
+        vst4q_u8(rgba + i*4, pixels);
+    }
+#endif
+
+    for (; i < pixelCount; i++)
+    {
+        rgba[i*4] = r[i];
+        rgba[i*4 + 1] = g[i];
+        rgba[i*4 + 2] = b[i];
+        rgba[i*4 + 3] = (a != NULL)? a[i] : 255;
+    }
+}
+
+// Load icon entry from planar channels (R, G, B, A), image decoded (no compressed data)
+static IconEntry LoadIconEntryFromChannels(const unsigned char *planes, const unsigned char *alpha, int size)
+{
+    IconEntry entry = { 0 };
+    int pixelCount = size*size;
+
+    entry.image.data = RL_MALLOC(pixelCount*4);
+    entry.image.width = size;
+    entry.image.height = size;
+    entry.image.mipmaps = 1;
+    entry.image.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    entry.size = size;
+
+    InterleaveIcnsChannels(planes, planes + pixelCount, planes + pixelCount*2, alpha, (unsigned char *)entry.image.data, pixelCount);
+
+    return entry;
+}
+
+// Add icns entry to loaded entries
+// NOTE: Entries with lower priority value are preferred for same size (any elements order),
+// entries with same priority and size are all kept (last one is used by icon bucket)
+static void AddIcnsEntry(IcnsEntries *icns, IconEntry entry, int priority)
+{
+    for (int i = 0; i < icns->count; i++)
+    {
+        if (icns->entries[i].size == entry.size)
+        {
+            if (icns->priority[i] < priority) { UnloadIconEntry(&entry); return; }
+            else if (icns->priority[i] > priority)
+            {
+                UnloadIconEntry(&icns->entries[i]);
+                icns->entries[i] = entry;
+                icns->priority[i] = priority;
+                return;
+            }
+        }
+    }
+
+    if (icns->count >= icns->capacity)
+    {
+        icns->capacity = (icns->capacity > 0)? icns->capacity*2 : 16;
+        icns->entries = (IconEntry *)RL_REALLOC(icns->entries, icns->capacity*sizeof(IconEntry));
+        icns->priority = (int *)RL_REALLOC(icns->priority, icns->capacity*sizeof(int));
+    }
+
+    icns->entries[icns->count] = entry;
+    icns->priority[icns->count] = priority;
+    icns->count++;
+}
+
+// Load icns element into entries: image data or nested icon set
+// NOTE: Element data does not include OSType and size parameters, legacy RGB and mask elements
+// are kept on icon set legacy images (merged once all icon set elements are loaded)
+static void LoadIcnsElement(IcnsEntries *icns, IcnsLegacySet *legacy, unsigned int osType, const unsigned char *data, unsigned int size, int depth)
+{
+    int format = ICNS_FORMAT_NONE;
+    int imageSize = GetIcnsTypeImageSize(osType, &format);
+    int legacyIndex = GetIcnsLegacyIndex(imageSize);
+
+    // NOTE: Some encoders write legacy RGB data on icp4, icp5 and icp6 elements (no PNG/ARGB signature)
+    if ((format == ICNS_FORMAT_PNG) && (legacyIndex >= 0) && ((size < 8) || (memcmp(data, "\x89PNG\r\n\x1a\n", 8) != 0)) &&
+        ((size < 4) || (memcmp(data, "ARGB", 4) != 0))) format = ICNS_FORMAT_RGB;
+
+    if (format == ICNS_FORMAT_PNG)
+    {
+        // Verify PNG signature for image data
+        // NOTE: JPEG2000 data not supported, signatures:
+        //  - Option 1: 0x00 0x00 0x00 0x0c 0x6a 0x50 0x20 0x20 0x0d 0x0a 0x87 0x0a
+        //  - Option 2: 0xff 0x4f 0xff 0x51
+        if ((size >= 8) && (memcmp(data, "\x89PNG\r\n\x1a\n", 8) == 0))
+        {
+            // Data contains a valid PNG file, PNG data is borrowed to be decoded on demand
+            IconEntry entry = LoadIconEntryFromMemory(data, size, icns->source);
+
+            if (entry.size > 0) AddIcnsEntry(icns, entry, depth*2);
+        }
+        else if ((size >= 4) && (memcmp(data, "ARGB", 4) == 0) && (imageSize <= 32))
+        {
+            // ARGB data: RLE compressed channels (A, R, G, B), decoded on loading
+            int pixelCount = imageSize*imageSize;
+            unsigned char *planes = (unsigned char *)RL_MALLOC(pixelCount*4);
+
+            if (DecodeIcnsRLE(data + 4, size - 4, planes, pixelCount*4)) AddIcnsEntry(icns, LoadIconEntryFromChannels(planes + pixelCount, planes, imageSize), depth*2);
+            else LOG("WARNING: [%s] ICNS ARGB data not valid\n", GetFileName(icns->fileName));
+
+            RL_FREE(planes);
+        }
+        else LOG("WARNING: ICNS data format not supported\n");
+    }
+    else if ((format == ICNS_FORMAT_RGB) && (legacyIndex >= 0))
+    {
+        unsigned char *planes = DecodeIcnsRGB(osType, data, size, imageSize);
+
+        if (planes != NULL)
+        {
+            RL_FREE(legacy->planes[legacyIndex]);
+            legacy->planes[legacyIndex] = planes;
+        }
+        else LOG("WARNING: [%s] ICNS RGB data not valid\n", GetFileName(icns->fileName));
+    }
+    else if ((format == ICNS_FORMAT_MASK) && (legacyIndex >= 0))
+    {
+        if (size == (unsigned int)(imageSize*imageSize)) legacy->masks[legacyIndex] = data;
+        else LOG("WARNING: [%s] ICNS mask data not valid\n", GetFileName(icns->fileName));
+    }
+    else if ((osType == ICNS_OSTYPE_DARK) || (osType == ICNS_OSTYPE('s','l','c','t')))
+    {
+        // Nested icon set: complete icns data (header included)
+        if (depth < MAX_ICNS_NESTING_DEPTH) LoadIcnsElements(icns, data, size, depth + 1);
+        else LOG("WARNING: [%s] ICNS nested icon sets depth not supported\n", GetFileName(icns->fileName));
+    }
+
+    // NOTE: Other OSTypes are skipped: 'TOC ', 'icnV' (version), 'name', 'info' (plist)...
+}
+
+// Load icns elements into entries, table of contents used if available
+// NOTE: Data includes icns header, declared size can not exceed provided data size,
+// legacy images are added once all elements are loaded (PNG/ARGB entries with same size preferred)
+static void LoadIcnsElements(IcnsEntries *icns, const unsigned char *data, unsigned int size, int depth)
+{
+    static const int legacySizes[4] = { 16, 32, 48, 128 };
+
+    if ((size < 8) || (memcmp(data, "icns", 4) != 0))
+    {
+        LOG("WARNING: [%s] ICNS header not valid\n", GetFileName(icns->fileName));
+        return;
+    }
+
+    IcnsLegacySet legacy = { 0 };
+    bool tocLoaded = false;
+
+    unsigned int dataSize = GetIcnsUInt32(data + 4);
+    if (dataSize > size) dataSize = size;
+
+    // Table of contents: elements OSType and size (in file order), elements located directly
+    // NOTE: Table is only used if elements sizes match declared data size, elements scanned otherwise
+    if ((dataSize >= 16) && (GetIcnsUInt32(data + 8) == ICNS_OSTYPE('T','O','C',' ')))
+    {
+        unsigned int tocSize = GetIcnsUInt32(data + 12);
+        unsigned long long elementsSize = 8 + (unsigned long long)tocSize;
+
+        if ((tocSize >= 8) && (((tocSize - 8)%8) == 0) && (tocSize <= (dataSize - 8)))
+        {
+            const unsigned char *toc = data + 16;
+            int tocCount = (tocSize - 8)/8;
+
+            for (int i = 0; i < tocCount; i++) elementsSize += GetIcnsUInt32(toc + i*8 + 4);
+
+            if (elementsSize == dataSize)
+            {
+                unsigned int offset = 8 + tocSize;
+
+                for (int i = 0; i < tocCount; i++)
+                {
+                    unsigned int osType = GetIcnsUInt32(toc + i*8);
+                    unsigned int elementSize = GetIcnsUInt32(toc + i*8 + 4);
+                    int format = ICNS_FORMAT_NONE;
+
+                    // Element header only checked for OSTypes loaded
+                    if ((elementSize >= 8) && ((GetIcnsTypeImageSize(osType, &format) > 0) || (osType == ICNS_OSTYPE_DARK) || (osType == ICNS_OSTYPE('s','l','c','t'))))
+                    {
+                        if ((GetIcnsUInt32(data + offset) == osType) && (GetIcnsUInt32(data + offset + 4) == elementSize))
+                        {
+                            LoadIcnsElement(icns, &legacy, osType, data + offset + 8, elementSize - 8, depth);
+                        }
+                        else LOG("WARNING: [%s] ICNS table of contents element not valid\n", GetFileName(icns->fileName));
+                    }
+
+                    offset += elementSize;
+                }
+
+                tocLoaded = true;
+            }
+        }
+
+        if (!tocLoaded) LOG("WARNING: [%s] ICNS table of contents not valid, elements scanned\n", GetFileName(icns->fileName));
+    }
+
+    unsigned int offset = 8;
+
+    while (!tocLoaded && ((offset + 8) <= dataSize))
+    {
+        unsigned int osType = GetIcnsUInt32(data + offset);
+        unsigned int elementSize = GetIcnsUInt32(data + offset + 4);
+
+        // Validate element is contained in data
+        // NOTE: Element size also considers OSType and size parameters
+        if ((elementSize < 8) || (elementSize > (dataSize - offset)))
+        {
+            LOG("WARNING: [%s] ICNS element data out of file bounds\n", GetFileName(icns->fileName));
+            break;
+        }
+
+        LOG("INFO: [%s] ICNS OSType: %c%c%c%c [%i bytes]\n", GetFileName(icns->fileName), data[offset], data[offset + 1], data[offset + 2], data[offset + 3], elementSize - 8);
+
+        LoadIcnsElement(icns, &legacy, osType, data + offset + 8, elementSize - 8, depth);
+
+        offset += elementSize;
+    }
+
+    // Legacy images: RGB channels merged with 8 bit mask (if available, opaque otherwise)
+    for (int i = 0; i < 4; i++)
+    {
+        if (legacy.planes[i] != NULL)
+        {
+            AddIcnsEntry(icns, LoadIconEntryFromChannels(legacy.planes[i], legacy.masks[i], legacySizes[i]), depth*2 + 1);
+            RL_FREE(legacy.planes[i]);
+        }
+    }
+}
+
+// Icns data loader
+// NOTE: PNG, ARGB and legacy RGB (with 8 bit mask) image data formats supported, JPEG2000 not supported
+// File is memory-mapped, elements located with table of contents if available (scanned otherwise),
+// nested icon sets (dark mode) only provide sizes not available on main icon set, PNG entries borrow
+// PNG data from file data (decoded on demand by LoadIconEntryImage()), ARGB and RGB entries are decoded on loading
+static IconEntry *LoadIconPackFromICNS(const char *fileName, int *count)
+{
+    IcnsEntries icns = { 0 };
+    icns.fileName = fileName;
+    icns.source = LoadSharedMappedFile(fileName);
+
+    if (icns.source != NULL)
+    {
+        LoadIcnsElements(&icns, icns.source->file.data, icns.source->file.size, 0);
+
+        LOG("INFO: Total images extracted from ICNS file: %i\n", icns.count);
+
+        // NOTE: File data is kept while PNG entries borrow it
+        UnloadSharedMappedFile(icns.source);
+    }
+
+    RL_FREE(icns.priority);
+
+    *count = icns.count;
+    return icns.entries;
+}
+
+// Save icns file (Apple)
+// LIMITATIONS:
+//  - Supported OS Version: >=10.7
+//  - Supported PNG compressed images only
+//  - Supported OSTypes [8]: ic11, SB24, ic12, ic07, ic13, ic14, ic10
+//  - Supported image sizes [8]: 32, 48, 64, 128, 256, 512, 1024
+//  - No TOC or additional chunks supported
+//  - Main focus on .app package icns generation
+// REF: https://en.wikipedia.org/wiki/Apple_Icon_Image_format
+static bool SaveIconPackToICNS(IconEntry *entries, int entryCount, const char *fileName)
+{
+    // Verify icon pack valid entries (not placeholder ones)
+    int packValidCount = 0;
+    for (int i = 0; i < entryCount; i++) if (entries[i].valid) packValidCount++;
+    if (packValidCount == 0) return false;
+/*
+    // NOTE: This validation is not required because it is already done when
+    // adding icons from input files into icon package entries
+
+    #define ICNS_MAX_SUPPORTED_IMAGES   8
+
+    // Validate input entries image data to get only supported sizes
+    int validCount = 0;
+    int validIndex[ICNS_MAX_SUPPORTED_IMAGES] = { -1 };
+    for (int i = 0; (i < entryCount) && (validCount < ICNS_MAX_SUPPORTED_IMAGES); i++)
+    {
+        if ((entries[i].image.width == 16) && (entries[i].image.height == 16)) { validIndex[validCount] = i; validCount++; }
+        else if ((entries[i].image.width == 32) && (entries[i].image.height == 32)) { validIndex[validCount] = i; validCount++; }
+        else if ((entries[i].image.width == 48) && (entries[i].image.height == 48)) { validIndex[validCount] = i; validCount++; }
+        else if ((entries[i].image.width == 64) && (entries[i].image.height == 64)) { validIndex[validCount] = i; validCount++; }
+        else if ((entries[i].image.width == 128) && (entries[i].image.height == 128)) { validIndex[validCount] = i; validCount++; }
+        else if ((entries[i].image.width == 256) && (entries[i].image.height == 256)) { validIndex[validCount] = i; validCount++; }
+        else if ((entries[i].image.width == 512) && (entries[i].image.height == 512)) { validIndex[validCount] = i; validCount++; }
+        else if ((entries[i].image.width == 1024) && (entries[i].image.height == 1024)) { validIndex[validCount] = i; validCount++; }
+    }
+*/
+    // Compress provided images into PNG data
+    // NOTE: Encoding is done in parallel, output jobs keep entries order, no text chunks embedded
+    int encodeCount = 0;
+    IconEncodeJob *encodeJobs = EncodeIconPackEntries(entries, entryCount, false, &encodeCount);
+
+    // Got the images converted to PNG in memory, now the icns file can be created
+    /*
+    // Data structures to know how data is organized inside the .icns file
+
+    // Icns File Header (8 bytes)
+    typedef struct {
+    unsigned char id[4];        // Magic literal: "icns" (0x69, 0x63, 0x6e, 0x73)
+    unsigned int size;          // Length of file, in bytes, MSB first (Big Endian)
+    } IcnsHeader;
+
+    for (int i = 0; i < count; i++)
+    {
+    // Icon Entry info (8 bytes + data)
+    typedef struct {
+    unsigned char type[4];      // Icon type, defined by OSType (Big Endian)
+    unsigned int dataSize;      // Length of data, in bytes (including type and length), MSB first
+    unsigned char *data;        // Icon data
+    } IcnsEntry;
+    }
+    */
+
+    // File header and entries type/size fields are precomputed into a single buffer,
+    // written interleaved with PNG data streams
+    unsigned char *header = (unsigned char *)RL_CALLOC(8 + 8*encodeCount, 1);
+    FileDataSegment *segments = (FileDataSegment *)RL_CALLOC(1 + 2*encodeCount, sizeof(FileDataSegment));
+
+    // Write icns header signature
+    // unsigned char icnsId[4] = { 0x69, 0x63, 0x6e, 0x73 };     // "icns"
+    memcpy(header, "icns", 4);
+
+    // ICNS file size, all file including header,
+    // Init it with expected chunck size but every generated PNG size needs to be accumulated
+    unsigned int icnsFileSize = 8 + 8*encodeCount;
+    for (int i = 0; i < encodeCount; i++) icnsFileSize += encodeJobs[i].pngDataSize;
+
+    // Write icns total data size (Big Endian)
+    header[4] = (icnsFileSize >> 24) & 0xff;
+    header[5] = (icnsFileSize >> 16) & 0xff;
+    header[6] = (icnsFileSize >> 8) & 0xff;
+    header[7] = icnsFileSize & 0xff;
+
+    segments[0] = (FileDataSegment){ header, 8 };
+
+    unsigned char icnType[4] = { 0 };
+
+    // Write icns entries
+    for (int k = 0; k < encodeCount; k++)
+    {
+        switch (encodeJobs[k].entry->size)
+        {
+            case 16:   { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = 'p'; icnType[3] = '4'; } break;   // icp4, not properly displayed on .app
+            //case 32: { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = 'p'; icnType[3] = '5'; } break;   // icp5, not properly displayed on .app
+            case 32:   { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '1'; icnType[3] = '1'; } break;   // ic11 (16x16@2x "retina")
+            //case 48: { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = 'p'; icnType[3] = '6'; } break;   // icp6, not properly displayed on .app
+            case 48:   { icnType[0] = 'S'; icnType[1] = 'B'; icnType[2] = '2'; icnType[3] = '4'; } break;   // SB24 (24x24@2x "retina")
+            case 64:   { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '1'; icnType[3] = '2'; } break;   // ic12 (32x32@2x "retina")
+            case 128:  { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '0'; icnType[3] = '7'; } break;   // ic07
+           //case 256: { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '0'; icnType[3] = '8'; } break;   // ic08
+            case 256:  { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '1'; icnType[3] = '3'; } break;   // ic13 (128x128@2x "retina")
+           //case 512: { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '0'; icnType[3] = '9'; } break;   // ic09
+            case 512:  { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '1'; icnType[3] = '4'; } break;   // ic14 (256x256@2x "retina")
+            case 1024: { icnType[0] = 'i'; icnType[1] = 'c'; icnType[2] = '1'; icnType[3] = '0'; } break;   // ic10 (512x512@2x "retina")
+            default: LOG("WARNING: Image size for ICNS generation not supported!\n"); break;
+        }
+
+        unsigned char *icnEntry = header + 8 + 8*k;
+
+        // Write entry type
+        memcpy(icnEntry, icnType, 4);
+
+        // Write entry size (Big endian)
+        unsigned int size = encodeJobs[k].pngDataSize + 8;   // Size must include type and length size
+        icnEntry[4] = (size >> 24) & 0xff;
+        icnEntry[5] = (size >> 16) & 0xff;
+        icnEntry[6] = (size >> 8) & 0xff;
+        icnEntry[7] = size & 0xff;
+
+        // Write entry PNG icon data
+        segments[1 + 2*k] = (FileDataSegment){ icnEntry, 8 };
+        segments[2 + 2*k] = (FileDataSegment){ encodeJobs[k].pngData, encodeJobs[k].pngDataSize };
+    }
+
+    bool saved = SaveFileDataSegments(fileName, segments, 1 + 2*encodeCount);
+    if (!saved) LOG("WARNING: [%s] ICNS file could not be saved\n", fileName);
+
+    // Free used data (pngs data)
+    UnloadIconEncodeJobs(encodeJobs, encodeCount);
+
+    RL_FREE(segments);
+    RL_FREE(header);
+
+    return saved;
+}
+
+// Load file data, memory-mapped if supported (read-only)
+// NOTE: Falls back to LoadFileData() if file can not be mapped
+static MappedFile LoadMappedFile(const char *fileName)
+{
+    MappedFile file = { 0 };
+
+#if defined(SUPPORT_FILE_MAPPING)
+#if defined(_WIN32)
+    void *fileHandle = CreateFileA(fileName, 0x80000000, 0x00000001, NULL, 3, 0x80, NULL); // GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL
+    long long fileSize = 0;
+
+    if ((fileHandle != (void *)(size_t)-1) && GetFileSizeEx(fileHandle, &fileSize) && (fileSize > 0) && (fileSize < 0x7fffffff))
+    {
+        void *mappingHandle = CreateFileMappingA(fileHandle, NULL, 0x02, 0, 0, NULL);   // PAGE_READONLY
+
+        if (mappingHandle != NULL)
+        {
+            file.data = (unsigned char *)MapViewOfFile(mappingHandle, 0x0004, 0, 0, 0);  // FILE_MAP_READ
+            CloseHandle(mappingHandle);     // NOTE: View keeps a reference to the mapping
+        }
+
+        if (file.data != NULL)
+        {
+            file.size = (unsigned int)fileSize;
+            file.mapped = true;
+        }
+    }
+
+    if (fileHandle != (void *)(size_t)-1) CloseHandle(fileHandle);
+#else
+    int fd = open(fileName, O_RDONLY);
+
+    if (fd >= 0)
+    {
+        struct stat fileStat = { 0 };
+
+        if ((fstat(fd, &fileStat) == 0) && (fileStat.st_size > 0) && (fileStat.st_size < 0x7fffffff))
+        {
+            void *data = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (data != MAP_FAILED)
+            {
+                file.data = (unsigned char *)data;
+                file.size = (unsigned int)fileStat.st_size;
+                file.mapped = true;
+            }
+        }
+
+        close(fd);      // NOTE: Mapping keeps a reference to the file
+    }
+#endif
+#endif
+
+    if (file.data == NULL)
+    {
+        int dataSize = 0;
+        file.data = LoadFileData(fileName, &dataSize);
+        file.size = (file.data != NULL)? (unsigned int)dataSize : 0;
+    }
+
+    return file;
+}
+
+// Unload file data (unmap or free)
+static void UnloadMappedFile(MappedFile file)
+{
+#if defined(SUPPORT_FILE_MAPPING)
+    if (file.mapped)
+    {
+    #if defined(_WIN32)
+        UnmapViewOfFile(file.data);
+    #else
+        munmap(file.data, file.size);
+    #endif
+        return;
+    }
+#endif
+
+    UnloadFileData(file.data);
+}
+
+// Load file data shared by loaded entries, NULL if not loaded
+// NOTE: Returned file data has one reference (loader), released with UnloadSharedMappedFile() once loading is done
+static SharedMappedFile *LoadSharedMappedFile(const char *fileName)
+{
+    SharedMappedFile *shared = NULL;
+    MappedFile file = LoadMappedFile(fileName);
+
+    if (file.data != NULL)
+    {
+        shared = (SharedMappedFile *)RL_CALLOC(1, sizeof(SharedMappedFile));
+        shared->file = file;
+        shared->refCount = 1;
+        strncpy(shared->fileName, fileName, sizeof(shared->fileName) - 1);
+    }
+
+    return shared;
+}
+
+// Release file data reference, unloaded with last reference
+static void UnloadSharedMappedFile(SharedMappedFile *file)
+{
+    file->refCount--;
+
+    if (file->refCount <= 0)
+    {
+        UnloadMappedFile(file->file);
+        RL_FREE(file);
+    }
+}
+
+// Check PNG chunks (up to IEND) are contained in data size
+// NOTE: Chunks are not validated (CRC), only length fields are checked
+static bool IsPngDataBounded(const unsigned char *data, unsigned int size)
+{
+    bool bounded = false;
+    unsigned int offset = 8;    // Skip PNG signature
+
+    while ((size >= 12) && (offset <= (size - 12)))
+    {
+        const unsigned char *chunk = data + offset;
+        unsigned int length = ((unsigned int)chunk[0] << 24) | ((unsigned int)chunk[1] << 16) | ((unsigned int)chunk[2] << 8) | chunk[3];
+
+        if (length > (size - offset - 12)) break;
+
+        if (memcmp(chunk + 4, "IEND", 4) == 0) { bounded = true; break; }
+
+        offset += (length + 12);  // Length + FOURCC + chunk data + CRC32
+    }
+
+    return bounded;
+}
+
+// Save data segments to file (temp file renamed on completion)
+// NOTE: Data is written to a temporary file in the same directory, vectored write (one syscall for all segments)
+// if supported, one contiguous buffer otherwise; renamed once completed, readers never get a partially written file
+static bool SaveFileDataSegments(const char *fileName, const FileDataSegment *segments, int segmentCount)
+{
+    bool success = false;
+    char tempFileName[1024] = { 0 };
+
+#if defined(_WIN32)
+    snprintf(tempFileName, sizeof(tempFileName), "%s.%lu.tmp", fileName, GetCurrentProcessId());
+#elif defined(SUPPORT_FILE_VECTORED_WRITE)
+    snprintf(tempFileName, sizeof(tempFileName), "%s.%i.tmp", fileName, (int)getpid());
+#else
+    snprintf(tempFileName, sizeof(tempFileName), "%s.tmp", fileName);
+#endif
+
+#if defined(SUPPORT_FILE_VECTORED_WRITE)
+    int fd = open(tempFileName, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+
+    if (fd >= 0)
+    {
+        struct iovec *iov = (struct iovec *)RL_CALLOC((segmentCount > 0)? segmentCount : 1, sizeof(struct iovec));
+        for (int i = 0; i < segmentCount; i++) iov[i] = (struct iovec){ (void *)segments[i].data, segments[i].size };
+
+        int first = 0;      // First segment not completely written
+
+        while (first < segmentCount)
+        {
+            // Skip empty segments, data is always pending when writing
+            if (iov[first].iov_len == 0) { first++; continue; }
+
+            ssize_t written = writev(fd, iov + first, ((segmentCount - first) < IOV_MAX)? (segmentCount - first) : IOV_MAX);
+
+            if (written < 0)
+            {
+                if (errno == EINTR) continue;
+                break;
+            }
+            else if (written == 0) break;   // No data written with data pending, considered an error
+
+            // Skip completely written segments, partially written segment is adjusted
+            while ((first < segmentCount) && ((size_t)written >= iov[first].iov_len))
+            {
+                written -= iov[first].iov_len;
+                first++;
+            }
+
+            if (written > 0)
+            {
+                iov[first].iov_base = (char *)iov[first].iov_base + written;
+                iov[first].iov_len -= written;
+            }
+        }
+
+        success = (first == segmentCount);
+        if (close(fd) != 0) success = false;
+
+        RL_FREE(iov);
+    }
+#else
+    unsigned int dataSize = 0;
+    for (int i = 0; i < segmentCount; i++) dataSize += segments[i].size;
+
+    unsigned char *data = (unsigned char *)RL_MALLOC((dataSize > 0)? dataSize : 1);
+    for (int i = 0, offset = 0; i < segmentCount; offset += segments[i].size, i++) memcpy(data + offset, segments[i].data, segments[i].size);
+
+    FILE *file = fopen(tempFileName, "wb");
+
+    if (file != NULL)
+    {
+        success = (fwrite(data, 1, dataSize, file) == dataSize);
+        if (fclose(file) != 0) success = false;
+    }
+
+    RL_FREE(data);
+#endif
+
+    if (success)
+    {
+#if defined(_WIN32)
+        success = MoveFileExA(tempFileName, fileName, 0x1);     // MOVEFILE_REPLACE_EXISTING
+#else
+        success = (rename(tempFileName, fileName) == 0);
+#endif
+    }
+
+    if (!success) remove(tempFileName);
+
+    return success;
+}
+
+// Get text lines available on icon pack
+// NOTE: Only valid icons considered
+static unsigned int CountIconPackTextLines(IconPack pack)
+{
+    //static const char *textLines[MAX_PACK_ELEMENTS] = { 0 }; // Pointers array to possible text lines
+    unsigned int counter = 0;
+
+    for (int i = 0; i < pack.count; i++)
+    {
+        if (pack.entries[i].valid && (strlen(pack.entries[i].text) > 0))
+        {
+            //textLines[counter] = pack.entries[i].text;
+            counter++;
+        }
+    }
+
+    return counter;
+}
+
+// Add icon to bucket
+static void AddIconToBucket(IconBucket *bucket, const char *fileName)
+{
+    IconEntry *entries = NULL;
+    int imageCount = 0;
+
+    // Load all available entries
+    if (IsFileExtension(fileName, ".ico")) entries = LoadIconPackFromICO(fileName, &imageCount);
+    if (IsFileExtension(fileName, ".icns")) entries = LoadIconPackFromICNS(fileName, &imageCount);
+    else if (IsFileExtension(fileName, ".png"))
+    {
+        // PNG data is borrowed from file data to be decoded on demand, rIPt text chunk read on entry loading
+        SharedMappedFile *pngShared = LoadSharedMappedFile(fileName);
+        IconEntry entry = { 0 };
+
+        if (pngShared != NULL)
+        {
+            entry = LoadIconEntryFromMemory(pngShared->file.data, pngShared->file.size, pngShared);
+            UnloadSharedMappedFile(pngShared);
+        }
+
+        // Minimal image validation, height read from IHDR chunk
+        if ((entry.size > 0) && (entry.size <= 1024) &&
+            (entry.size == (int)(((unsigned int)entry.data[20] << 24) | ((unsigned int)entry.data[21] << 16) | ((unsigned int)entry.data[22] << 8) | entry.data[23])))
+        {
+            imageCount = 1;
+            entries = (IconEntry *)RL_CALLOC(imageCount, sizeof(IconEntry));
+            entries[0] = entry;
+        }
+        else UnloadIconEntry(&entry);
+    }
+    else if (IsFileExtension(fileName, ".bmp;.qoi"))
+    {
+        Image image = LoadImage(fileName);
+
+        // Minimal image validation
+        if ((image.data != NULL) && (image.width <= 1024) && (image.width == image.height))
+        {
+            imageCount = 1;
+            entries = (IconEntry *)RL_CALLOC(imageCount, sizeof(IconEntry));
+            entries[0].image = image;
             entries[0].size = image.width;
+        }
+        else UnloadImage(image);
+    }
+
+    int dupIndex = -1;
+
+    // Add new entries to bucket
+    for (int i = 0; (i < imageCount) && (bucket->count < bucket->capacity); i++)
+    {
+        // Check if bucket already contains an image with same size
+        for (int k = 0; k < bucket->count; k++)
+        {
+            if (entries[i].size == bucket->entries[k].size)
+            {
+                // Found bucket entry with same size -> replace bucket entry!
+                dupIndex = k;
+                break;
+            }
+        }
+
+        if (dupIndex > -1)
+        {
+            // Unload current entry
+            UnloadIconEntry(&bucket->entries[dupIndex]);
+
+            // Update with new entry
+            bucket->entries[dupIndex] = entries[i];
+            if (entries[i].text[0] != '\0') memcpy(bucket->entries[dupIndex].text, entries[i].text, MAX_IMAGE_TEXT_SIZE);
+            dupIndex = -1;
+        }
+        else
+        {
+            bucket->entries[bucket->count] = entries[i];
+            if (entries[i].text[0] != '\0') memcpy(bucket->entries[bucket->count].text, entries[i].text, MAX_IMAGE_TEXT_SIZE);
+            bucket->count++;
+        }
+    }
+
+    RL_FREE(entries);
+}
+
+// Remove icon from bucket
+static void RemoveIconFromBucket(IconBucket *bucket, unsigned int size)
+{
+    // TODO: Remove bucket icon... really required?
+}
+
+// Clear icon bucket
+static void ClearIconBucket(IconBucket *bucket)
+{
+    for (int i = 0; i < bucket->count; i++) UnloadIconEntry(&bucket->entries[i]);
+
+    bucket->count = 0;
+}
+
+// NOTE: Platform determines the requested sizes, only required bucket entries are decoded
+static void UpdateIconPackFromBucket(IconPack *pack, IconBucket bucket)
+{
+    for (int i = 0; i < bucket.count; i++)
+    {
+        for (int k = 0; k < pack->count; k++)
+        {
+            if ((bucket.entries[i].size == pack->entries[k].size) && LoadIconEntryImage(&bucket.entries[i]))
+            {
+                if (pack->entries[k].generated) UnloadImage(pack->entries[k].image);
+
+                pack->entries[k] = bucket.entries[i];
+
+                UnloadTexture(pack->textures[k]);
+                pack->textures[k] = (Texture2D){ 0 };
+                pack->textures[k] = LoadTextureFromImage(pack->entries[k].image);
+
+                pack->entries[k].valid = true;
+                pack->entries[k].generated = false;
+            }
+        }
+    }
+}
+
+// Load icon entry from PNG data (not decoded, data borrowed from source or copied)
+// NOTE: Icon size is read from IHDR chunk, image is decoded on demand by LoadIconEntryImage(),
+// data chunks must be contained in data size (it could be written as is), returned entry size is 0 if data is not valid,
+// PNG data contained in source file data is borrowed (source reference taken), copied if no source is provided
+static IconEntry LoadIconEntryFromMemory(const unsigned char *fileData, int dataSize, SharedMappedFile *source)
+{
+    static const unsigned char pngSignature[8] = { 0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a };
+
+    IconEntry entry = { 0 };
+
+    // PNG signature (8 bytes) + IHDR chunk (length + type + 13 bytes data + CRC32)
+    if ((fileData != NULL) && (dataSize >= 33) && (memcmp(fileData, pngSignature, 8) == 0) && (memcmp(fileData + 12, "IHDR", 4) == 0) &&
+        IsPngDataBounded(fileData, dataSize))
+    {
+        int width = (int)(((unsigned int)fileData[16] << 24) | ((unsigned int)fileData[17] << 16) | ((unsigned int)fileData[18] << 8) | fileData[19]);
+
+        if (width > 0)
+        {
+            entry.size = width;             // Icon size (expected squared)
+            entry.valid = false;            // Not valid until it is checked against the current package (sizes)
+            entry.generated = false;
+
+            if (source != NULL)
+            {
+                entry.data = (unsigned char *)fileData;
+                entry.source = source;
+                source->refCount++;
+            }
+            else
+            {
+                entry.data = (unsigned char *)RL_MALLOC(dataSize);
+                memcpy(entry.data, fileData, dataSize);
+            }
+
+            entry.dataSize = dataSize;
+
+            // Read custom rIconPacker text chunk from PNG
+            rpng_chunk chunk = rpng_chunk_read_from_memory((const char *)fileData, "rIPt");
+            if (chunk.data != NULL) memcpy(entry.text, chunk.data, (chunk.length < MAX_IMAGE_TEXT_SIZE)? chunk.length : MAX_IMAGE_TEXT_SIZE - 1);
+            RPNG_FREE(chunk.data);
+        }
+    }
+
+    return entry;
+}
+
+// Load icon entry image from compressed data, if not decoded yet
+// NOTE: Returns true if entry image is available
+static bool LoadIconEntryImage(IconEntry *entry)
+{
+    if ((entry->image.data == NULL) && (entry->data != NULL))
+    {
+        // IHDR: height (bytes 20..23), bit depth (byte 24), color type (byte 25), interlace method (byte 28)
+        // NOTE: Common 8-bit RGBA/RGB non-interlaced PNGs are decoded with rpng streaming decoder, scanlines
+        // copied directly into image data (no full image temporaries), other PNGs decoded by raylib
+        // (also in case streaming decoder can not be created)
+        const unsigned char *header = entry->data;
+        int height = (int)(((unsigned int)header[20] << 24) | ((unsigned int)header[21] << 16) | ((unsigned int)header[22] << 8) | header[23]);
+        bool streamDecoding = (header[24] == 8) && ((header[25] == 6) || (header[25] == 2)) && (header[28] == 0) && (height == entry->size);
+
+        if (streamDecoding && (pngDecoder == NULL)) pngDecoder = rpng_decoder_create(CopyIconEntryScanline, NULL);
+
+        if (streamDecoding && (pngDecoder != NULL))
+        {
+            Image image = { 0 };
+            image.width = entry->size;
+            image.height = entry->size;
+            image.mipmaps = 1;
+            image.format = (header[25] == 6)? PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 : PIXELFORMAT_UNCOMPRESSED_R8G8B8;
+            image.data = RL_MALLOC(entry->size*entry->size*((header[25] == 6)? 4 : 3));
+
+            rpng_decoder_reset(pngDecoder, &image);
+
+            if (rpng_decoder_feed(pngDecoder, (const char *)entry->data, entry->dataSize) == RPNG_DECODER_DONE) entry->image = image;
+            else
+            {
+                LOG("WARNING: Icon image data could not be decoded (%i)\n", entry->size);
+                RL_FREE(image.data);
+            }
+        }
+        else
+        {
+            entry->image = LoadImageFromMemory(".png", entry->data, entry->dataSize);
+
+            // Reduced color types (grayscale, palette) loaded as RGBA, expected by export and preview
+            if ((entry->image.data != NULL) && (entry->image.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) &&
+                (entry->image.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8)) ImageFormat(&entry->image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        }
+
+        if ((entry->image.data != NULL) && (entry->image.width != entry->size))
+        {
+            LOG("WARNING: Icon image size (%i) does not match expected size (%i)\n", entry->image.width, entry->size);
+            UnloadImage(entry->image);
+            entry->image = (Image){ 0 };
+        }
+    }
+
+    return (entry->image.data != NULL);
+}
+
+// Copy decoded scanline into icon entry image (decoder callback)
+// NOTE: Scanlines size is expected to match image width and format, checked from IHDR before decoding
+static void CopyIconEntryScanline(const char *scanline, int row, void *userData)
+{
+    Image *image = (Image *)userData;
+    int bytesPerPixel = (image->format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8)? 4 : 3;
+
+    memcpy((unsigned char *)image->data + row*image->width*bytesPerPixel, scanline, image->width*bytesPerPixel);
+}
+
+// Unload icon entry image and compressed data
+// NOTE: Borrowed compressed data is not freed, source file data reference is released
+static void UnloadIconEntry(IconEntry *entry)
+{
+    UnloadImage(entry->image);
+
+    if (entry->source != NULL) UnloadSharedMappedFile(entry->source);
+    else RL_FREE(entry->data);
+
+    *entry = (IconEntry){ 0 };
+}
+
+// Copy entries compressed data borrowed from files overwritten by output file
+// NOTE: Output files are saved to a temp file renamed on completion (mapped files can not be replaced on Windows)
+// and exported images are written in place (mapped data truncated), source files named as output file without
+// extension or starting with it (exported images) are considered overwritten; entries sharing borrowed data
+// (pack entries, not owners) are updated to the copy
+static void CopyIconEntriesSourceData(IconEntry *entries, int entryCount, IconEntry *sharing, int sharingCount, const char *fileName)
+{
+    // Output file name without extension
+    int nameLength = (int)strlen(fileName);
+    for (int i = nameLength - 1; (i >= 0) && (fileName[i] != '/') && (fileName[i] != '\\'); i--)
+    {
+        if (fileName[i] == '.') { nameLength = i; break; }
+    }
+
+    for (int i = 0; i < entryCount; i++)
+    {
+        if ((entries[i].source == NULL) || (strncmp(entries[i].source->fileName, fileName, nameLength) != 0)) continue;
+
+        unsigned char *data = (unsigned char *)RL_MALLOC(entries[i].dataSize);
+        memcpy(data, entries[i].data, entries[i].dataSize);
+
+        for (int k = 0; k < sharingCount; k++) if (sharing[k].data == entries[i].data) { sharing[k].data = data; sharing[k].source = NULL; }
+
+        UnloadSharedMappedFile(entries[i].source);
+        entries[i].data = data;
+        entries[i].source = NULL;
+    }
+}
+
+// Reset icon pack data
+static void ResetIconPack(IconPack *pack, int platform)
+{
+    // Clear full pack
+    for (int i = 0; i < MAX_PACK_ELEMENTS; i++)
+    {
+        if (pack->entries[i].generated) UnloadImage(pack->entries[i].image);
+        else pack->entries[i].image = (Image){ 0 };      // Remove bucket image (not unload)
+
+        pack->entries[i].data = NULL;                   // Remove bucket compressed data (not unload)
+        pack->entries[i].source = NULL;
+        pack->entries[i].dataSize = 0;
+
+        UnloadTexture(pack->textures[i]);
+        pack->textures[i] = (Texture2D){ 0 };
+
+        memset(pack->entries[i].text, 0, MAX_IMAGE_TEXT_SIZE);
+        pack->entries[i].generated = false;
+        pack->entries[i].valid = false;
+        pack->entries[i].size = 0;
+    }
+
+    // Reset to required platform
+    unsigned int *platformSizes = NULL;
+    switch (platform)
+    {
+        case ICON_PLATFORM_WINDOWS: pack->count = 8; platformSizes = icoSizesWindows; break;
+        case ICON_PLATFORM_MACOS: pack->count = 8; platformSizes = icoSizesMacOS; break;
+        case ICON_PLATFORM_FAVICON: pack->count = 10; platformSizes = icoSizesFavicon; break;
+        case ICON_PLATFORM_ANDROID: pack->count = 10; platformSizes = icoSizesAndroid; break;
+        case ICON_PLATFORM_IOS7: pack->count = 9; platformSizes = icoSizesiOS; break;
+        default: break;
+    }
+
+    for (int i = 0; i < pack->count; i++) pack->entries[i].size = platformSizes[i];
+}
+
+// Encode valid icon entries into PNG data
+// NOTE: One job per valid entry, dispatched to worker pool from bigger to smaller image, entries found on
+// encode cache are not encoded again, returned jobs array keeps entries order, jobs must be freed with UnloadIconEncodeJobs()
+// Big entries (ENCODE_STRIPES_MIN_SIZE) are encoded first by caller thread, one by one, so worker pool is available
+// to compress their image data in stripes (and squeeze candidates) in parallel, smaller entries are dispatched afterwards
+static IconEncodeJob *EncodeIconPackEntries(IconEntry *entries, int entryCount, bool embedText, int *jobCount)
+{
+    int validCount = 0;
+    for (int i = 0; i < entryCount; i++) if (entries[i].valid) validCount++;
+
+    IconEncodeJob *jobs = (IconEncodeJob *)RL_CALLOC((validCount > 0)? validCount : 1, sizeof(IconEncodeJob));
+    IconEncodeJob **jobsSorted = (IconEncodeJob **)RL_CALLOC((validCount > 0)? validCount : 1, sizeof(IconEncodeJob *));
+    int sortedCount = 0;
+
+    for (int i = 0, k = 0; i < entryCount; i++)
+    {
+        if (entries[i].valid)
+        {
+            jobs[k].entry = &entries[i];
+            jobs[k].embedText = embedText;
+            jobs[k].cacheKey = GetIconEncodeKey(&entries[i], embedText);
+
+            // Entry encoded data already available on cache, no encoding required
+            if (!entries[i].reused && GetEncodeCacheData(jobs[k].cacheKey, &jobs[k]))
+            {
+                k++;
+                continue;
+            }
+
+            // Insert job sorted by image pixels count (descending), bigger images take longer to compress
+            int pixels = entries[i].size*entries[i].size;
+            int n = sortedCount;
+            while ((n > 0) && ((jobsSorted[n - 1]->entry->size*jobsSorted[n - 1]->entry->size) < pixels))
+            {
+                jobsSorted[n] = jobsSorted[n - 1];
+                n--;
+            }
+            jobsSorted[n] = &jobs[k];
+
+            sortedCount++;
+            k++;
+        }
+    }
+
+    LOG("INFO: Icon entries to encode: %i (%i from encode cache)\n", sortedCount, validCount - sortedCount);
+
+    // NOTE: Jobs are sorted by size (descending), big entries are the first ones
+    int bigCount = 0;
+    if (compressionThreads > 1)
+    {
+        while ((bigCount < sortedCount) && (jobsSorted[bigCount]->entry->size >= ENCODE_STRIPES_MIN_SIZE)) bigCount++;
+    }
+
+    for (int n = 0; n < bigCount; n++) EncodeIconEntryJob(&jobsSorted[n]);
+
+    RunWorkerJobs(EncodeIconEntryJob, jobsSorted + bigCount, sizeof(IconEncodeJob *), sortedCount - bigCount);
+
+    // Add encoded data to cache, passthrough jobs (original data referenced) not required
+    for (int n = 0; n < sortedCount; n++)
+    {
+        if (!jobsSorted[n]->passthrough && (jobsSorted[n]->pngData != NULL)) AddEncodeCacheData(jobsSorted[n]->cacheKey, *jobsSorted[n]);
+    }
+
+    RL_FREE(jobsSorted);
+
+    // Report squeeze compression savings per entry
+    if (compressionEffort == RPNG_COMPRESSION_SQUEEZE)
+    {
+        int totalSize = 0;
+        int totalReferenceSize = 0;
+
+        for (int k = 0; k < validCount; k++)
+        {
+            int referenceSize = (jobs[k].referenceSize > 0)? jobs[k].referenceSize : jobs[k].pngDataSize;
+
+            printf(" > Size %i: SQUEEZED %i -> %i bytes (%.1f%% saved)%s\n", jobs[k].entry->size, referenceSize, jobs[k].pngDataSize,
+                (referenceSize > 0)? 100.0f*(referenceSize - jobs[k].pngDataSize)/referenceSize : 0.0f, jobs[k].passthrough? " [original data kept]" : "");
+
+            totalSize += jobs[k].pngDataSize;
+            totalReferenceSize += referenceSize;
+        }
+
+        if (validCount > 0) printf(" > Squeeze total: %i -> %i bytes (%.1f%% saved)\n\n", totalReferenceSize, totalSize, 100.0f*(totalReferenceSize - totalSize)/totalReferenceSize);
+    }
+
+    // Report lossy quantization error and size per quantized entry
+    if (quantizeThresholdsCount > 0)
+    {
+        for (int k = 0; k < validCount; k++)
+        {
+            if (jobs[k].losslessSize == 0) continue;
+
+            if (jobs[k].quantizeColors > 0)
+            {
+                printf(" > Size %i: QUANTIZED %i colors, PSNR %.2f dB, dE %.2f, %i -> %i bytes%s\n", jobs[k].entry->size, jobs[k].quantizeColors,
+                    jobs[k].quantizePSNR, jobs[k].quantizeDeltaE, jobs[k].losslessSize, jobs[k].pngDataSize, jobs[k].quantized? "" : " [lossless data kept, smaller]");
+            }
+            else printf(" > Size %i: NOT QUANTIZED, PSNR %.2f dB below %.2f dB [lossless data kept]\n", jobs[k].entry->size,
+                jobs[k].quantizePSNR, GetQuantizeMinPSNR(jobs[k].entry->size));
+        }
+
+        printf("\n");
+    }
+
+    *jobCount = validCount;
+    return jobs;
+}
+
+// Worker job: Encode one icon entry into PNG data
+// NOTE: Job data is a pointer to IconEncodeJob, only job output fields are written
+// Entries keeping original PNG data (not generated) are not re-compressed, data is referenced
+// as is if embedded text has not changed, only rIPt chunk is replaced otherwise
+// Text chunk is written by the encoder after IHDR, no chunk insertion copy required
+static void EncodeIconEntryJob(void *jobData)
+{
+    IconEncodeJob *job = *(IconEncodeJob **)jobData;
+    IconEntry *entry = job->entry;
+
+    const char *text = job->embedText? entry->text : "";
+    float minPSNR = GetQuantizeMinPSNR(entry->size);
+
+    // Text chunk to embed (rIPt), not written if text is empty
+    rpng_chunk textChunk = { 0 };
+    memcpy(textChunk.type, "rIPt", 4);
+    textChunk.data = (char *)text;
+    textChunk.length = (int)strlen(text);
+    int chunkCount = (textChunk.length > 0)? 1 : 0;
+
+    // NOTE: Memory is allocated internally using RPNG_MALLOC(), must be freed with RPNG_FREE()
+    int tempPngDataSize = 0;
+    char *tempPngData = NULL;
+
+    // Entry data reused from previous output (incremental build), already encoded with same settings
+    if (entry->reused && (entry->data != NULL))
+    {
+        job->pngData = (char *)entry->data;
+        job->pngDataSize = entry->dataSize;
+        job->passthrough = true;
+        return;
+    }
+
+    if (entry->data != NULL)
+    {
+        // Check original data text chunk against text to embed
+        rpng_chunk chunk = rpng_chunk_read_from_memory((const char *)entry->data, "rIPt");
+        bool textChanged = (chunk.length != (int)strlen(text)) || ((chunk.length > 0) && (memcmp(chunk.data, text, chunk.length) != 0));
+        RPNG_FREE(chunk.data);
+
+        // Squeeze compression: original image data recompressed, kept only if smaller
+        // NOTE: Reference size is original data size with text chunk to embed
+        if (compressionEffort == RPNG_COMPRESSION_SQUEEZE)
+        {
+            tempPngData = SqueezeIconEntryData(entry, &textChunk, chunkCount, &tempPngDataSize);
+            job->referenceSize = entry->dataSize - ((chunk.length > 0)? (12 + chunk.length) : 0) + ((chunkCount > 0)? (12 + textChunk.length) : 0);
+        }
+
+        if (tempPngData == NULL)
+        {
+            // NOTE: Original data is not referenced if quantization is requested, lossless size required
+            if (!textChanged && (minPSNR <= 0.0f))
+            {
+                job->pngData = (char *)entry->data;
+                job->pngDataSize = entry->dataSize;
+                job->passthrough = true;
+                if (job->referenceSize > 0) job->referenceSize = entry->dataSize;
+                return;
+            }
+
+            // Text changed, image data (IDAT) is copied as is, rIPt chunk replaced (removed if empty) in one pass
+            tempPngData = rpng_chunk_replace_from_memory((const char *)entry->data, textChunk, &tempPngDataSize);
+        }
+    }
+    else
+    {
+        int colorChannels = 0;
+
+        // Image data format could be RGB (3 bytes) instead of RGBA (4 bytes)
+        if (entry->image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8) colorChannels = 3;
+        else if (entry->image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) colorChannels = 4;
+
+        // Color type reduced losslessly if possible (grayscale, palette, color key)
+        rpng_compression_stats stats = { 0 };
+        tempPngData = rpng_save_image_reduced_chunks_to_memory(entry->image.data, entry->image.width, entry->image.height, colorChannels, &textChunk, chunkCount, &tempPngDataSize, &stats);
+
+        // Squeeze compression reports savings against default compression
+        if (stats.default_size > 0) job->referenceSize = tempPngDataSize + (stats.default_size - stats.size);
+    }
+
+    // Lossy palette quantization, quantized data kept only if smaller than lossless data
+    if ((minPSNR > 0.0f) && (tempPngData != NULL))
+    {
+        job->losslessSize = tempPngDataSize;
+
+        int quantizedDataSize = 0;
+        char *quantizedData = QuantizeIconEntryData(entry, minPSNR, &textChunk, chunkCount, &quantizedDataSize, job);
+
+        if ((quantizedData != NULL) && (quantizedDataSize < tempPngDataSize))
+        {
+            RPNG_FREE(tempPngData);
+            tempPngData = quantizedData;
+            tempPngDataSize = quantizedDataSize;
+            job->quantized = true;
+        }
+        else RPNG_FREE(quantizedData);
+    }
+
+    job->pngData = tempPngData;
+    job->pngDataSize = tempPngDataSize;
+}
+
+// Check if entry PNG data is direct color: 8/16 bit gray/RGB (with or without alpha), no tRNS chunk
+// NOTE: Only direct color data decoded by rpng_load_image_from_memory() keeps all pixels information,
+// palette data is decoded as indices and tRNS color key transparency is not applied
+static bool IsIconEntryDataDirectColor(const IconEntry *entry)
+{
+    if ((entry->data == NULL) || (entry->dataSize < 33)) return false;
+
+    // IHDR: bit depth (byte 24), color type (byte 25)
+    int bitDepth = entry->data[24];
+    int colorType = entry->data[25];
+
+    if (((bitDepth != 8) && (bitDepth != 16)) || ((colorType != 0) && (colorType != 2) && (colorType != 4) && (colorType != 6))) return false;
+
+    rpng_chunk chunk = rpng_chunk_read_from_memory((const char *)entry->data, "tRNS");
+    bool colorKey = (chunk.data != NULL);
+    RPNG_FREE(chunk.data);
+
+    return !colorKey;
+}
+
+// Recompress entry original PNG data (squeeze), NULL if not smaller
+// NOTE: Original data is decoded with rpng (thread-safe), 8 bit RGB/RGBA color type reduced if possible,
+// provided chunks written after IHDR (original text chunk not included), memory must be freed with RPNG_FREE()
+// Only direct color data without tRNS chunk is squeezed (palette data and color key kept as original)
+static char *SqueezeIconEntryData(IconEntry *entry, const rpng_chunk *chunks, int chunkCount, int *dataSize)
+{
+    char *pngData = NULL;
+    int width = 0, height = 0, colorChannels = 0, bitDepth = 0;
+    *dataSize = 0;
+
+    if (!IsIconEntryDataDirectColor(entry)) return NULL;
+
+    char *imageData = rpng_load_image_from_memory((const char *)entry->data, &width, &height, &colorChannels, &bitDepth);
+
+    if (imageData != NULL)
+    {
+        int size = 0;
+        if ((bitDepth == 8) && (colorChannels >= 3)) pngData = rpng_save_image_reduced_chunks_to_memory(imageData, width, height, colorChannels, chunks, chunkCount, &size, NULL);
+        else pngData = rpng_save_image_chunks_to_memory(imageData, width, height, colorChannels, bitDepth, chunks, chunkCount, &size, NULL);
+        RPNG_FREE(imageData);
+
+        // Original data size compared with original text chunk replaced by provided chunks
+        rpng_chunk chunk = rpng_chunk_read_from_memory((const char *)entry->data, "rIPt");
+        int originalSize = entry->dataSize - ((chunk.length > 0)? (12 + chunk.length) : 0);
+        for (int i = 0; i < chunkCount; i++) originalSize += (12 + chunks[i].length);
+        RPNG_FREE(chunk.data);
+
+        if ((pngData != NULL) && (size < originalSize)) *dataSize = size;
+        else
+        {
+            RPNG_FREE(pngData);
+            pngData = NULL;
+        }
+    }
+
+    return pngData;
+}
+
+// Get lossy quantization threshold for icon size, 0.0f if not quantized
+// NOTE: Specific size threshold takes precedence over any size threshold (size 0, up to QUANTIZE_MAX_SIZE)
+static float GetQuantizeMinPSNR(int size)
+{
+    float minPSNR = 0.0f;
+
+    for (int i = 0; i < quantizeThresholdsCount; i++)
+    {
+        if (quantizeThresholds[i].size == size) return quantizeThresholds[i].minPSNR;
+        else if ((quantizeThresholds[i].size == 0) && (size <= QUANTIZE_MAX_SIZE)) minPSNR = quantizeThresholds[i].minPSNR;
+    }
+
+    return minPSNR;
+}
+
+// Quantize entry image to smallest indexed PNG with PSNR over threshold, NULL if no palette over threshold
+// NOTE: Palettes from 256 colors down to 2 colors are tried while PSNR is over threshold, smallest PNG kept,
+// entry image is used if loaded, original data decoded with rpng otherwise (thread-safe, direct color data only),
+// quantization results are written to job, provided chunks written after IHDR, returned data must be freed with RPNG_FREE()
+static char *QuantizeIconEntryData(IconEntry *entry, float minPSNR, const rpng_chunk *chunks, int chunkCount, int *dataSize, IconEncodeJob *job)
+{
+    char *pngData = NULL;
+    *dataSize = 0;
+
+    const unsigned char *pixels = NULL;
+    char *decodedData = NULL;
+    int width = 0, height = 0, colorChannels = 0, bitDepth = 8;
+
+    if ((entry->image.data != NULL) && ((entry->image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) || (entry->image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8)))
+    {
+        pixels = (const unsigned char *)entry->image.data;
+        width = entry->image.width;
+        height = entry->image.height;
+        colorChannels = (entry->image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8)? 4 : 3;
+    }
+    else if (IsIconEntryDataDirectColor(entry))
+    {
+        // NOTE: Palette data and tRNS color key are not expanded by rpng decoding, not quantized
+        decodedData = rpng_load_image_from_memory((const char *)entry->data, &width, &height, &colorChannels, &bitDepth);
+        pixels = (const unsigned char *)decodedData;
+    }
+
+    if ((pixels == NULL) || (bitDepth != 8))
+    {
+        RPNG_FREE(decodedData);
+        return NULL;
+    }
+
+    // Source image converted to R8G8B8A8, required by quantization and error measurement
+    Image source = { 0 };
+    source.width = width;
+    source.height = height;
+    source.mipmaps = 1;
+    source.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    source.data = RL_MALLOC(width*height*4);
+
+    unsigned char *sourcePixels = (unsigned char *)source.data;
+    bool gray = (colorChannels <= 2);
+    bool alpha = ((colorChannels == 2) || (colorChannels == 4));
+
+    for (int i = 0; i < width*height; i++)
+    {
+        const unsigned char *pixel = pixels + i*colorChannels;
+
+        sourcePixels[i*4] = pixel[0];
+        sourcePixels[i*4 + 1] = gray? pixel[0] : pixel[1];
+        sourcePixels[i*4 + 2] = gray? pixel[0] : pixel[2];
+        sourcePixels[i*4 + 3] = alpha? pixel[colorChannels - 1] : 255;
+    }
+
+    RPNG_FREE(decodedData);
+
+    Color palette[256] = { 0 };
+    rpng_color pngPalette[256] = { 0 };
+
+    for (int maxColors = 256; maxColors >= 2; maxColors /= 2)
+    {
+        int colorCount = 0;
+        unsigned char *indexedData = QuantizeImage(source, maxColors, quantizeDithering, palette, &colorCount);
+        if (indexedData == NULL) break;
+
+        for (int i = 0; i < colorCount; i++) pngPalette[i] = (rpng_color){ palette[i].r, palette[i].g, palette[i].b, palette[i].a };
+        rpng_palette pngPaletteInfo = { colorCount, pngPalette };
+
+        // Error measured on quantized image as saved (palette colors)
+        Image quantized = source;
+        quantized.data = rpng_unindex_image_data((char *)indexedData, width, height, pngPaletteInfo);
+        float psnr = GetImagePSNR(source, quantized);
+
+        if (psnr >= minPSNR)
+        {
+            int size = 0;
+            char *candidate = rpng_save_image_indexed_chunks_to_memory((char *)indexedData, width, height, pngPaletteInfo, chunks, chunkCount, &size);
+
+            if ((candidate != NULL) && ((pngData == NULL) || (size < *dataSize)))
+            {
+                RPNG_FREE(pngData);
+                pngData = candidate;
+                *dataSize = size;
+
+                job->quantizeColors = colorCount;
+                job->quantizePSNR = psnr;
+                job->quantizeDeltaE = GetImageDeltaE(source, quantized);
+            }
+            else RPNG_FREE(candidate);
+        }
+        else if (pngData == NULL) job->quantizePSNR = psnr;
+
+        RPNG_FREE(quantized.data);
+        RL_FREE(indexedData);
+
+        // Smaller palettes only reduce quality further
+        if (psnr < minPSNR) break;
+
+        // Palettes not smaller than colors used skipped (same result)
+        while ((maxColors > 2) && ((maxColors/2) >= colorCount)) maxColors /= 2;
+    }
+
+    RL_FREE(source.data);
+
+    return pngData;
+}
+
+// Unload icon encoding jobs PNG data
+// NOTE: Passthrough jobs data is owned by the entries, not freed
+static void UnloadIconEncodeJobs(IconEncodeJob *jobs, int jobCount)
+{
+    for (int i = 0; i < jobCount; i++) if (!jobs[i].passthrough) RPNG_FREE(jobs[i].pngData);
+
+    RL_FREE(jobs);
+}
+
+// Get icon entry encoding content hash (encode cache key)
+// NOTE: Hash includes entry original PNG data if available (encoded from it), image data and format otherwise,
+// along entry size, encoding settings (compression effort, quantization) and embedded text
+static unsigned long long GetIconEncodeKey(IconEntry *entry, bool embedText)
+{
+    unsigned long long key = 0;
+    int imageInfo[3] = { 0 };   // Image width, height and format, not included for PNG data (decoded or not)
+
+    if (entry->data != NULL) key = GetDataHash(entry->data, entry->dataSize, 1);
+    else
+    {
+        int pixelSize = (entry->image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8)? 3 : 4;
+        key = GetDataHash(entry->image.data, entry->image.width*entry->image.height*pixelSize, 0);
+
+        imageInfo[0] = entry->image.width;
+        imageInfo[1] = entry->image.height;
+        imageInfo[2] = entry->image.format;
+    }
+
+    int settings[8] = { entry->size, imageInfo[0], imageInfo[1], imageInfo[2],
+        compressionEffort, (int)(GetQuantizeMinPSNR(entry->size)*1000.0f), (int)(quantizeDithering*1000.0f), embedText };
+    key = GetDataHash(settings, sizeof(settings), key);
+
+    if (embedText) key = GetDataHash(entry->text, (unsigned int)strlen(entry->text), key);
+
+    return key;
+}
+
+// Get encoded data from cache into job (data copied), false if not found
+// NOTE: Job results are copied from cached job, job entry and input fields are kept
+static bool GetEncodeCacheData(unsigned long long key, IconEncodeJob *job)
+{
+    for (int i = 0; i < encodeCache.count; i++)
+    {
+        EncodeCacheEntry *cached = &encodeCache.entries[i];
+
+        if (cached->key == key)
+        {
+            char *pngData = (char *)RPNG_MALLOC(cached->job.pngDataSize);
+            if (pngData == NULL) return false;
+            memcpy(pngData, cached->job.pngData, cached->job.pngDataSize);
+
+            IconEntry *entry = job->entry;
+            bool embedText = job->embedText;
+
+            *job = cached->job;
+            job->entry = entry;
+            job->embedText = embedText;
+            job->pngData = pngData;
+
+            encodeCache.useTick++;
+            cached->lastUse = encodeCache.useTick;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Add encoded job data to cache (data copied), least recently used entries evicted
+// NOTE: Cache limits: MAX_ENCODE_CACHE_ENTRIES entries and MAX_ENCODE_CACHE_MEMORY bytes,
+// data bigger than memory limit is not cached
+static void AddEncodeCacheData(unsigned long long key, IconEncodeJob job)
+{
+    if ((unsigned int)job.pngDataSize > MAX_ENCODE_CACHE_MEMORY) return;
+
+    // Evict least recently used entries until new data fits
+    while ((encodeCache.count > 0) && ((encodeCache.count >= MAX_ENCODE_CACHE_ENTRIES) ||
+           ((encodeCache.memorySize + job.pngDataSize) > MAX_ENCODE_CACHE_MEMORY)))
+    {
+        int lruIndex = 0;
+        for (int i = 1; i < encodeCache.count; i++) if (encodeCache.entries[i].lastUse < encodeCache.entries[lruIndex].lastUse) lruIndex = i;
+
+        encodeCache.memorySize -= encodeCache.entries[lruIndex].job.pngDataSize;
+        RPNG_FREE(encodeCache.entries[lruIndex].job.pngData);
+
+        encodeCache.entries[lruIndex] = encodeCache.entries[encodeCache.count - 1];
+        encodeCache.count--;
+    }
+
+    char *pngData = (char *)RPNG_MALLOC(job.pngDataSize);
+    if (pngData == NULL) return;
+    memcpy(pngData, job.pngData, job.pngDataSize);
+
+    EncodeCacheEntry *cached = &encodeCache.entries[encodeCache.count];
+    cached->key = key;
+    cached->job = job;
+    cached->job.entry = NULL;
+    cached->job.pngData = pngData;
+
+    encodeCache.useTick++;
+    cached->lastUse = encodeCache.useTick;
+    encodeCache.memorySize += job.pngDataSize;
+    encodeCache.count++;
+}
+
+// Unload encode cache data
+static void UnloadEncodeCache(void)
+{
+    for (int i = 0; i < encodeCache.count; i++) RPNG_FREE(encodeCache.entries[i].job.pngData);
+
+    encodeCache = (EncodeCache){ 0 };
+}
+
+//--------------------------------------------------------------------------------------------
+// Icon images generation functions
+//--------------------------------------------------------------------------------------------
+
+// Generate missing entries images from source image
+// NOTE: Missing entries are generated from bigger to smaller size, smooth scaling is cascaded from
+// a shared box-filtered half-resolution pyramid, every size resampled from the nearest bigger level,
+// balanced quality verifies smallest size first (error accumulated along levels) and first bigger size
+// Scale algorythm: 1-Nearest-neighbor, 2-Bicubic, 3-Lanczos
+static void GenerateIconImages(Image source, IconEntry *entries, int entryCount, int scaleAlgorythm, int quality)
+{
+    int filter = RESAMPLE_FILTER_BICUBIC;
+    if (scaleAlgorythm == 1) filter = RESAMPLE_FILTER_NEAREST;
+    else if (scaleAlgorythm == 3) filter = RESAMPLE_FILTER_LANCZOS3;
+
+    // Pyramid levels, level 0 is the source image (not owned)
+    Image levels[MAX_GENERATION_LEVELS] = { 0 };
+    int levelsCount = 1;
+    levels[0] = source;
+
+    // NOTE: Box filter and PSNR computation require R8G8B8A8 source image
+    bool cascade = (filter != RESAMPLE_FILTER_NEAREST) && (quality != GENERATION_QUALITY_BEST) && (source.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    int verifyCount = (cascade && (quality == GENERATION_QUALITY_BALANCED))? 2 : 0;   // Cascaded sizes to verify: smallest and first bigger
+
+    while (true)
+    {
+        // Get bigger missing entry, smallest one first if cascaded generation has to be verified
+        bool smallestFirst = (verifyCount == 2);
+        int index = -1;
+        for (int i = 0; i < entryCount; i++)
+        {
+            if (!entries[i].valid && ((index == -1) ||
+                (smallestFirst? (entries[i].size < entries[index].size) : (entries[i].size > entries[index].size)))) index = i;
+        }
+
+        if (index == -1) break;
+
+        int size = entries[index].size;
+        Image image = { 0 };
+
+        if (cascade)
+        {
+            // Add pyramid levels while next half-resolution level is still bigger or equal than required size
+            while ((levelsCount < MAX_GENERATION_LEVELS) &&
+                   ((levels[levelsCount - 1].width/2) >= size) && ((levels[levelsCount - 1].height/2) >= size))
+            {
+                levels[levelsCount] = GenImageHalfBox(levels[levelsCount - 1]);
+                levelsCount++;
+            }
+
+            // Get nearest bigger (or equal) pyramid level, smaller levels could be available (smallest size first)
+            int level = levelsCount - 1;
+            while ((level > 0) && ((levels[level].width < size) || (levels[level].height < size))) level--;
+
+            if ((levels[level].width == size) && (levels[level].height == size)) image = ImageCopy(levels[level]);
+            else image = ResampleImage(levels[level], size, size, filter);
+
+            // Verify cascaded generation on smallest size and first bigger size generated from a pyramid level,
+            // fallback to direct resampling (remaining sizes included) if quality is not enough
+            if ((verifyCount > 0) && (level > 0))
+            {
+                Image direct = ResampleImage(source, size, size, filter);
+
+                float psnr = GetImagePSNR(image, direct);
+                LOG("INFO: Cascaded generation PSNR (size %i): %.2f dB\n", size, psnr);
+
+                if (psnr < GENERATION_MIN_PSNR)
+                {
+                    UnloadImage(image);
+                    image = direct;
+                    cascade = false;
+                }
+                else UnloadImage(direct);
+
+                verifyCount--;
+            }
+            else if (smallestFirst) verifyCount = 0;    // Smallest size not generated from a pyramid level, bigger sizes neither
+        }
+        else image = ResampleImage(source, size, size, filter);
+
+        entries[index].image = image;
+        entries[index].generated = true;
+        entries[index].valid = true;
+        entries[index].data = NULL;         // Generated image has no original PNG data
+        entries[index].source = NULL;
+        entries[index].dataSize = 0;
+    }
+
+    for (int i = 1; i < levelsCount; i++) UnloadImage(levels[i]);
+}
+
+// Generate half-resolution image with 2x2 box filter
+// NOTE: Color is weighted by alpha (premultiplied) to avoid dark borders on transparent areas
+static Image GenImageHalfBox(Image image)
+{
+    Image result = { 0 };
+    result.width = image.width/2;
+    result.height = image.height/2;
+    result.mipmaps = 1;
+    result.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    result.data = RL_CALLOC(result.width*result.height*4, 1);
+
+    const unsigned char *src = (const unsigned char *)image.data;
+    unsigned char *dst = (unsigned char *)result.data;
+    int srcStride = image.width*4;
+
+    for (int y = 0; y < result.height; y++)
+    {
+        const unsigned char *row0 = src + (y*2)*srcStride;
+        const unsigned char *row1 = row0 + srcStride;
+
+        for (int x = 0; x < result.width; x++)
+        {
+            const unsigned char *p[4] = { row0 + x*8, row0 + x*8 + 4, row1 + x*8, row1 + x*8 + 4 };
+            unsigned int alpha = p[0][3] + p[1][3] + p[2][3] + p[3][3];
+            unsigned char *out = dst + (y*result.width + x)*4;
+
+            if (alpha > 0)
+            {
+                for (int c = 0; c < 3; c++)
+                {
+                    unsigned int color = p[0][c]*p[0][3] + p[1][c]*p[1][3] + p[2][c]*p[2][3] + p[3][c]*p[3][3];
+                    out[c] = (unsigned char)((color + alpha/2)/alpha);
+                }
+            }
+
+            out[3] = (unsigned char)((alpha + 2)/4);
+        }
+    }
+
+    return result;
+}
+
+// Get PSNR (dB) between two images of same size and format (R8G8B8A8)
+// NOTE: Identical images return a high value (100 dB), color is compared premultiplied by alpha
+static float GetImagePSNR(Image image1, Image image2)
+{
+    float psnr = 0.0f;
+
+    if ((image1.width == image2.width) && (image1.height == image2.height) &&
+        (image1.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) && (image2.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8))
+    {
+        const unsigned char *data1 = (const unsigned char *)image1.data;
+        const unsigned char *data2 = (const unsigned char *)image2.data;
+        int dataSize = image1.width*image1.height*4;
+        double sumSquaredError = 0.0;
+
+        for (int i = 0; i < dataSize; i += 4)
+        {
+            // Color compared premultiplied by alpha, fully transparent pixels color is not visible
+            for (int c = 0; c < 3; c++)
+            {
+                int diff = ((int)data1[i + c]*data1[i + 3] - (int)data2[i + c]*data2[i + 3])/255;
+                sumSquaredError += (double)(diff*diff);
+            }
+
+            int diff = (int)data1[i + 3] - (int)data2[i + 3];
+            sumSquaredError += (double)(diff*diff);
+        }
+
+        double mse = sumSquaredError/dataSize;
+        psnr = (mse > 0.0)? (float)(10.0*log10(255.0*255.0/mse)) : 100.0f;
+    }
+
+    return psnr;
+}
+
+// Get mean color difference (CIE76) between two images of same size and format (R8G8B8A8)
+// NOTE: Colors converted from sRGB to CIELAB (D65), difference weighted by alpha, transparent pixels not considered
+static float GetImageDeltaE(Image image1, Image image2)
+{
+    float deltaE = 0.0f;
+
+    if ((image1.width == image2.width) && (image1.height == image2.height) &&
+        (image1.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) && (image2.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8))
+    {
+        const unsigned char *data1 = (const unsigned char *)image1.data;
+        const unsigned char *data2 = (const unsigned char *)image2.data;
+        int dataSize = image1.width*image1.height*4;
+
+        // sRGB to linear values lookup table
+        float linear[256] = { 0 };
+        for (int i = 0; i < 256; i++)
+        {
+            float value = i/255.0f;
+            linear[i] = (value <= 0.04045f)? value/12.92f : powf((value + 0.055f)/1.055f, 2.4f);
+        }
+
+        double sumDeltaE = 0.0;
+        double sumWeight = 0.0;
+
+        for (int i = 0; i < dataSize; i += 4)
+        {
+            float weight = (data1[i + 3] + data2[i + 3])/510.0f;
+            if (weight == 0.0f) continue;
+
+            const unsigned char *pixels[2] = { data1 + i, data2 + i };
+            float lab[2][3] = { 0 };
+
+            for (int k = 0; k < 2; k++)
+            {
+                float r = linear[pixels[k][0]];
+                float g = linear[pixels[k][1]];
+                float b = linear[pixels[k][2]];
+
+                // Linear sRGB to XYZ, normalized by D65 reference white
+                float xyz[3] = {
+                    (0.4124f*r + 0.3576f*g + 0.1805f*b)/0.95047f,
+                    0.2126f*r + 0.7152f*g + 0.0722f*b,
+                    (0.0193f*r + 0.1192f*g + 0.9505f*b)/1.08883f
+                };
+
+                for (int c = 0; c < 3; c++) xyz[c] = (xyz[c] > 0.008856f)? cbrtf(xyz[c]) : (7.787f*xyz[c] + 16.0f/116.0f);
+
+                lab[k][0] = 116.0f*xyz[1] - 16.0f;
+                lab[k][1] = 500.0f*(xyz[0] - xyz[1]);
+                lab[k][2] = 200.0f*(xyz[1] - xyz[2]);
+            }
+
+            float dl = lab[0][0] - lab[1][0];
+            float da = lab[0][1] - lab[1][1];
+            float db = lab[0][2] - lab[1][2];
+
+            sumDeltaE += weight*sqrtf(dl*dl + da*da + db*db);
+            sumWeight += weight;
+        }
+
+        if (sumWeight > 0.0) deltaE = (float)(sumDeltaE/sumWeight);
+    }
+
+    return deltaE;
+}
+
+// Quantize image to indexed data (one byte per pixel), palette of maxColors or less (median-cut + k-means)
+// NOTE: Colors are quantized premultiplied by alpha (as compared by GetImagePSNR()), fully transparent pixels
+// share one palette entry, dithering strength [0.0f..1.0f] scales Floyd-Steinberg error diffusion,
+// image format required: R8G8B8A8, returned data must be freed with RL_FREE()
+static unsigned char *QuantizeImage(Image image, int maxColors, float dithering, Color *palette, int *colorCount)
+{
+    *colorCount = 0;
+    if ((image.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) || (maxColors < 1) || (maxColors > 256)) return NULL;
+
+    int pixelCount = image.width*image.height;
+    const unsigned char *pixels = (const unsigned char *)image.data;
+
+    // Pixels colors premultiplied by alpha, reordered in place by median-cut
+    unsigned char *colors = (unsigned char *)RL_MALLOC(pixelCount*4);
+
+    for (int i = 0; i < pixelCount; i++)
+    {
+        unsigned int alpha = pixels[i*4 + 3];
+
+        for (int c = 0; c < 3; c++) colors[i*4 + c] = (unsigned char)((pixels[i*4 + c]*alpha + 127)/255);
+        colors[i*4 + 3] = (unsigned char)alpha;
+    }
+
+    // Median-cut: box with bigger channel range (weighted by pixels count) split by median value
+    QuantizeBox boxes[256] = { 0 };
+    boxes[0].count = pixelCount;
+    UpdateQuantizeBox(&boxes[0], colors);
+    int boxCount = 1;
+
+    while (boxCount < maxColors)
+    {
+        int split = -1;
+        long long splitScore = 0;
+
+        for (int b = 0; b < boxCount; b++)
+        {
+            long long score = (long long)boxes[b].range*boxes[b].count;
+            if (score > splitScore) { splitScore = score; split = b; }
+        }
+
+        if (split == -1) break;     // All boxes contain one color
+
+        QuantizeBox *box = &boxes[split];
+        int channel = box->channel;
+        unsigned int histogram[256] = { 0 };
+
+        for (int i = box->start; i < (box->start + box->count); i++) histogram[colors[i*4 + channel]]++;
+
+        int median = 0;
+        unsigned int lowerCount = histogram[0];
+        while ((lowerCount*2) < (unsigned int)box->count) lowerCount += histogram[++median];
+
+        // Median is the box maximum value, split below it (box range is not 0)
+        if (lowerCount == (unsigned int)box->count) lowerCount -= histogram[median--];
+
+        // Partition box pixels: values lower or equal than median first
+        int left = box->start;
+        int right = box->start + box->count - 1;
+
+        while (left <= right)
+        {
+            if (colors[left*4 + channel] <= median) left++;
+            else
+            {
+                unsigned int temp = 0;
+                memcpy(&temp, colors + left*4, 4);
+                memcpy(colors + left*4, colors + right*4, 4);
+                memcpy(colors + right*4, &temp, 4);
+                right--;
+            }
+        }
+
+        boxes[boxCount].start = left;
+        boxes[boxCount].count = box->start + box->count - left;
+        box->count = left - box->start;
+
+        UpdateQuantizeBox(box, colors);
+        UpdateQuantizeBox(&boxes[boxCount], colors);
+        boxCount++;
+    }
+
+    // Palette colors (premultiplied) initialized with boxes mean color
+    unsigned char means[256*4] = { 0 };
+
+    for (int b = 0; b < boxCount; b++)
+    {
+        unsigned int sum[4] = { 0 };
+        for (int i = boxes[b].start; i < (boxes[b].start + boxes[b].count); i++) for (int c = 0; c < 4; c++) sum[c] += colors[i*4 + c];
+        for (int c = 0; c < 4; c++) means[b*4 + c] = (unsigned char)((sum[c] + boxes[b].count/2)/boxes[b].count);
+    }
+
+    // K-means refinement: pixels assigned to nearest palette color, palette colors moved to assigned pixels mean
+    // NOTE: Palette colors without assigned pixels are kept
+    for (int step = 0; step < QUANTIZE_KMEANS_STEPS; step++)
+    {
+        unsigned int sums[256][4] = { 0 };
+        unsigned int counts[256] = { 0 };
+
+        for (int i = 0; i < pixelCount; i++)
+        {
+            const unsigned char *color = colors + i*4;
+            int index = GetNearestPaletteColor(means, boxCount, color[0], color[1], color[2], color[3]);
+
+            for (int c = 0; c < 4; c++) sums[index][c] += color[c];
+            counts[index]++;
+        }
+
+        for (int k = 0; k < boxCount; k++)
+        {
+            if (counts[k] > 0) for (int c = 0; c < 4; c++) means[k*4 + c] = (unsigned char)((sums[k][c] + counts[k]/2)/counts[k]);
+        }
+    }
+
+    RL_FREE(colors);
+
+    // Pixels mapped to nearest palette color, quantization error diffused to neighbour pixels if dithering
+    // NOTE: Error rows (current and next) include one extra value per side, fully transparent pixels are not dithered
+    unsigned char *indexedData = (unsigned char *)RL_MALLOC(pixelCount);
+    int rowSize = (image.width + 2)*4;
+    float *errorRows = (float *)RL_CALLOC(rowSize*2, sizeof(float));
+    bool dither = (dithering > 0.0f);
+
+    for (int y = 0; y < image.height; y++)
+    {
+        float *error = errorRows + (y%2)*rowSize + 4;
+        float *errorNext = errorRows + ((y + 1)%2)*rowSize + 4;
+        memset(errorNext - 4, 0, rowSize*sizeof(float));
+
+        for (int x = 0; x < image.width; x++)
+        {
+            int i = y*image.width + x;
+            int alpha = pixels[i*4 + 3];
+            int value[4] = { 0 };
+
+            for (int c = 0; c < 3; c++) value[c] = (pixels[i*4 + c]*alpha + 127)/255;
+            value[3] = alpha;
+
+            if (dither && (alpha > 0))
+            {
+                for (int c = 0; c < 4; c++)
+                {
+                    value[c] = (int)floorf(value[c] + error[x*4 + c] + 0.5f);
+                    value[c] = (value[c] < 0)? 0 : ((value[c] > 255)? 255 : value[c]);
+                }
+            }
+
+            int index = GetNearestPaletteColor(means, boxCount, value[0], value[1], value[2], value[3]);
+            indexedData[i] = (unsigned char)index;
+
+            if (dither && (alpha > 0))
+            {
+                for (int c = 0; c < 4; c++)
+                {
+                    float diff = (value[c] - means[index*4 + c])*dithering;
+
+                    error[(x + 1)*4 + c] += diff*7.0f/16.0f;
+                    errorNext[(x - 1)*4 + c] += diff*3.0f/16.0f;
+                    errorNext[x*4 + c] += diff*5.0f/16.0f;
+                    errorNext[(x + 1)*4 + c] += diff*1.0f/16.0f;
+                }
+            }
+        }
+    }
+
+    RL_FREE(errorRows);
+
+    // Palette colors converted back to straight alpha
+    for (int k = 0; k < boxCount; k++)
+    {
+        unsigned int alpha = means[k*4 + 3];
+        unsigned char *color = (unsigned char *)&palette[k];
+
+        for (int c = 0; c < 3; c++)
+        {
+            unsigned int value = (alpha > 0)? (means[k*4 + c]*255 + alpha/2)/alpha : 0;
+            color[c] = (unsigned char)((value > 255)? 255 : value);
+        }
+
+        palette[k].a = (unsigned char)alpha;
+    }
+
+    *colorCount = boxCount;
+
+    return indexedData;
+}
+
+// Update quantization box split channel and range
+// NOTE: Alpha range is not weighted, alpha differences are as visible as premultiplied color differences
+static void UpdateQuantizeBox(QuantizeBox *box, const unsigned char *colors)
+{
+    unsigned char minValue[4] = { 255, 255, 255, 255 };
+    unsigned char maxValue[4] = { 0 };
+
+    for (int i = box->start; i < (box->start + box->count); i++)
+    {
+        for (int c = 0; c < 4; c++)
+        {
+            if (colors[i*4 + c] < minValue[c]) minValue[c] = colors[i*4 + c];
+            if (colors[i*4 + c] > maxValue[c]) maxValue[c] = colors[i*4 + c];
+        }
+    }
+
+    box->channel = 0;
+    box->range = 0;
+
+    for (int c = 0; c < 4; c++)
+    {
+        int range = (box->count > 0)? (maxValue[c] - minValue[c]) : 0;
+        if (range > box->range) { box->range = range; box->channel = c; }
+    }
+}
+
+// Get nearest palette color index (squared distance), palette colors as RGBA bytes
+static int GetNearestPaletteColor(const unsigned char *palette, int colorCount, int r, int g, int b, int a)
+{
+    int index = 0;
+    int minDistance = 0x7fffffff;
+
+    for (int k = 0; k < colorCount; k++)
+    {
+        const unsigned char *color = palette + k*4;
+        int dr = r - color[0], dg = g - color[1], db = b - color[2], da = a - color[3];
+        int distance = dr*dr + dg*dg + db*db + da*da;
+
+        if (distance < minDistance)
+        {
+            minDistance = distance;
+            index = k;
+            if (distance == 0) break;
+        }
+    }
+
+    return index;
+}
+
+//--------------------------------------------------------------------------------------------
+// Image resampling functions
+//--------------------------------------------------------------------------------------------
+
+// Resample image to new size, returns a new image
+// NOTE: Separable filter (horizontal + vertical passes) computed on premultiplied alpha float data,
+// only R8G8B8A8 images supported, other formats are scaled with raylib ImageResize()/ImageResizeNN()
+static Image ResampleImage(Image image, int newWidth, int newHeight, int filter)
+{
+    Image result = { 0 };
+
+    if ((image.data == NULL) || (newWidth <= 0) || (newHeight <= 0)) return result;
+
+    if (image.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8)
+    {
+        result = ImageCopy(image);
+
+        if (filter == RESAMPLE_FILTER_NEAREST) ImageResizeNN(&result, newWidth, newHeight);
+        else ImageResize(&result, newWidth, newHeight);
 
-            // Try to find rIPt text lines
-            if (IsFileExtension(fileName, ".png"))
-            {
-                // Read custom rIconPacker text chunk from PNG
-                rpng_chunk chunk = rpng_chunk_read(fileName, "rIPt");
-                if (chunk.length > 0) memcpy(entries[0].text, chunk.data, (chunk.length < MAX_IMAGE_TEXT_SIZE)? chunk.length : MAX_IMAGE_TEXT_SIZE - 1);
-                RPNG_FREE(chunk.data);
-            }
-        }
-        else UnloadImage(image);
+        return result;
     }
 
-    int dupIndex = -1;
+#if defined(SUPPORT_LOG_INFO) && defined(_DEBUG)
+    double startTime = GetTimeMilliseconds();
+#endif
 
-    // Add new entries to bucket
-    for (int i = 0; (i < imageCount) && (bucket->count < bucket->capacity); i++)
+    result.width = newWidth;
+    result.height = newHeight;
+    result.mipmaps = 1;
+    result.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    result.data = RL_MALLOC(newWidth*newHeight*4);
+
+    const unsigned char *src = (const unsigned char *)image.data;
+    unsigned char *dst = (unsigned char *)result.data;
+
+    if (filter == RESAMPLE_FILTER_NEAREST)
     {
-        // Check if bucket already contains an image with same size
-        for (int k = 0; k < bucket->count; k++)
+        // NOTE: Same fixed-point sampling as raylib ImageResizeNN()
+        int xRatio = (int)((image.width << 16)/newWidth) + 1;
+        int yRatio = (int)((image.height << 16)/newHeight) + 1;
+
+        for (int y = 0; y < newHeight; y++)
         {
-            if (entries[i].size == bucket->entries[k].size)
+            const unsigned char *srcRow = src + ((y*yRatio) >> 16)*image.width*4;
+
+            for (int x = 0; x < newWidth; x++) memcpy(dst + (y*newWidth + x)*4, srcRow + ((x*xRatio) >> 16)*4, 4);
+        }
+    }
+    else
+    {
+        ResampleWeights weightsX = LoadResampleWeights(image.width, newWidth, filter);
+        bool sharedWeights = (image.width == image.height) && (newWidth == newHeight);
+        ResampleWeights weightsY = sharedWeights? weightsX : LoadResampleWeights(image.height, newHeight, filter);
+
+        float *srcRow = (float *)RL_MALLOC(image.width*4*sizeof(float));              // Source row, premultiplied alpha
+        float *temp = (float *)RL_MALLOC(newWidth*image.height*4*sizeof(float));      // Horizontal pass output
+        float *dstRow = (float *)RL_MALLOC(newWidth*4*sizeof(float));                 // Vertical pass output row
+
+        // Horizontal pass: source rows -> temp rows (newWidth)
+        for (int y = 0; y < image.height; y++)
+        {
+            const unsigned char *srcPixels = src + y*image.width*4;
+
+            for (int x = 0; x < image.width; x++)
             {
-                // Found bucket entry with same size -> replace bucket entry!
-                dupIndex = k;
-                break;
+                float alpha = srcPixels[x*4 + 3]/255.0f;
+
+                srcRow[x*4 + 0] = srcPixels[x*4 + 0]*alpha;
+                srcRow[x*4 + 1] = srcPixels[x*4 + 1]*alpha;
+                srcRow[x*4 + 2] = srcPixels[x*4 + 2]*alpha;
+                srcRow[x*4 + 3] = srcPixels[x*4 + 3];
+            }
+
+            float *tempRow = temp + y*newWidth*4;
+
+            for (int x = 0; x < newWidth; x++)
+            {
+                const float *weights = weightsX.weights + x*weightsX.taps;
+                const float *pixels = srcRow + weightsX.start[x]*4;
+                int count = weightsX.count[x];
+
+                // One RGBA pixel per vector
+#if defined(SUPPORT_SIMD_SSE)
+                __m128 sum = _mm_setzero_ps();
+                for (int k = 0; k < count; k++) sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(pixels + k*4), _mm_set1_ps(weights[k])));
+                _mm_storeu_ps(tempRow + x*4, sum);
+#elif defined(SUPPORT_SIMD_NEON)
+                float32x4_t sum = vdupq_n_f32(0.0f);
+                for (int k = 0; k < count; k++) sum = vmlaq_n_f32(sum, vld1q_f32(pixels + k*4), weights[k]);
+                vst1q_f32(tempRow + x*4, sum);
+#else
+                float sum[4] = { 0 };
+                for (int k = 0; k < count; k++)
+                {
+                    for (int c = 0; c < 4; c++) sum[c] += pixels[k*4 + c]*weights[k];
+                }
+                memcpy(tempRow + x*4, sum, 4*sizeof(float));
+#endif
             }
         }
 
-        if (dupIndex > -1)
+        // Vertical pass: temp rows -> destination rows, accumulated per row
+        for (int y = 0; y < newHeight; y++)
         {
-            // Unload current entry
-            UnloadImage(bucket->entries[dupIndex].image);
-            memset(bucket->entries[dupIndex].text, 0, MAX_IMAGE_TEXT_SIZE);
+            memset(dstRow, 0, newWidth*4*sizeof(float));
 
-            // Update with new entry
-            bucket->entries[dupIndex] = entries[i];
-            if (entries[i].text[0] != '\0') memcpy(bucket->entries[dupIndex].text, entries[i].text, MAX_IMAGE_TEXT_SIZE);
-            dupIndex = -1;
+            for (int k = 0; k < weightsY.count[y]; k++)
+            {
+                const float *tempRow = temp + (weightsY.start[y] + k)*newWidth*4;
+                float weight = weightsY.weights[y*weightsY.taps + k];
+
+#if defined(SUPPORT_SIMD_SSE)
+                __m128 vweight = _mm_set1_ps(weight);
+                for (int x = 0; x < newWidth*4; x += 4) _mm_storeu_ps(dstRow + x, _mm_add_ps(_mm_loadu_ps(dstRow + x), _mm_mul_ps(_mm_loadu_ps(tempRow + x), vweight)));
+#elif defined(SUPPORT_SIMD_NEON)
+                for (int x = 0; x < newWidth*4; x += 4) vst1q_f32(dstRow + x, vmlaq_n_f32(vld1q_f32(dstRow + x), vld1q_f32(tempRow + x), weight));
+#else
+                for (int x = 0; x < newWidth*4; x++) dstRow[x] += tempRow[x]*weight;
+#endif
+            }
+
+            // Convert back to straight alpha, rounded and clamped
+            unsigned char *dstPixels = dst + y*newWidth*4;
+
+            for (int x = 0; x < newWidth; x++)
+            {
+                float alpha = dstRow[x*4 + 3];
+
+                if (alpha < 0.5f) memset(dstPixels + x*4, 0, 4);
+                else
+                {
+                    if (alpha > 255.0f) alpha = 255.0f;
+
+                    for (int c = 0; c < 3; c++)
+                    {
+                        float value = dstRow[x*4 + c]*255.0f/alpha;
+                        dstPixels[x*4 + c] = (value <= 0.0f)? 0 : ((value >= 255.0f)? 255 : (unsigned char)(value + 0.5f));
+                    }
+
+                    dstPixels[x*4 + 3] = (unsigned char)(alpha + 0.5f);
+                }
+            }
         }
-        else
+
+        RL_FREE(srcRow);
+        RL_FREE(temp);
+        RL_FREE(dstRow);
+
+        UnloadResampleWeights(weightsX);
+        if (!sharedWeights) UnloadResampleWeights(weightsY);
+    }
+
+#if defined(SUPPORT_LOG_INFO) && defined(_DEBUG)
+    double time = GetTimeMilliseconds() - startTime;
+    LOG("INFO: Image resampled (%ix%i -> %ix%i): %.2f ms (%.2f Mpix/s)\n", image.width, image.height, newWidth, newHeight,
+        time, (time > 0.0)? (double)image.width*image.height/(time*1000.0) : 0.0);
+#endif
+
+    return result;
+}
+
+// Load resampling weights for one dimension
+// NOTE: Filter is widened on downscaling (antialiasing), taps outside source are discarded and weights normalized
+static ResampleWeights LoadResampleWeights(int srcSize, int dstSize, int filter)
+{
+    ResampleWeights weights = { 0 };
+
+    float support = (filter == RESAMPLE_FILTER_LANCZOS3)? 3.0f : 2.0f;
+    float scale = (float)srcSize/(float)dstSize;
+    float filterScale = (scale > 1.0f)? scale : 1.0f;
+    float radius = support*filterScale;
+
+    weights.taps = (int)ceilf(radius)*2 + 2;
+    weights.start = (int *)RL_CALLOC(dstSize, sizeof(int));
+    weights.count = (int *)RL_CALLOC(dstSize, sizeof(int));
+    weights.weights = (float *)RL_CALLOC(dstSize*weights.taps, sizeof(float));
+
+    for (int i = 0; i < dstSize; i++)
+    {
+        float center = (i + 0.5f)*scale;
+        int left = (int)floorf(center - radius);
+        int right = (int)ceilf(center + radius);
+
+        if (left < 0) left = 0;
+        if (right > srcSize) right = srcSize;
+        if ((right - left) > weights.taps) right = left + weights.taps;
+
+        float *values = weights.weights + i*weights.taps;
+        float total = 0.0f;
+
+        for (int k = 0; k < (right - left); k++)
         {
-            bucket->entries[bucket->count] = entries[i];
-            if (entries[i].text[0] != '\0') memcpy(bucket->entries[bucket->count].text, entries[i].text, MAX_IMAGE_TEXT_SIZE);
-            bucket->count++;
+            values[k] = GetResampleKernelValue(((left + k + 0.5f) - center)/filterScale, filter);
+            total += values[k];
         }
+
+        if (total != 0.0f) for (int k = 0; k < (right - left); k++) values[k] /= total;
+
+        weights.start[i] = left;
+        weights.count[i] = right - left;
     }
 
-    RL_FREE(entries);
+    return weights;
 }
 
-// Remove icon from bucket
-static void RemoveIconFromBucket(IconBucket *bucket, unsigned int size)
+// Unload resampling weights
+static void UnloadResampleWeights(ResampleWeights weights)
 {
-    // TODO: Remove bucket icon... really required?
+    RL_FREE(weights.start);
+    RL_FREE(weights.count);
+    RL_FREE(weights.weights);
 }
 
-// Clear icon bucket
-static void ClearIconBucket(IconBucket *bucket)
+// Get resampling filter kernel value at provided distance
+static float GetResampleKernelValue(float x, int filter)
 {
-    for (int i = 0; i < bucket->count; i++)
+    float value = 0.0f;
+
+    x = fabsf(x);
+
+    if (filter == RESAMPLE_FILTER_BICUBIC)
     {
-        UnloadImage(bucket->entries[i].image);
-        bucket->entries[i] = (IconEntry){ 0 };
+        // Catmull-Rom spline (a = -0.5)
+        if (x < 1.0f) value = (1.5f*x - 2.5f)*x*x + 1.0f;
+        else if (x < 2.0f) value = ((-0.5f*x + 2.5f)*x - 4.0f)*x + 2.0f;
+    }
+    else if (filter == RESAMPLE_FILTER_LANCZOS3)
+    {
+        if (x < 1e-6f) value = 1.0f;
+        else if (x < 3.0f) value = 3.0f*sinf(PI*x)*sinf(PI*x/3.0f)/(PI*PI*x*x);
     }
 
-    bucket->count = 0;
+    return value;
 }
 
-// NOTE: Platform determines the requested sizes
-static void UpdateIconPackFromBucket(IconPack *pack, IconBucket bucket)
+//--------------------------------------------------------------------------------------------
+// Worker pool functions
+//--------------------------------------------------------------------------------------------
+#if defined(SUPPORT_WORKER_THREADS)
+// Worker pool synchronization primitives
+#if defined(_WIN32)
+static void LockWorkerPool(void) { AcquireSRWLockExclusive(&workerPool.lock); }
+static void UnlockWorkerPool(void) { ReleaseSRWLockExclusive(&workerPool.lock); }
+static void WaitJobsReady(void) { SleepConditionVariableSRW(&workerPool.jobsReady, &workerPool.lock, 0xffffffff, 0); }
+static void WaitJobsDone(void) { SleepConditionVariableSRW(&workerPool.jobsDone, &workerPool.lock, 0xffffffff, 0); }
+static void SignalJobsReady(void) { WakeAllConditionVariable(&workerPool.jobsReady); }
+static void SignalJobsDone(void) { WakeConditionVariable(&workerPool.jobsDone); }
+#else
+static void LockWorkerPool(void) { pthread_mutex_lock(&workerPool.lock); }
+static void UnlockWorkerPool(void) { pthread_mutex_unlock(&workerPool.lock); }
+static void WaitJobsReady(void) { pthread_cond_wait(&workerPool.jobsReady, &workerPool.lock); }
+static void WaitJobsDone(void) { pthread_cond_wait(&workerPool.jobsDone, &workerPool.lock); }
+static void SignalJobsReady(void) { pthread_cond_broadcast(&workerPool.jobsReady); }
+static void SignalJobsDone(void) { pthread_cond_signal(&workerPool.jobsDone); }
+#endif
+
+// Process available jobs from current batch
+// WARNING: Worker pool must be locked on call, lock is released while job is processed
+static void ProcessWorkerJobs(void)
 {
-    for (int i = 0; i < bucket.count; i++)
+    while (workerPool.jobNext < workerPool.jobCount)
     {
-        for (int k = 0; k < pack->count; k++)
-        {
-            if (bucket.entries[i].size == pack->entries[k].size)
-            {
-                if (pack->entries[k].generated) UnloadImage(pack->entries[k].image);
+        int index = workerPool.jobNext;
+        workerPool.jobNext++;
 
-                pack->entries[k] = bucket.entries[i];
+        UnlockWorkerPool();
+        workerPool.jobFunc(workerPool.jobsData + index*workerPool.jobSize);
+        LockWorkerPool();
 
-                UnloadTexture(pack->textures[k]);
-                pack->textures[k] = (Texture2D){ 0 };
-                pack->textures[k] = LoadTextureFromImage(pack->entries[k].image);
+        workerPool.jobDone++;
+        if (workerPool.jobDone == workerPool.jobCount) SignalJobsDone();
+    }
+}
 
-                pack->entries[k].valid = true;
-                pack->entries[k].generated = false;
-            }
+// Worker thread main loop: wait for new jobs batch and process it
+#if defined(_WIN32)
+static unsigned int __stdcall WorkerThreadMain(void *arg)
+#else
+static void *WorkerThreadMain(void *arg)
+#endif
+{
+    unsigned int batchId = 0;
+
+    LockWorkerPool();
+
+    while (true)
+    {
+        while (!workerPool.shutdown && (workerPool.batchId == batchId)) WaitJobsReady();
+
+        if (workerPool.shutdown) break;
+
+        batchId = workerPool.batchId;
+        ProcessWorkerJobs();
+    }
+
+    UnlockWorkerPool();
+
+    return 0;
+}
+#endif  // SUPPORT_WORKER_THREADS
+
+// Initialize worker pool, launching worker threads
+// NOTE: Threads wait for jobs batches, launched by RunWorkerJobs()
+static void InitWorkerPool(int threadCount)
+{
+    if (workerPool.ready) return;
+
+    if (threadCount > MAX_WORKER_THREADS) threadCount = MAX_WORKER_THREADS;
+    if (threadCount < 0) threadCount = 0;
+
+    workerPool = (WorkerPool){ 0 };
+
+#if defined(SUPPORT_WORKER_THREADS)
+#if defined(_WIN32)
+    InitializeSRWLock(&workerPool.lock);
+    InitializeConditionVariable(&workerPool.jobsReady);
+    InitializeConditionVariable(&workerPool.jobsDone);
+#else
+    pthread_mutex_init(&workerPool.lock, NULL);
+    pthread_cond_init(&workerPool.jobsReady, NULL);
+    pthread_cond_init(&workerPool.jobsDone, NULL);
+#endif
+
+    for (int i = 0; i < threadCount; i++)
+    {
+#if defined(_WIN32)
+        workerPool.threads[i] = (void *)_beginthreadex(NULL, 0, WorkerThreadMain, NULL, 0, NULL);
+        if (workerPool.threads[i] == NULL) break;
+#else
+        if (pthread_create(&workerPool.threads[i], NULL, WorkerThreadMain, NULL) != 0) break;
+#endif
+        workerPool.threadCount++;
+    }
+
+    LOG("INFO: Worker pool initialized: %i threads\n", workerPool.threadCount);
+#endif
+    workerPool.ready = true;
+}
+
+// Close worker pool, joining worker threads
+static void CloseWorkerPool(void)
+{
+    if (!workerPool.ready) return;
+
+#if defined(SUPPORT_WORKER_THREADS)
+    LockWorkerPool();
+    workerPool.shutdown = true;
+    SignalJobsReady();
+    UnlockWorkerPool();
+
+    for (int i = 0; i < workerPool.threadCount; i++)
+    {
+#if defined(_WIN32)
+        WaitForSingleObject(workerPool.threads[i], 0xffffffff);
+        CloseHandle(workerPool.threads[i]);
+#else
+        pthread_join(workerPool.threads[i], NULL);
+#endif
+    }
+
+#if !defined(_WIN32)
+    pthread_cond_destroy(&workerPool.jobsDone);
+    pthread_cond_destroy(&workerPool.jobsReady);
+    pthread_mutex_destroy(&workerPool.lock);
+#endif
+#endif
+    workerPool = (WorkerPool){ 0 };
+}
+
+// Run jobs batch, waits until all jobs are completed
+// NOTE: Jobs are processed in array order, caller thread also processes jobs,
+// in case worker pool is busy (nested batch) or not available, jobs are processed serially
+static void RunWorkerJobs(WorkerJobFunc jobFunc, void *jobsData, int jobSize, int jobCount)
+{
+    if (jobCount <= 0) return;
+
+    if (!RunWorkerJobsParallel(jobFunc, jobsData, jobSize, jobCount))
+    {
+        for (int i = 0; i < jobCount; i++) jobFunc((unsigned char *)jobsData + i*jobSize);
+    }
+}
+
+// Run jobs batch on worker pool, waits until all jobs are completed
+// NOTE: Returns false if worker pool is busy (nested batch) or not available, no job is processed,
+// used as rpng jobs runner: image data stripes only compressed if they can be processed in parallel
+static bool RunWorkerJobsParallel(WorkerJobFunc jobFunc, void *jobsData, int jobSize, int jobCount)
+{
+    bool processed = false;
+
+    if (!workerPool.ready) InitWorkerPool(GetProcessorCount() - 1);
+
+#if defined(SUPPORT_WORKER_THREADS)
+    if ((workerPool.threadCount > 0) && (jobCount > 1))
+    {
+        LockWorkerPool();
+
+        if (!workerPool.busy)
+        {
+            workerPool.busy = true;
+            workerPool.jobFunc = jobFunc;
+            workerPool.jobsData = (unsigned char *)jobsData;
+            workerPool.jobSize = jobSize;
+            workerPool.jobCount = jobCount;
+            workerPool.jobNext = 0;
+            workerPool.jobDone = 0;
+            workerPool.batchId++;
+            SignalJobsReady();
+
+            ProcessWorkerJobs();
+            while (workerPool.jobDone < workerPool.jobCount) WaitJobsDone();
+
+            workerPool.jobFunc = NULL;
+            workerPool.jobsData = NULL;
+            workerPool.jobCount = 0;
+            workerPool.jobNext = 0;
+            workerPool.busy = false;
+            processed = true;
         }
+
+        UnlockWorkerPool();
     }
+#endif
+
+    return processed;
 }
 
-// Reset icon pack data
-static void ResetIconPack(IconPack *pack, int platform)
+// Get available logical processors
+static int GetProcessorCount(void)
 {
-    // Clear full pack
-    for (int i = 0; i < MAX_PACK_ELEMENTS; i++)
+    int count = 1;
+
+#if defined(SUPPORT_WORKER_THREADS)
+#if defined(_WIN32)
+    count = (int)GetActiveProcessorCount(0xffff);   // ALL_PROCESSOR_GROUPS
+#else
+    count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+#endif
+    if (count < 1) count = 1;
+
+    return count;
+}
+
+// Set threads used to compress one PNG image data (multithreaded deflate)
+// NOTE: Image data stripes are compressed on worker pool, in case pool is busy (i.e. encoding
+// multiple entries in parallel) image data is compressed as a single stream by caller thread
+static void SetCompressionThreads(int threadCount)
+{
+    if (threadCount <= 0) threadCount = GetProcessorCount();
+    if (threadCount > (MAX_WORKER_THREADS + 1)) threadCount = MAX_WORKER_THREADS + 1;
+
+    compressionThreads = threadCount;
+#if defined(SUPPORT_WORKER_THREADS)
+    rpng_set_deflate_threads(compressionThreads, RunWorkerJobsParallel);
+#else
+    rpng_set_deflate_threads(1, NULL);
+#endif
+}
+
+#if defined(PLATFORM_DESKTOP) || defined(COMMAND_LINE_ONLY)
+// Get compression effort from text (name or value), -1 if not valid
+static int GetCompressionEffort(const char *text)
+{
+    static const char *effortNames[5] = { "store", "fast", "default", "max", "squeeze" };
+    int effort = -1;
+
+    for (int i = 0; i < 5; i++) if (TextIsEqual(text, effortNames[i])) effort = i;
+
+    if ((effort == -1) && (text[0] >= '0') && (text[0] <= '9'))
     {
-        if (pack->entries[i].generated) UnloadImage(pack->entries[i].image);
-        else pack->entries[i].image = (Image){ 0 };      // Remove bucket image (not unload)
+        effort = TextToInteger(text);
+        if (effort > RPNG_COMPRESSION_SQUEEZE) effort = -1;
+    }
 
-        UnloadTexture(pack->textures[i]);
-        pack->textures[i] = (Texture2D){ 0 };
+    return effort;
+}
+#endif
 
-        memset(pack->entries[i].text, 0, MAX_IMAGE_TEXT_SIZE);
-        pack->entries[i].generated = false;
-        pack->entries[i].valid = false;
-        pack->entries[i].size = 0;
+#if defined(PLATFORM_WEB) || defined(EXPORT_IMAGE_PACK_AS_ZIP)
+// Get zip compression level for PNG compression effort
+// NOTE: PNG data is already compressed, zip compression level follows requested effort
+static int GetZipCompressionLevel(int effort)
+{
+    int level = MZ_BEST_SPEED;
+
+    if (effort == RPNG_COMPRESSION_STORE) level = MZ_NO_COMPRESSION;
+    else if (effort >= RPNG_COMPRESSION_MAX) level = MZ_BEST_COMPRESSION;
+
+    return level;
+}
+#endif
+
+// Get monotonic time in milliseconds
+// NOTE: raylib GetTime() requires an initialized window, not available on command line usage
+static double GetTimeMilliseconds(void)
+{
+    double time = 0.0;
+
+#if defined(_WIN32)
+    unsigned long long counter = 0, frequency = 1;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    time = (double)counter*1000.0/(double)frequency;
+#else
+    struct timespec ts = { 0 };
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    time = (double)ts.tv_sec*1000.0 + (double)ts.tv_nsec/1000000.0;
+#endif
+
+    return time;
+}
+
+// Get data 64bit hash (xxHash64)
+// NOTE: Data read in native byte order, hashes are not portable between platforms of different endianness
+static unsigned long long GetDataHash(const void *data, unsigned int size, unsigned long long seed)
+{
+    #define HASH_PRIME64_1  0x9E3779B185EBCA87ULL
+    #define HASH_PRIME64_2  0xC2B2AE3D27D4EB4FULL
+    #define HASH_PRIME64_3  0x165667B19E3779F9ULL
+    #define HASH_PRIME64_4  0x85EBCA77C2B2AE63ULL
+    #define HASH_PRIME64_5  0x27D4EB2F165667C5ULL
+    #define HASH_ROTL64(x, r) (((x) << (r)) | ((x) >> (64 - (r))))
+    #define HASH_ROUND(acc, input) (HASH_ROTL64((acc) + (input)*HASH_PRIME64_2, 31)*HASH_PRIME64_1)
+
+    const unsigned char *bytes = (const unsigned char *)data;
+    const unsigned char *end = bytes + size;
+    unsigned long long hash = 0;
+    unsigned long long lane = 0;
+
+    if (size >= 32)
+    {
+        unsigned long long acc[4] = { seed + HASH_PRIME64_1 + HASH_PRIME64_2, seed + HASH_PRIME64_2, seed, seed - HASH_PRIME64_1 };
+
+        while ((end - bytes) >= 32)
+        {
+            for (int i = 0; i < 4; i++, bytes += 8)
+            {
+                memcpy(&lane, bytes, 8);
+                acc[i] = HASH_ROUND(acc[i], lane);
+            }
+        }
+
+        hash = HASH_ROTL64(acc[0], 1) + HASH_ROTL64(acc[1], 7) + HASH_ROTL64(acc[2], 12) + HASH_ROTL64(acc[3], 18);
+        for (int i = 0; i < 4; i++) hash = (hash ^ HASH_ROUND(0, acc[i]))*HASH_PRIME64_1 + HASH_PRIME64_4;
     }
+    else hash = seed + HASH_PRIME64_5;
 
-    // Reset to required platform
-    unsigned int *platformSizes = NULL;
-    switch (platform)
+    hash += size;
+
+    for (; (end - bytes) >= 8; bytes += 8)
     {
-        case ICON_PLATFORM_WINDOWS: pack->count = 8; platformSizes = icoSizesWindows; break;
-        case ICON_PLATFORM_MACOS: pack->count = 8; platformSizes = icoSizesMacOS; break;
-        case ICON_PLATFORM_FAVICON: pack->count = 10; platformSizes = icoSizesFavicon; break;
-        case ICON_PLATFORM_ANDROID: pack->count = 10; platformSizes = icoSizesAndroid; break;
-        case ICON_PLATFORM_IOS7: pack->count = 9; platformSizes = icoSizesiOS; break;
-        default: break;
+        memcpy(&lane, bytes, 8);
+        hash ^= HASH_ROUND(0, lane);
+        hash = HASH_ROTL64(hash, 27)*HASH_PRIME64_1 + HASH_PRIME64_4;
     }
 
-    for (int i = 0; i < pack->count; i++) pack->entries[i].size = platformSizes[i];
-}
\ No newline at end of file
+    if ((end - bytes) >= 4)
+    {
+        unsigned int lane32 = 0;
+        memcpy(&lane32, bytes, 4);
+        hash ^= lane32*HASH_PRIME64_1;
+        hash = HASH_ROTL64(hash, 23)*HASH_PRIME64_2 + HASH_PRIME64_3;
+        bytes += 4;
+    }
+
+    for (; bytes < end; bytes++)
+    {
+        hash ^= (*bytes)*HASH_PRIME64_5;
+        hash = HASH_ROTL64(hash, 11)*HASH_PRIME64_1;
+    }
+
+    // Final mix (avalanche)
+    hash ^= hash >> 33;
+    hash *= HASH_PRIME64_2;
+    hash ^= hash >> 29;
+    hash *= HASH_PRIME64_3;
+    hash ^= hash >> 32;
+
+    #undef HASH_PRIME64_1
+    #undef HASH_PRIME64_2
+    #undef HASH_PRIME64_3
+    #undef HASH_PRIME64_4
+    #undef HASH_PRIME64_5
+    #undef HASH_ROTL64
+    #undef HASH_ROUND
+
+    return hash;
+}
+
+// Split text in place, delimiters replaced by '\0'
+// NOTE: Returns number of parts found, parts pointers point to provided text
+static int SplitTextInPlace(char *text, char delimiter, char **parts, int maxParts)
+{
+    int count = 0;
+
+    if ((text != NULL) && (maxParts > 0))
+    {
+        parts[count++] = text;
+
+        for (char *ptr = text; *ptr != '\0'; ptr++)
+        {
+            if (*ptr == delimiter)
+            {
+                if (count >= maxParts) break;
+
+                *ptr = '\0';
+                parts[count++] = ptr + 1;
+            }
+        }
+    }
+
+    return count;
+}
+
+// Trim text spaces in place (start and end)
+// NOTE: Returns pointer to first non-space character of provided text
+static char *TrimTextInPlace(char *text)
+{
+    while ((*text == ' ') || (*text == '\t')) text++;
+
+    int length = (int)strlen(text);
+    while ((length > 0) && ((text[length - 1] == ' ') || (text[length - 1] == '\t') || (text[length - 1] == '\r'))) text[--length] = '\0';
+
+    return text;
+}
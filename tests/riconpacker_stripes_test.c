@@ -0,0 +1,164 @@
+/*******************************************************************************************
+*
+*   rIconPacker stripes test - full icon pack export compresses its biggest entry in stripes
+*
+*   A full macOS icon pack (16..1024) is exported to .icns with several compression threads,
+*   deflate jobs batches are recorded through a jobs runner wrapping the worker pool runner:
+*   biggest entry image data must be compressed in parallel stripes (not serial single stream),
+*   exported file is loaded back and biggest entry pixels compared with source image,
+*   pack is exported again with squeeze compression effort: biggest entry candidates must be
+*   compressed in parallel
+*
+*   Compilation (command line only build, raylib required):
+*       gcc -O2 -o riconpacker_stripes_test riconpacker_stripes_test.c ../src/external/tinyfiledialogs.c -I../src -I../src/external
+*           -I<raylib>/src -L<raylib>/src -lraylib -lm -lpthread -ldl -DCOMMAND_LINE_ONLY
+*
+*   Usage: riconpacker_stripes_test
+*       Returns 0 if biggest entry is compressed in stripes and exported data is valid, 1 otherwise
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2018-2026 raylib technologies (@raylibtech) / Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#define main RunIconPacker              // rIconPacker program entry point not used by test
+#include "riconpacker.c"
+#undef main
+
+#define TEST_THREADS        4           // Compression threads used for export (caller thread included)
+#define TEST_ICNS_FILE      "riconpacker_stripes_test.icns"
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static int stripedDataSize = 0;         // Biggest image data size compressed in stripes
+static int stripedCount = 0;            // Stripes used for biggest image data compressed in stripes
+static int squeezedDataSize = 0;        // Biggest image data size with squeeze candidates compressed in parallel
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static bool RunTestJobs(rpng_job_func jobFunc, void *jobsData, int jobSize, int jobCount); // Run jobs on worker pool, stripes batches recorded
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(void)
+{
+    static const int packSizes[7] = { 16, 32, 64, 128, 256, 512, 1024 };
+
+    InitWorkerPool(TEST_THREADS - 1);
+    SetCompressionThreads(TEST_THREADS);
+    rpng_set_deflate_threads(TEST_THREADS, RunTestJobs);
+
+    // Generate pack entries images, noise with varying alpha (RGBA data kept, no color reduction)
+    IconEntry entries[7] = { 0 };
+    unsigned int seed = 0x12345678;
+
+    for (int i = 0; i < 7; i++)
+    {
+        int size = packSizes[i];
+        unsigned char *pixels = (unsigned char *)RL_MALLOC(size*size*4);
+
+        for (int p = 0; p < size*size*4; p++)
+        {
+            seed = seed*1103515245 + 12345;
+            pixels[p] = (unsigned char)(((p/4)%size) + (seed >> 28));
+        }
+
+        entries[i].size = size;
+        entries[i].valid = true;
+        entries[i].generated = true;
+        entries[i].image = (Image){ pixels, size, size, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+    }
+
+    int failCount = 0;
+
+    if (!SaveIconPackToICNS(entries, 7, TEST_ICNS_FILE))
+    {
+        printf("FAIL: icon pack could not be exported\n");
+        failCount++;
+    }
+
+    // Biggest entry filtered image data: one filter byte per scanline
+    int biggestDataSize = 1024*(1024*4 + 1);
+
+    if ((stripedDataSize != biggestDataSize) || (stripedCount < 2))
+    {
+        printf("FAIL: biggest entry not compressed in stripes (biggest striped data: %i bytes, %i stripes)\n", stripedDataSize, stripedCount);
+        failCount++;
+    }
+
+    // Exported biggest entry is loaded back and compared with source image
+    int loadedCount = 0;
+    IconEntry *loaded = LoadIconPackFromICNS(TEST_ICNS_FILE, &loadedCount);
+    bool biggestValid = false;
+
+    for (int i = 0; i < loadedCount; i++)
+    {
+        if ((loaded[i].size == 1024) && LoadIconEntryImage(&loaded[i]) && (loaded[i].image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8))
+        {
+            biggestValid = (memcmp(loaded[i].image.data, entries[6].image.data, 1024*1024*4) == 0);
+        }
+
+        UnloadIconEntry(&loaded[i]);
+    }
+
+    if (!biggestValid)
+    {
+        printf("FAIL: exported biggest entry does not match source image\n");
+        failCount++;
+    }
+
+    RL_FREE(loaded);
+
+    // Squeeze compression effort: biggest entry candidates (filter strategies and levels) compressed in parallel
+    compressionEffort = RPNG_COMPRESSION_SQUEEZE;
+    rpng_set_compression_effort(compressionEffort);
+
+    if (!SaveIconPackToICNS(entries, 7, TEST_ICNS_FILE) || (squeezedDataSize != biggestDataSize))
+    {
+        printf("FAIL: biggest entry squeeze candidates not compressed in parallel (biggest data: %i bytes)\n", squeezedDataSize);
+        failCount++;
+    }
+
+    for (int i = 0; i < 7; i++) UnloadImage(entries[i].image);
+    remove(TEST_ICNS_FILE);
+
+    CloseWorkerPool();
+    rpng_decoder_destroy(pngDecoder);
+    UnloadEncodeCache();
+
+    printf("rIconPacker stripes test: biggest entry compressed in %i stripes, %i failed\n", stripedCount, failCount);
+
+    return (failCount == 0)? 0 : 1;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Run jobs on worker pool, stripes and squeeze candidates batches processed in parallel are recorded
+// NOTE: Stripes and candidates batches are only expected from caller thread (big entries), no synchronization required
+static bool RunTestJobs(rpng_job_func jobFunc, void *jobsData, int jobSize, int jobCount)
+{
+    bool parallel = RunWorkerJobsParallel(jobFunc, jobsData, jobSize, jobCount);
+
+    if (parallel && (jobFunc == rpng_deflate_stripe_job))
+    {
+        rpng_deflate_stripe *stripes = (rpng_deflate_stripe *)jobsData;
+
+        if (stripes[jobCount - 1].end > stripedDataSize)
+        {
+            stripedDataSize = stripes[jobCount - 1].end;
+            stripedCount = jobCount;
+        }
+    }
+    else if (parallel && (jobFunc == rpng_deflate_candidate_job))
+    {
+        rpng_deflate_candidate *candidates = (rpng_deflate_candidate *)jobsData;
+        if (candidates[0].size > squeezedDataSize) squeezedDataSize = candidates[0].size;
+    }
+
+    return parallel;
+}
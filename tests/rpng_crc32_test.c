@@ -0,0 +1,123 @@
+/*******************************************************************************************
+*
+*   rpng CRC32 test - update_crc32() randomized equivalence against a bitwise reference
+*
+*   Random cases (length, buffer offset, initial value) are checked for one-shot and chained
+*   computation, covering hardware accelerated (PCLMULQDQ, ARMv8 CRC32) and slice-by-8 paths
+*
+*   Compilation (default, SIMD and hardware CRC32 enabled if available):
+*       gcc -O2 -o rpng_crc32_test rpng_crc32_test.c -I../src/external
+*
+*   Compilation (no SIMD, slice-by-8 tables only):
+*       gcc -O2 -o rpng_crc32_test_nosimd rpng_crc32_test.c -I../src/external -DRPNG_NO_SIMD
+*
+*   Usage: rpng_crc32_test [seed] [cases]
+*       Returns 0 if all cases match the reference, 1 otherwise
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2018-2026 raylib technologies (@raylibtech) / Ramon Santamaria (@raysan5)
+*
+**********************************************************************************************/
+
+#define RPNG_IMPLEMENTATION
+#define RPNG_DEFLATE_IMPLEMENTATION
+#include "rpng.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TEST_BUFFER_SIZE    (256*1024 + 64)     // Test buffer size, big enough for max length plus offset
+#define TEST_MAX_LENGTH     (256*1024)          // Maximum tested data length
+#define TEST_MAX_OFFSET     64                  // Maximum tested buffer offset (alignment)
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static unsigned int GetRandomValue32(unsigned long long *state);   // Get random value (xorshift64*)
+static unsigned int ComputeCrc32Bitwise(unsigned int crc, const unsigned char *buffer, int size); // Compute CRC32 bit by bit (reference)
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    unsigned long long seed = (argc > 1)? strtoull(argv[1], NULL, 0) : 0x2545F4914F6CDD1DULL;
+    int caseCount = (argc > 2)? atoi(argv[2]) : 20000;
+
+    unsigned long long state = (seed != 0)? seed : 1;
+    unsigned char *buffer = (unsigned char *)malloc(TEST_BUFFER_SIZE);
+    for (int i = 0; i < TEST_BUFFER_SIZE; i++) buffer[i] = (unsigned char)GetRandomValue32(&state);
+
+    int failCount = 0;
+
+    // Standard check value: CRC32 of "123456789"
+    if (update_crc32(0, (const unsigned char *)"123456789", 9) != 0xCBF43926)
+    {
+        printf("FAIL: check value: %08x (expected cbf43926)\n", update_crc32(0, (const unsigned char *)"123456789", 9));
+        failCount++;
+    }
+
+    for (int i = 0; i < caseCount; i++)
+    {
+        // Length: all small lengths first, then mostly short lengths with some big ones
+        int length = 0;
+        if (i <= 512) length = i;
+        else if ((i%16) == 0) length = (int)(GetRandomValue32(&state)%(TEST_MAX_LENGTH + 1));
+        else length = (int)(GetRandomValue32(&state)%4097);
+
+        int offset = (int)(GetRandomValue32(&state)%TEST_MAX_OFFSET);
+        unsigned int initial = ((i%4) == 0)? 0 : GetRandomValue32(&state);
+        int split = (length > 0)? (int)(GetRandomValue32(&state)%(length + 1)) : 0;
+
+        const unsigned char *data = buffer + offset;
+
+        unsigned int expected = ComputeCrc32Bitwise(initial, data, length);
+        unsigned int result = update_crc32(initial, data, length);
+        unsigned int chained = update_crc32(update_crc32(initial, data, split), data + split, length - split);
+
+        if ((result != expected) || (chained != expected))
+        {
+            if (failCount < 10) printf("FAIL: case %i (length: %i, offset: %i, initial: %08x, split: %i): %08x, chained: %08x (expected %08x)\n",
+                i, length, offset, initial, split, result, chained, expected);
+            failCount++;
+        }
+    }
+
+    free(buffer);
+
+#if defined(RPNG_NO_SIMD)
+    printf("rpng CRC32 test [no SIMD] (seed: 0x%llx): %i cases, %i failed\n", seed, caseCount, failCount);
+#else
+    printf("rpng CRC32 test (seed: 0x%llx): %i cases, %i failed\n", seed, caseCount, failCount);
+#endif
+
+    return (failCount == 0)? 0 : 1;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Get random value (xorshift64*)
+static unsigned int GetRandomValue32(unsigned long long *state)
+{
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+
+    return (unsigned int)((*state*0x2545F4914F6CDD1DULL) >> 32);
+}
+
+// Compute CRC32 bit by bit (reference), continued from provided value (0 for initial value)
+static unsigned int ComputeCrc32Bitwise(unsigned int crc, const unsigned char *buffer, int size)
+{
+    crc = ~crc;
+
+    for (int i = 0; i < size; i++)
+    {
+        crc ^= buffer[i];
+        for (int k = 0; k < 8; k++) crc = (crc & 1)? ((crc >> 1) ^ 0xEDB88320) : (crc >> 1);
+    }
+
+    return ~crc;
+}